@@ -0,0 +1,370 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+#ifndef DUNE_GDT_LOCAL_ASSEMBLER_BILINEAR_FORM_APPLICATORS_HH
+#define DUNE_GDT_LOCAL_ASSEMBLER_BILINEAR_FORM_APPLICATORS_HH
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
+#include <dune/xt/functions/interfaces/grid-function.hh>
+#include <dune/xt/grid/functors/interfaces.hh>
+#include <dune/xt/la/container/vector-interface.hh>
+
+#include <dune/gdt/local/bilinear-forms/interfaces.hh>
+#include <dune/gdt/spaces/interface.hh>
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief Adds the action of a local element bilinear form on a given source to a global vector, without assembling a
+ *        matrix.
+ *
+ * The local source function is passed to the local bilinear form in place of the ansatz basis (it is a local function
+ * set of size 1), so that apply2() directly yields the local vector a(phi_i, source) for all test basis functions at
+ * the cost of a single column of the local matrix.
+ *
+ * \sa MatrixFreeOperator
+ */
+template <class Vector,
+          class GridView,
+          size_t t_r = 1,
+          size_t t_rC = 1,
+          class TF = double,
+          class TestGridView = GridView,
+          size_t a_r = t_r,
+          size_t a_rC = t_rC,
+          class AF = TF>
+class LocalElementBilinearFormApplicator : public XT::Grid::ElementFunctor<GridView>
+{
+  static_assert(XT::LA::is_vector<Vector>::value, "");
+  static_assert(XT::Grid::is_view<GridView>::value, "");
+  static_assert(XT::Grid::is_view<TestGridView>::value, "");
+
+  using ThisType = LocalElementBilinearFormApplicator;
+  using BaseType = XT::Grid::ElementFunctor<GridView>;
+
+public:
+  using typename BaseType::ElementType;
+  using VectorType = Vector;
+  using FieldType = typename VectorType::ScalarType;
+  using TestSpaceType = SpaceInterface<TestGridView, t_r, t_rC, TF>;
+  using SourceType = XT::Functions::GridFunctionInterface<ElementType, a_r, a_rC, AF>;
+  using LocalBilinearFormType = LocalElementBilinearFormInterface<ElementType, t_r, t_rC, TF, FieldType, a_r, a_rC, AF>;
+
+  LocalElementBilinearFormApplicator(const TestSpaceType& test_space,
+                                     const LocalBilinearFormType& local_bilinear_form,
+                                     const SourceType& source,
+                                     VectorType& global_vector,
+                                     const XT::Common::Parameter& param = {})
+    : test_space_(test_space.copy())
+    , local_bilinear_form_(local_bilinear_form.copy())
+    , source_(source)
+    , global_vector_(global_vector)
+    , param_(param)
+    , local_vector_(test_space_->mapper().max_local_size(), 1, 0.)
+    , global_indices_(test_space_->mapper().max_local_size())
+    , test_basis_(test_space_->basis().localize())
+    , local_source_(source_.local_function())
+  {
+    DUNE_THROW_IF(global_vector_.size() != test_space_->mapper().size(),
+                  XT::Common::Exceptions::shapes_do_not_match,
+                  "global_vector.size() = " << global_vector_.size() << "\n  "
+                                            << "test_space.mapper().size()" << test_space_->mapper().size());
+  }
+
+  LocalElementBilinearFormApplicator(const ThisType& other)
+    : BaseType()
+    , test_space_(other.test_space_->copy())
+    , local_bilinear_form_(other.local_bilinear_form_->copy())
+    , source_(other.source_)
+    , global_vector_(other.global_vector_)
+    , param_(other.param_)
+    , local_vector_(other.local_vector_)
+    , global_indices_(other.global_indices_)
+    , test_basis_(test_space_->basis().localize())
+    , local_source_(source_.local_function())
+  {}
+
+  LocalElementBilinearFormApplicator(ThisType&& source) = default;
+
+  BaseType* copy() override final
+  {
+    return new ThisType(*this);
+  }
+
+  void apply_local(const ElementType& element) override final
+  {
+    // apply bilinear form to the source
+    test_basis_->bind(element);
+    local_source_->bind(element);
+    local_bilinear_form_->apply2(*test_basis_, *local_source_, local_vector_, param_);
+    // copy local vector to global
+    test_space_->mapper().global_indices(element, global_indices_);
+    for (size_t ii = 0; ii < test_basis_->size(param_); ++ii)
+      global_vector_.add_to_entry(global_indices_[ii], local_vector_[ii][0]);
+  }
+
+private:
+  std::unique_ptr<const TestSpaceType> test_space_;
+  std::unique_ptr<LocalBilinearFormType> local_bilinear_form_;
+  const SourceType& source_;
+  VectorType& global_vector_;
+  XT::Common::Parameter param_;
+  DynamicMatrix<FieldType> local_vector_;
+  DynamicVector<size_t> global_indices_;
+  mutable std::unique_ptr<typename TestSpaceType::GlobalBasisType::LocalizedType> test_basis_;
+  std::unique_ptr<typename SourceType::LocalFunctionType> local_source_;
+}; // class LocalElementBilinearFormApplicator
+
+
+/**
+ * \brief Adds the action of a local coupling intersection bilinear form on a given source to a global vector, without
+ *        assembling a matrix.
+ *
+ * \sa LocalElementBilinearFormApplicator
+ */
+template <class Vector,
+          class GridView,
+          size_t t_r = 1,
+          size_t t_rC = 1,
+          class TF = double,
+          class TestGridView = GridView,
+          size_t a_r = t_r,
+          size_t a_rC = t_rC,
+          class AF = TF>
+class LocalCouplingIntersectionBilinearFormApplicator : public XT::Grid::IntersectionFunctor<GridView>
+{
+  static_assert(XT::LA::is_vector<Vector>::value, "");
+  static_assert(XT::Grid::is_view<GridView>::value, "");
+  static_assert(XT::Grid::is_view<TestGridView>::value, "");
+
+  using ThisType = LocalCouplingIntersectionBilinearFormApplicator;
+  using BaseType = XT::Grid::IntersectionFunctor<GridView>;
+
+public:
+  using typename BaseType::ElementType;
+  using typename BaseType::IntersectionType;
+  using VectorType = Vector;
+  using FieldType = typename VectorType::ScalarType;
+  using TestSpaceType = SpaceInterface<TestGridView, t_r, t_rC, TF>;
+  using SourceType = XT::Functions::GridFunctionInterface<ElementType, a_r, a_rC, AF>;
+  using LocalBilinearFormType =
+      LocalCouplingIntersectionBilinearFormInterface<IntersectionType, t_r, t_rC, TF, FieldType, a_r, a_rC, AF>;
+
+  LocalCouplingIntersectionBilinearFormApplicator(const TestSpaceType& test_space,
+                                                  const LocalBilinearFormType& local_bilinear_form,
+                                                  const SourceType& source,
+                                                  VectorType& global_vector,
+                                                  const XT::Common::Parameter& param = {})
+    : test_space_(test_space.copy())
+    , local_bilinear_form_(local_bilinear_form.copy())
+    , source_(source)
+    , global_vector_(global_vector)
+    , param_(param)
+    , local_vector_in_in_(test_space_->mapper().max_local_size(), 1, 0.)
+    , local_vector_in_out_(test_space_->mapper().max_local_size(), 1, 0.)
+    , local_vector_out_in_(test_space_->mapper().max_local_size(), 1, 0.)
+    , local_vector_out_out_(test_space_->mapper().max_local_size(), 1, 0.)
+    , global_indices_in_(test_space_->mapper().max_local_size())
+    , global_indices_out_(test_space_->mapper().max_local_size())
+    , test_basis_inside_(test_space_->basis().localize())
+    , test_basis_outside_(test_space_->basis().localize())
+    , local_source_inside_(source_.local_function())
+    , local_source_outside_(source_.local_function())
+  {
+    DUNE_THROW_IF(global_vector_.size() != test_space_->mapper().size(),
+                  XT::Common::Exceptions::shapes_do_not_match,
+                  "global_vector.size() = " << global_vector_.size() << "\n  "
+                                            << "test_space.mapper().size()" << test_space_->mapper().size());
+  }
+
+  LocalCouplingIntersectionBilinearFormApplicator(const ThisType& other)
+    : BaseType()
+    , test_space_(other.test_space_->copy())
+    , local_bilinear_form_(other.local_bilinear_form_->copy())
+    , source_(other.source_)
+    , global_vector_(other.global_vector_)
+    , param_(other.param_)
+    , local_vector_in_in_(other.local_vector_in_in_)
+    , local_vector_in_out_(other.local_vector_in_out_)
+    , local_vector_out_in_(other.local_vector_out_in_)
+    , local_vector_out_out_(other.local_vector_out_out_)
+    , global_indices_in_(other.global_indices_in_)
+    , global_indices_out_(other.global_indices_out_)
+    , test_basis_inside_(test_space_->basis().localize())
+    , test_basis_outside_(test_space_->basis().localize())
+    , local_source_inside_(source_.local_function())
+    , local_source_outside_(source_.local_function())
+  {}
+
+  LocalCouplingIntersectionBilinearFormApplicator(ThisType&& source) = default;
+
+  BaseType* copy() override final
+  {
+    return new ThisType(*this);
+  }
+
+  void apply_local(const IntersectionType& intersection,
+                   const ElementType& inside_element,
+                   const ElementType& outside_element) override final
+  {
+    // apply bilinear form to the source
+    test_basis_inside_->bind(inside_element);
+    local_source_inside_->bind(inside_element);
+    test_basis_outside_->bind(outside_element);
+    local_source_outside_->bind(outside_element);
+    local_bilinear_form_->apply2(intersection,
+                                 *test_basis_inside_,
+                                 *local_source_inside_,
+                                 *test_basis_outside_,
+                                 *local_source_outside_,
+                                 local_vector_in_in_,
+                                 local_vector_in_out_,
+                                 local_vector_out_in_,
+                                 local_vector_out_out_,
+                                 param_);
+    // copy local vectors to global
+    test_space_->mapper().global_indices(inside_element, global_indices_in_);
+    test_space_->mapper().global_indices(outside_element, global_indices_out_);
+    for (size_t ii = 0; ii < test_basis_inside_->size(param_); ++ii)
+      global_vector_.add_to_entry(global_indices_in_[ii], local_vector_in_in_[ii][0] + local_vector_in_out_[ii][0]);
+    for (size_t ii = 0; ii < test_basis_outside_->size(param_); ++ii)
+      global_vector_.add_to_entry(global_indices_out_[ii],
+                                  local_vector_out_in_[ii][0] + local_vector_out_out_[ii][0]);
+  } // ... apply_local(...)
+
+private:
+  std::unique_ptr<const TestSpaceType> test_space_;
+  std::unique_ptr<LocalBilinearFormType> local_bilinear_form_;
+  const SourceType& source_;
+  VectorType& global_vector_;
+  XT::Common::Parameter param_;
+  DynamicMatrix<FieldType> local_vector_in_in_;
+  DynamicMatrix<FieldType> local_vector_in_out_;
+  DynamicMatrix<FieldType> local_vector_out_in_;
+  DynamicMatrix<FieldType> local_vector_out_out_;
+  DynamicVector<size_t> global_indices_in_;
+  DynamicVector<size_t> global_indices_out_;
+  mutable std::unique_ptr<typename TestSpaceType::GlobalBasisType::LocalizedType> test_basis_inside_;
+  mutable std::unique_ptr<typename TestSpaceType::GlobalBasisType::LocalizedType> test_basis_outside_;
+  std::unique_ptr<typename SourceType::LocalFunctionType> local_source_inside_;
+  std::unique_ptr<typename SourceType::LocalFunctionType> local_source_outside_;
+}; // class LocalCouplingIntersectionBilinearFormApplicator
+
+
+/**
+ * \brief Adds the action of a local intersection bilinear form on a given source to a global vector, without
+ *        assembling a matrix.
+ *
+ * \sa LocalElementBilinearFormApplicator
+ */
+template <class Vector,
+          class GridView,
+          size_t t_r = 1,
+          size_t t_rC = 1,
+          class TF = double,
+          class TestGridView = GridView,
+          size_t a_r = t_r,
+          size_t a_rC = t_rC,
+          class AF = TF>
+class LocalIntersectionBilinearFormApplicator : public XT::Grid::IntersectionFunctor<GridView>
+{
+  static_assert(XT::LA::is_vector<Vector>::value, "");
+  static_assert(XT::Grid::is_view<GridView>::value, "");
+  static_assert(XT::Grid::is_view<TestGridView>::value, "");
+
+  using ThisType = LocalIntersectionBilinearFormApplicator;
+  using BaseType = XT::Grid::IntersectionFunctor<GridView>;
+
+public:
+  using typename BaseType::ElementType;
+  using typename BaseType::IntersectionType;
+  using VectorType = Vector;
+  using FieldType = typename VectorType::ScalarType;
+  using TestSpaceType = SpaceInterface<TestGridView, t_r, t_rC, TF>;
+  using SourceType = XT::Functions::GridFunctionInterface<ElementType, a_r, a_rC, AF>;
+  using LocalBilinearFormType =
+      LocalIntersectionBilinearFormInterface<IntersectionType, t_r, t_rC, TF, FieldType, a_r, a_rC, AF>;
+
+  LocalIntersectionBilinearFormApplicator(const TestSpaceType& test_space,
+                                          const LocalBilinearFormType& local_bilinear_form,
+                                          const SourceType& source,
+                                          VectorType& global_vector,
+                                          const XT::Common::Parameter& param = {})
+    : test_space_(test_space.copy())
+    , local_bilinear_form_(local_bilinear_form.copy())
+    , source_(source)
+    , global_vector_(global_vector)
+    , param_(param)
+    , local_vector_(test_space_->mapper().max_local_size(), 1, 0.)
+    , global_indices_(test_space_->mapper().max_local_size())
+    , test_basis_(test_space_->basis().localize())
+    , local_source_(source_.local_function())
+  {
+    DUNE_THROW_IF(global_vector_.size() != test_space_->mapper().size(),
+                  XT::Common::Exceptions::shapes_do_not_match,
+                  "global_vector.size() = " << global_vector_.size() << "\n  "
+                                            << "test_space.mapper().size()" << test_space_->mapper().size());
+  }
+
+  LocalIntersectionBilinearFormApplicator(const ThisType& other)
+    : BaseType()
+    , test_space_(other.test_space_->copy())
+    , local_bilinear_form_(other.local_bilinear_form_->copy())
+    , source_(other.source_)
+    , global_vector_(other.global_vector_)
+    , param_(other.param_)
+    , local_vector_(other.local_vector_)
+    , global_indices_(other.global_indices_)
+    , test_basis_(test_space_->basis().localize())
+    , local_source_(source_.local_function())
+  {}
+
+  LocalIntersectionBilinearFormApplicator(ThisType&& source) = default;
+
+  BaseType* copy() override final
+  {
+    return new ThisType(*this);
+  }
+
+  void apply_local(const IntersectionType& intersection,
+                   const ElementType& inside_element,
+                   const ElementType& outside_element) override final
+  {
+    const auto& element = local_bilinear_form_->inside() ? inside_element : outside_element;
+    // apply bilinear form to the source
+    test_basis_->bind(element);
+    local_source_->bind(element);
+    local_bilinear_form_->apply2(intersection, *test_basis_, *local_source_, local_vector_, param_);
+    // copy local vector to global
+    test_space_->mapper().global_indices(element, global_indices_);
+    for (size_t ii = 0; ii < test_basis_->size(param_); ++ii)
+      global_vector_.add_to_entry(global_indices_[ii], local_vector_[ii][0]);
+  }
+
+private:
+  std::unique_ptr<const TestSpaceType> test_space_;
+  std::unique_ptr<LocalBilinearFormType> local_bilinear_form_;
+  const SourceType& source_;
+  VectorType& global_vector_;
+  XT::Common::Parameter param_;
+  DynamicMatrix<FieldType> local_vector_;
+  DynamicVector<size_t> global_indices_;
+  mutable std::unique_ptr<typename TestSpaceType::GlobalBasisType::LocalizedType> test_basis_;
+  std::unique_ptr<typename SourceType::LocalFunctionType> local_source_;
+}; // class LocalIntersectionBilinearFormApplicator
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_LOCAL_ASSEMBLER_BILINEAR_FORM_APPLICATORS_HH
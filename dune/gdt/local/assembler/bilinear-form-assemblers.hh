@@ -17,6 +17,7 @@
 #include <dune/gdt/local/bilinear-forms/interfaces.hh>
 #include <dune/gdt/spaces/interface.hh>
 #include <dune/gdt/print.hh>
+#include <dune/gdt/tools/matrix-scatter.hh>
 
 namespace Dune {
 namespace GDT {
@@ -47,19 +48,23 @@ public:
   using TestSpaceType = SpaceInterface<TGV, t_r, t_rC, TR>;
   using AnsatzSpaceType = SpaceInterface<AGV, a_r, a_rC, AR>;
   using LocalBilinearFormType = LocalElementBilinearFormInterface<ElementType, t_r, t_rC, TR, FieldType, a_r, a_rC, AR>;
+  using PositionCacheType = LocalMatrixPositionCache<MatrixType, GridView, TGV, AGV>;
 
   LocalElementBilinearFormAssembler(const TestSpaceType& test_space,
                                     const AnsatzSpaceType& ansatz_space,
                                     const LocalBilinearFormType& local_two_form,
                                     MatrixType& global_matrix,
                                     const XT::Common::Parameter& param = {},
-                                    const std::string& logging_prefix = "")
+                                    const std::string& logging_prefix = "",
+                                    const PositionCacheType* position_cache = nullptr)
     : BaseType(logging_prefix.empty() ? "ElementBilinearFormAssembler" : logging_prefix,
                /*logging_disabled=*/logging_prefix.empty())
     , test_space_(test_space.copy())
     , ansatz_space_(ansatz_space.copy())
     , local_bilinear_form_(local_two_form.copy())
     , global_matrix_(global_matrix)
+    , scatter_(global_matrix_)
+    , position_cache_(position_cache)
     , param_(param)
     , scaling_(param_.has_key("matrixoperator.scaling") ? param_.get("matrixoperator.scaling").at(0) : 1.)
     , local_matrix_(test_space_->mapper().max_local_size(), ansatz_space_->mapper().max_local_size())
@@ -91,6 +96,8 @@ public:
     , ansatz_space_(other.ansatz_space_->copy())
     , local_bilinear_form_(other.local_bilinear_form_->copy())
     , global_matrix_(other.global_matrix_)
+    , scatter_(other.scatter_)
+    , position_cache_(other.position_cache_)
     , param_(other.param_)
     , scaling_(other.scaling_)
     , local_matrix_(test_space_->mapper().max_local_size(), ansatz_space_->mapper().max_local_size())
@@ -120,11 +127,18 @@ public:
                 << "\n   local_matrix_ = " << print(local_matrix_, {{"oneline", "true"}}) << std::endl;
     // copy local matrix to global matrix
     test_space_->mapper().global_indices(element, global_test_indices_);
-    ansatz_space_->mapper().global_indices(element, global_ansatz_indices_);
-    for (size_t ii = 0; ii < test_basis_->size(param_); ++ii)
-      for (size_t jj = 0; jj < ansatz_basis_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_[ii], global_ansatz_indices_[jj], scaling_ * local_matrix_[ii][jj]);
+    const auto* positions = position_cache_ ? position_cache_->positions(element, element) : nullptr;
+    if (positions)
+      scatter_.add(test_basis_->size(param_), positions, ansatz_basis_->size(param_), local_matrix_, scaling_);
+    else {
+      ansatz_space_->mapper().global_indices(element, global_ansatz_indices_);
+      scatter_.add(global_test_indices_,
+                   test_basis_->size(param_),
+                   global_ansatz_indices_,
+                   ansatz_basis_->size(param_),
+                   local_matrix_,
+                   scaling_);
+    }
   } // ... apply_local(...)
 
 private:
@@ -132,6 +146,8 @@ private:
   const std::unique_ptr<AnsatzSpaceType> ansatz_space_;
   const std::unique_ptr<LocalBilinearFormType> local_bilinear_form_;
   MatrixType& global_matrix_;
+  LocalMatrixScatter<MatrixType> scatter_;
+  const PositionCacheType* position_cache_;
   XT::Common::Parameter param_;
   const double scaling_;
   DynamicMatrix<FieldType> local_matrix_;
@@ -170,17 +186,21 @@ public:
   using AnsatzSpaceType = SpaceInterface<AGV, a_r, a_rC, AR>;
   using LocalBilinearFormType =
       LocalCouplingIntersectionBilinearFormInterface<I, t_r, t_rC, TR, FieldType, a_r, a_rC, AR>;
+  using PositionCacheType = LocalMatrixPositionCache<MatrixType, GridView, TGV, AGV>;
 
   LocalCouplingIntersectionBilinearFormAssembler(const TestSpaceType& test_space,
                                                  const AnsatzSpaceType& ansatz_space,
                                                  const LocalBilinearFormType& local_two_form,
                                                  MatrixType& global_matrix,
-                                                 const XT::Common::Parameter& param = {})
+                                                 const XT::Common::Parameter& param = {},
+                                                 const PositionCacheType* position_cache = nullptr)
     : BaseType()
     , test_space_(test_space.copy())
     , ansatz_space_(ansatz_space.copy())
     , local_bilinear_form_(local_two_form.copy())
     , global_matrix_(global_matrix)
+    , scatter_(global_matrix_)
+    , position_cache_(position_cache)
     , param_(param)
     , scaling_(param_.has_key("matrixoperator.scaling") ? param_.get("matrixoperator.scaling").at(0) : 1.)
     , local_matrix_in_in_(test_space_->mapper().max_local_size(), ansatz_space_->mapper().max_local_size())
@@ -212,6 +232,8 @@ public:
     , ansatz_space_(other.ansatz_space_->copy())
     , local_bilinear_form_(other.local_bilinear_form_->copy())
     , global_matrix_(other.global_matrix_)
+    , scatter_(other.scatter_)
+    , position_cache_(other.position_cache_)
     , param_(other.param_)
     , scaling_(other.scaling_)
     , local_matrix_in_in_(test_space_->mapper().max_local_size(), ansatz_space_->mapper().max_local_size())
@@ -259,22 +281,47 @@ public:
     test_space_->mapper().global_indices(outside_element, global_test_indices_out_);
     ansatz_space_->mapper().global_indices(inside_element, global_ansatz_indices_in_);
     ansatz_space_->mapper().global_indices(outside_element, global_ansatz_indices_out_);
-    for (size_t ii = 0; ii < test_basis_inside_->size(param_); ++ii) {
-      for (size_t jj = 0; jj < ansatz_basis_inside_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_in_[ii], global_ansatz_indices_in_[jj], scaling_ * local_matrix_in_in_[ii][jj]);
-      for (size_t jj = 0; jj < ansatz_basis_outside_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_in_[ii], global_ansatz_indices_out_[jj], scaling_ * local_matrix_in_out_[ii][jj]);
-    }
-    for (size_t ii = 0; ii < test_basis_outside_->size(param_); ++ii) {
-      for (size_t jj = 0; jj < ansatz_basis_inside_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_out_[ii], global_ansatz_indices_in_[jj], scaling_ * local_matrix_out_in_[ii][jj]);
-      for (size_t jj = 0; jj < ansatz_basis_outside_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_out_[ii], global_ansatz_indices_out_[jj], scaling_ * local_matrix_out_out_[ii][jj]);
+    const size_t test_size_in = test_basis_inside_->size(param_);
+    const size_t test_size_out = test_basis_outside_->size(param_);
+    const size_t ansatz_size_in = ansatz_basis_inside_->size(param_);
+    const size_t ansatz_size_out = ansatz_basis_outside_->size(param_);
+    if (position_cache_ && position_cache_->valid()) {
+      const auto* positions_in_in = position_cache_->positions(inside_element, inside_element);
+      const auto* positions_in_out = position_cache_->positions(inside_element, outside_element);
+      const auto* positions_out_in = position_cache_->positions(outside_element, inside_element);
+      const auto* positions_out_out = position_cache_->positions(outside_element, outside_element);
+      if (positions_in_in && positions_in_out && positions_out_in && positions_out_out) {
+        scatter_.add(test_size_in, positions_in_in, ansatz_size_in, local_matrix_in_in_, scaling_);
+        scatter_.add(test_size_in, positions_in_out, ansatz_size_out, local_matrix_in_out_, scaling_);
+        scatter_.add(test_size_out, positions_out_in, ansatz_size_in, local_matrix_out_in_, scaling_);
+        scatter_.add(test_size_out, positions_out_out, ansatz_size_out, local_matrix_out_out_, scaling_);
+        return;
+      }
     }
+    scatter_.add(global_test_indices_in_,
+                 test_size_in,
+                 global_ansatz_indices_in_,
+                 ansatz_size_in,
+                 local_matrix_in_in_,
+                 scaling_);
+    scatter_.add(global_test_indices_in_,
+                 test_size_in,
+                 global_ansatz_indices_out_,
+                 ansatz_size_out,
+                 local_matrix_in_out_,
+                 scaling_);
+    scatter_.add(global_test_indices_out_,
+                 test_size_out,
+                 global_ansatz_indices_in_,
+                 ansatz_size_in,
+                 local_matrix_out_in_,
+                 scaling_);
+    scatter_.add(global_test_indices_out_,
+                 test_size_out,
+                 global_ansatz_indices_out_,
+                 ansatz_size_out,
+                 local_matrix_out_out_,
+                 scaling_);
   } // ... apply_local(...)
 
 private:
@@ -282,6 +329,8 @@ private:
   const std::unique_ptr<AnsatzSpaceType> ansatz_space_;
   const std::unique_ptr<LocalBilinearFormType> local_bilinear_form_;
   MatrixType& global_matrix_;
+  LocalMatrixScatter<MatrixType> scatter_;
+  const PositionCacheType* position_cache_;
   XT::Common::Parameter param_;
   const double scaling_;
   DynamicMatrix<FieldType> local_matrix_in_in_;
@@ -326,17 +375,21 @@ public:
   using TestSpaceType = SpaceInterface<TGV, t_r, t_rC, TR>;
   using AnsatzSpaceType = SpaceInterface<AGV, a_r, a_rC, AR>;
   using LocalBilinearFormType = LocalIntersectionBilinearFormInterface<I, t_r, t_rC, TR, FieldType, a_r, a_rC, AR>;
+  using PositionCacheType = LocalMatrixPositionCache<MatrixType, GridView, TGV, AGV>;
 
   LocalIntersectionBilinearFormAssembler(const TestSpaceType& test_space,
                                          const AnsatzSpaceType& ansatz_space,
                                          const LocalBilinearFormType& local_two_form,
                                          MatrixType& global_matrix,
-                                         const XT::Common::Parameter& param = {})
+                                         const XT::Common::Parameter& param = {},
+                                         const PositionCacheType* position_cache = nullptr)
     : BaseType()
     , test_space_(test_space.copy())
     , ansatz_space_(ansatz_space.copy())
     , local_bilinear_form_(local_two_form.copy())
     , global_matrix_(global_matrix)
+    , scatter_(global_matrix_)
+    , position_cache_(position_cache)
     , param_(param)
     , scaling_(param_.has_key("matrixoperator.scaling") ? param_.get("matrixoperator.scaling").at(0) : 1.)
     , local_matrix_(test_space_->mapper().max_local_size(), ansatz_space_->mapper().max_local_size())
@@ -361,6 +414,8 @@ public:
     , ansatz_space_(other.ansatz_space_->copy())
     , local_bilinear_form_(other.local_bilinear_form_->copy())
     , global_matrix_(other.global_matrix_)
+    , scatter_(other.scatter_)
+    , position_cache_(other.position_cache_)
     , param_(other.param_)
     , scaling_(other.scaling_)
     , local_matrix_(test_space_->mapper().max_local_size(), ansatz_space_->mapper().max_local_size())
@@ -388,11 +443,18 @@ public:
     local_bilinear_form_->apply2(intersection, *test_basis_, *ansatz_basis_, local_matrix_, param_);
     // copy local matrices to global matrix
     test_space_->mapper().global_indices(element, global_test_indices_);
-    ansatz_space_->mapper().global_indices(element, global_ansatz_indices_);
-    for (size_t ii = 0; ii < test_basis_->size(param_); ++ii)
-      for (size_t jj = 0; jj < ansatz_basis_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_[ii], global_ansatz_indices_[jj], scaling_ * local_matrix_[ii][jj]);
+    const auto* positions = position_cache_ ? position_cache_->positions(element, element) : nullptr;
+    if (positions)
+      scatter_.add(test_basis_->size(param_), positions, ansatz_basis_->size(param_), local_matrix_, scaling_);
+    else {
+      ansatz_space_->mapper().global_indices(element, global_ansatz_indices_);
+      scatter_.add(global_test_indices_,
+                   test_basis_->size(param_),
+                   global_ansatz_indices_,
+                   ansatz_basis_->size(param_),
+                   local_matrix_,
+                   scaling_);
+    }
   } // ... apply_local(...)
 
 private:
@@ -400,6 +462,8 @@ private:
   const std::unique_ptr<AnsatzSpaceType> ansatz_space_;
   const std::unique_ptr<LocalBilinearFormType> local_bilinear_form_;
   MatrixType& global_matrix_;
+  LocalMatrixScatter<MatrixType> scatter_;
+  const PositionCacheType* position_cache_;
   XT::Common::Parameter param_;
   const double scaling_;
   DynamicMatrix<FieldType> local_matrix_;
@@ -25,6 +25,7 @@
 
 #include <dune/gdt/local/discretefunction.hh>
 #include <dune/gdt/local/operators/interfaces.hh>
+#include <dune/gdt/tools/matrix-scatter.hh>
 
 namespace Dune {
 namespace GDT {
@@ -82,6 +83,7 @@ public:
     , source_space_(source_space.copy())
     , range_space_(range_space.copy())
     , matrix_(matrix)
+    , matrix_scatter_(matrix_)
     , source_vector_(source_vector)
     , param_(param)
     , scaling_(param_.has_key("matrixoperator.scaling") ? param_.get("matrixoperator.scaling").at(0) : 1.)
@@ -101,6 +103,7 @@ public:
     , source_space_(other.source_space_->copy())
     , range_space_(other.range_space_->copy())
     , matrix_(other.matrix_)
+    , matrix_scatter_(matrix_)
     , source_vector_(other.source_vector_)
     , param_(other.param_)
     , scaling_(other.scaling_)
@@ -150,7 +153,7 @@ public:
         auto derivative = (local_range_->dofs()[ii] - range_DoFs_[ii]) / eps;
         if (XT::Common::FloatCmp::eq(derivative, eps))
           derivative = 0;
-        matrix_.add_to_entry(global_range_indices_[ii], global_source_indices_[jj], scaling_ * derivative);
+        matrix_scatter_.add_to_entry(global_range_indices_[ii], global_source_indices_[jj], scaling_ * derivative);
       }
       // restore source
       local_source_->dofs()[jj] = jjth_source_DoF;
@@ -161,6 +164,7 @@ private:
   std::unique_ptr<const SourceSpaceType> source_space_;
   std::unique_ptr<const RangeSpaceType> range_space_;
   MatrixType& matrix_;
+  LocalMatrixScatter<MatrixType> matrix_scatter_;
   const VectorType& source_vector_;
   const XT::Common::Parameter param_;
   const double scaling_;
@@ -231,6 +235,7 @@ public:
     : source_space_(source_space.copy())
     , range_space_(range_space.copy())
     , matrix_(matrix)
+    , matrix_scatter_(matrix_)
     , source_vector_(source_vector)
     , param_(param)
     , scaling_(param_.has_key("matrixoperator.scaling") ? param_.get("matrixoperator.scaling").at(0) : 1.)
@@ -251,6 +256,7 @@ public:
     , source_space_(other.source_space_->copy())
     , range_space_(other.range_space_->copy())
     , matrix_(other.matrix_)
+    , matrix_scatter_(matrix_)
     , source_vector_(other.source_vector_)
     , param_(other.param_)
     , scaling_(other.scaling_)
@@ -321,7 +327,7 @@ public:
         auto derivative = (local_range_inside_->dofs()[ii] - range_DoFs_inside_[ii]) / eps;
         if (XT::Common::FloatCmp::eq(derivative, eps))
           derivative = 0;
-        matrix_.add_to_entry(
+        matrix_scatter_.add_to_entry(
             global_range_indices_inside_[ii], global_source_indices_inside_[jj], scaling_ * derivative);
       }
       // observe perturbation in outside range DoFs
@@ -330,7 +336,7 @@ public:
           auto derivative = (local_range_outside_->dofs()[ii] - range_DoFs_outside_[ii]) / eps;
           if (XT::Common::FloatCmp::eq(derivative, eps))
             derivative = 0;
-          matrix_.add_to_entry(
+          matrix_scatter_.add_to_entry(
               global_range_indices_outside_[ii], global_source_indices_inside_[jj], scaling_ * derivative);
         }
       }
@@ -354,7 +360,7 @@ public:
           auto derivative = (local_range_inside_->dofs()[ii] - range_DoFs_inside_[ii]) / eps;
           if (XT::Common::FloatCmp::eq(derivative, eps))
             derivative = 0;
-          matrix_.add_to_entry(
+          matrix_scatter_.add_to_entry(
               global_range_indices_inside_[ii], global_source_indices_outside_[jj], scaling_ * derivative);
         }
         // observe perturbation in outside range DoFs
@@ -362,7 +368,7 @@ public:
           auto derivative = (local_range_outside_->dofs()[ii] - range_DoFs_outside_[ii]) / eps;
           if (XT::Common::FloatCmp::eq(derivative, eps))
             derivative = 0;
-          matrix_.add_to_entry(
+          matrix_scatter_.add_to_entry(
               global_range_indices_outside_[ii], global_source_indices_outside_[jj], scaling_ * derivative);
         }
         // restore source
@@ -375,6 +381,7 @@ private:
   std::unique_ptr<const SourceSpaceType> source_space_;
   std::unique_ptr<const RangeSpaceType> range_space_;
   MatrixType& matrix_;
+  LocalMatrixScatter<MatrixType> matrix_scatter_;
   const VectorType& source_vector_;
   const XT::Common::Parameter param_;
   const double scaling_;
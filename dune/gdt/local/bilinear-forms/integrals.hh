@@ -105,38 +105,27 @@ public:
     const auto& element = ansatz_basis.element();
     assert(test_basis.element() == element && "This must not happen!");
     integrand_->bind(element);
-    // prepare storage
-    const size_t rows = test_basis.size(param);
-    const size_t cols = ansatz_basis.size(param);
-    if (result.rows() < rows || result.cols() < cols)
-      result.resize(rows, cols);
-    result *= 0;
-    // loop over all quadrature points
     const auto integrand_order = integrand_->order(test_basis, ansatz_basis) + over_integrate_;
-    for (const auto& quadrature_point : QuadratureRules<D, d>::rule(element.type(), integrand_order)) {
-      const auto& point_in_reference_element = quadrature_point.position();
-      // integration factors
-      const auto factor = element.geometry().integrationElement(point_in_reference_element) * quadrature_point.weight();
-      // evaluate the integrand
-      LOG_(debug) << "   point_in_{reference_element|physical_space} = {" << print(point_in_reference_element) << "|"
-                  << print(element.geometry().global(point_in_reference_element))
-                  << "},\n   integration_factor = " << factor << ", quadrature_weight = " << quadrature_point.weight()
-                  << std::endl;
-      integrand_->evaluate(test_basis, ansatz_basis, point_in_reference_element, integrand_values_, param);
-      assert(integrand_values_.rows() >= rows && "This must not happen!");
-      assert(integrand_values_.cols() >= cols && "This must not happen!");
-      // compute integral
-      for (size_t ii = 0; ii < rows; ++ii)
-        for (size_t jj = 0; jj < cols; ++jj)
-          result[ii][jj] += integrand_values_[ii][jj] * factor;
-    } // loop over all quadrature points
+    const auto& quadrature = QuadratureRules<D, d>::rule(element.type(), integrand_order);
+    if (this->logger.debug_enabled) {
+      for (const auto& quadrature_point : quadrature) {
+        const auto& point_in_reference_element = quadrature_point.position();
+        const auto factor =
+            element.geometry().integrationElement(point_in_reference_element) * quadrature_point.weight();
+        LOG_(debug) << "   point_in_{reference_element|physical_space} = {" << print(point_in_reference_element) << "|"
+                    << print(element.geometry().global(point_in_reference_element))
+                    << "},\n   integration_factor = " << factor << ", quadrature_weight = " << quadrature_point.weight()
+                    << std::endl;
+      }
+    }
+    // integrate over all quadrature points at once
+    integrand_->evaluate_all(test_basis, ansatz_basis, quadrature, result, param);
     LOG_(debug) << "  result = " << result << std::endl;
   } // ... apply(...)
 
 private:
   mutable std::unique_ptr<IntegrandType> integrand_;
   const int over_integrate_;
-  mutable DynamicMatrix<F> integrand_values_;
 }; // class LocalElementIntegralBilinearForm
 
 
@@ -0,0 +1,331 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+#ifndef DUNE_GDT_LOCAL_FINITE_ELEMENTS_SUM_FACTORIZATION_HH
+#define DUNE_GDT_LOCAL_FINITE_ELEMENTS_SUM_FACTORIZATION_HH
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include "interfaces.hh"
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief Sum-factorized evaluation of tensor-product Lagrange (Q_k) finite elements on cubes.
+ *
+ * Given a local finite element, checks (once, upon construction) whether its scalar basis is the tensor product of
+ * the 1d equidistant Lagrange basis of the same order and determines the mapping between the lexicographic tensor
+ * ordering and the ordering of the finite element. If so, valid() returns true and the basis can be evaluated at the
+ * tensor-product Gauss points of the given order by successive 1d contractions, which costs O((k+1)^{d+1}) instead of
+ * O((k+1)^{2d}) per element.
+ *
+ * All tensors (DoFs and values at quadrature points) are given in lexicographic ordering, i.e. the first index runs
+ * fastest, use dof_index() to map to the ordering of the finite element. Gradients are taken w.r.t. the reference
+ * element.
+ *
+ * \note In the vector-valued case, only the first component of the first unpowered block of basis functions is checked,
+ *       see LocalPowerFiniteElement for the ordering of the remaining ones.
+ * \note Uses internal buffers, not thread-safe.
+ */
+template <class D, size_t d, class R = double>
+class LocalSumFactorizedLagrangeKernel
+{
+  using ThisType = LocalSumFactorizedLagrangeKernel;
+
+public:
+  using DomainType = FieldVector<D, d>;
+
+  template <size_t r>
+  LocalSumFactorizedLagrangeKernel(const LocalFiniteElementInterface<D, d, R, r>& finite_element,
+                                   const int quadrature_order)
+    : order_(finite_element.order())
+    , quadrature_order_(quadrature_order)
+    , finite_element_size_(finite_element.size())
+    , valid_(false)
+  {
+    if (!finite_element.geometry_type().isCube() || !finite_element.is_lagrangian() || order_ < 0)
+      return;
+    const size_t n = static_cast<size_t>(order_) + 1;
+    num_dofs_ = ipow(n);
+    const auto& lagrange_points = finite_element.lagrange_points();
+    if (lagrange_points.size() != num_dofs_ || finite_element_size_ != r * num_dofs_)
+      return;
+    // 1d Gauss points and weights
+    const auto& rule_1d = QuadratureRules<D, 1>::rule(GeometryTypes::line, quadrature_order_);
+    const size_t nq = rule_1d.size();
+    std::vector<D> points_1d(nq);
+    std::vector<R> weights_1d(nq);
+    for (size_t qq = 0; qq < nq; ++qq) {
+      points_1d[qq] = rule_1d[qq].position()[0];
+      weights_1d[qq] = rule_1d[qq].weight();
+    }
+    num_points_ = ipow(nq);
+    points_.resize(num_points_);
+    weights_.resize(num_points_);
+    for (size_t qq = 0; qq < num_points_; ++qq) {
+      weights_[qq] = 1.;
+      for (size_t ll = 0, remainder = qq; ll < d; ++ll, remainder /= nq) {
+        points_[qq][ll] = points_1d[remainder % nq];
+        weights_[qq] *= weights_1d[remainder % nq];
+      }
+    }
+    // 1d Lagrange basis in the equidistant nodes ii/k (or the center for k = 0) and its derivatives
+    values_1d_ = DynamicMatrix<R>(nq, n, 0.);
+    derivatives_1d_ = DynamicMatrix<R>(nq, n, 0.);
+    for (size_t qq = 0; qq < nq; ++qq)
+      for (size_t ii = 0; ii < n; ++ii) {
+        values_1d_[qq][ii] = evaluate_1d(ii, points_1d[qq]);
+        derivatives_1d_[qq][ii] = derivative_1d(ii, points_1d[qq]);
+      }
+    transposed_values_1d_ = transpose(values_1d_);
+    transposed_derivatives_1d_ = transpose(derivatives_1d_);
+    // mapping from the tensor ordering to the ordering of the finite element
+    dof_indices_.assign(num_dofs_, num_dofs_);
+    std::vector<std::array<size_t, d>> multi_indices(num_dofs_);
+    for (size_t jj = 0; jj < num_dofs_; ++jj) {
+      size_t tensor_index = 0;
+      for (size_t ll = 0, stride = 1; ll < d; ++ll, stride *= n) {
+        const auto scaled = lagrange_points[jj][ll] * order_;
+        const auto index = std::round(scaled);
+        if (std::abs(scaled - index) > 1e-10 || index < 0 || index > order_)
+          return;
+        multi_indices[jj][ll] = static_cast<size_t>(index);
+        tensor_index += multi_indices[jj][ll] * stride;
+      }
+      if (dof_indices_[tensor_index] != num_dofs_)
+        return;
+      dof_indices_[tensor_index] = jj;
+    }
+    // check that the finite element is really of tensor-product form
+    using RangeType = typename LocalFiniteElementInterface<D, d, R, r>::BasisType::RangeType;
+    std::vector<RangeType> basis_values(finite_element_size_);
+    for (size_t qq = 0; qq < num_points_; ++qq) {
+      finite_element.basis().evaluate(points_[qq], basis_values);
+      for (size_t jj = 0; jj < num_dofs_; ++jj) {
+        R expected = 1.;
+        for (size_t ll = 0; ll < d; ++ll)
+          expected *= evaluate_1d(multi_indices[jj][ll], points_[qq][ll]);
+        if (std::abs(basis_values[jj][0] - expected) > 1e-10 * std::max(R(1.), std::abs(expected)))
+          return;
+      }
+    }
+    valid_ = true;
+  } // LocalSumFactorizedLagrangeKernel(...)
+
+  LocalSumFactorizedLagrangeKernel(const ThisType& other) = default;
+
+  /// Whether the finite element given upon construction is supported, all other methods require this to be true.
+  bool valid() const
+  {
+    return valid_;
+  }
+
+  int order() const
+  {
+    return order_;
+  }
+
+  int quadrature_order() const
+  {
+    return quadrature_order_;
+  }
+
+  /// The size of the finite element given upon construction.
+  size_t finite_element_size() const
+  {
+    return finite_element_size_;
+  }
+
+  /// The number of scalar DoFs, (k+1)^d.
+  size_t num_dofs() const
+  {
+    return num_dofs_;
+  }
+
+  /// The index of the tensor_index-th scalar DoF in the ordering of the finite element.
+  size_t dof_index(const size_t tensor_index) const
+  {
+    return dof_indices_[tensor_index];
+  }
+
+  size_t num_points() const
+  {
+    return num_points_;
+  }
+
+  const DomainType& point(const size_t ii) const
+  {
+    return points_[ii];
+  }
+
+  R weight(const size_t ii) const
+  {
+    return weights_[ii];
+  }
+
+  /// Computes the values of the function given by dofs in all quadrature points.
+  void interpolate(const std::vector<R>& dofs, std::vector<R>& values) const
+  {
+    std::array<const DynamicMatrix<R>*, d> matrices;
+    matrices.fill(&values_1d_);
+    tensor_apply(matrices, dofs, values);
+  }
+
+  /// Computes the reference gradients of the function given by dofs in all quadrature points.
+  void interpolate_gradients(const std::vector<R>& dofs, std::array<std::vector<R>, d>& gradients) const
+  {
+    std::array<const DynamicMatrix<R>*, d> matrices;
+    for (size_t jj = 0; jj < d; ++jj) {
+      matrices.fill(&values_1d_);
+      matrices[jj] = &derivatives_1d_;
+      tensor_apply(matrices, dofs, gradients[jj]);
+    }
+  }
+
+  /// Computes result[ii] = \sum_qq \sum_jj values[jj][qq] * \partial_jj \phi_ii(x_qq) (reference gradients).
+  void integrate_gradients(const std::array<std::vector<R>, d>& values, std::vector<R>& result) const
+  {
+    result.assign(num_dofs_, 0.);
+    std::array<const DynamicMatrix<R>*, d> matrices;
+    for (size_t jj = 0; jj < d; ++jj) {
+      matrices.fill(&transposed_values_1d_);
+      matrices[jj] = &transposed_derivatives_1d_;
+      tensor_apply(matrices, values[jj], buffers_[2]);
+      for (size_t ii = 0; ii < num_dofs_; ++ii)
+        result[ii] += buffers_[2][ii];
+    }
+  }
+
+private:
+  static size_t ipow(const size_t n)
+  {
+    size_t ret = 1;
+    for (size_t ll = 0; ll < d; ++ll)
+      ret *= n;
+    return ret;
+  }
+
+  D node_1d(const size_t ii) const
+  {
+    return (order_ == 0) ? 0.5 : D(ii) / order_;
+  }
+
+  R evaluate_1d(const size_t ii, const D& x) const
+  {
+    R ret = 1.;
+    for (size_t jj = 0; jj <= static_cast<size_t>(order_); ++jj)
+      if (jj != ii)
+        ret *= (x - node_1d(jj)) / (node_1d(ii) - node_1d(jj));
+    return ret;
+  }
+
+  R derivative_1d(const size_t ii, const D& x) const
+  {
+    R ret = 0.;
+    for (size_t mm = 0; mm <= static_cast<size_t>(order_); ++mm) {
+      if (mm == ii)
+        continue;
+      R summand = 1. / (node_1d(ii) - node_1d(mm));
+      for (size_t jj = 0; jj <= static_cast<size_t>(order_); ++jj)
+        if (jj != ii && jj != mm)
+          summand *= (x - node_1d(jj)) / (node_1d(ii) - node_1d(jj));
+      ret += summand;
+    }
+    return ret;
+  }
+
+  static DynamicMatrix<R> transpose(const DynamicMatrix<R>& matrix)
+  {
+    DynamicMatrix<R> ret(matrix.cols(), matrix.rows(), 0.);
+    for (size_t ii = 0; ii < matrix.rows(); ++ii)
+      for (size_t jj = 0; jj < matrix.cols(); ++jj)
+        ret[jj][ii] = matrix[ii][jj];
+    return ret;
+  }
+
+  /// Applies matrix along direction dir of the tensor in (with the given extents), updates extents.
+  static void contract(const DynamicMatrix<R>& matrix,
+                       const size_t dir,
+                       std::array<size_t, d>& extents,
+                       const std::vector<R>& in,
+                       std::vector<R>& out)
+  {
+    const size_t rows = matrix.rows();
+    const size_t cols = matrix.cols();
+    assert(extents[dir] == cols);
+    size_t pre = 1;
+    for (size_t ll = 0; ll < dir; ++ll)
+      pre *= extents[ll];
+    size_t post = 1;
+    for (size_t ll = dir + 1; ll < d; ++ll)
+      post *= extents[ll];
+    out.resize(pre * rows * post);
+    for (size_t cc = 0; cc < post; ++cc)
+      for (size_t rr = 0; rr < rows; ++rr) {
+        R* out_row = out.data() + pre * (rr + rows * cc);
+        std::fill(out_row, out_row + pre, R(0.));
+        for (size_t kk = 0; kk < cols; ++kk) {
+          const R factor = matrix[rr][kk];
+          const R* in_row = in.data() + pre * (kk + cols * cc);
+          for (size_t aa = 0; aa < pre; ++aa)
+            out_row[aa] += factor * in_row[aa];
+        }
+      }
+    extents[dir] = rows;
+  } // ... contract(...)
+
+  /// Applies the Kronecker product of the given matrices (one per direction) to in.
+  void tensor_apply(const std::array<const DynamicMatrix<R>*, d>& matrices,
+                    const std::vector<R>& in,
+                    std::vector<R>& out) const
+  {
+    std::array<size_t, d> extents;
+    for (size_t ll = 0; ll < d; ++ll)
+      extents[ll] = matrices[ll]->cols();
+    const std::vector<R>* source = &in;
+    for (size_t ll = 0; ll < d; ++ll) {
+      std::vector<R>& target = (ll + 1 == d) ? out : buffers_[ll % 2];
+      contract(*matrices[ll], ll, extents, *source, target);
+      source = &target;
+    }
+  } // ... tensor_apply(...)
+
+  const int order_;
+  const int quadrature_order_;
+  const size_t finite_element_size_;
+  bool valid_;
+  size_t num_dofs_ = 0;
+  size_t num_points_ = 0;
+  std::vector<DomainType> points_;
+  std::vector<R> weights_;
+  std::vector<size_t> dof_indices_;
+  DynamicMatrix<R> values_1d_;
+  DynamicMatrix<R> derivatives_1d_;
+  DynamicMatrix<R> transposed_values_1d_;
+  DynamicMatrix<R> transposed_derivatives_1d_;
+  mutable std::array<std::vector<R>, 3> buffers_;
+}; // class LocalSumFactorizedLagrangeKernel
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_LOCAL_FINITE_ELEMENTS_SUM_FACTORIZATION_HH
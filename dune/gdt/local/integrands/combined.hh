@@ -175,6 +175,7 @@ public:
   using typename BaseType::ElementType;
   using typename BaseType::LocalAnsatzBasisType;
   using typename BaseType::LocalTestBasisType;
+  using typename BaseType::QuadratureType;
 
   LocalBinaryElementIntegrandSum(const BaseType& left, const BaseType& right)
     : BaseType(left.parameter_type() + right.parameter_type())
@@ -231,6 +232,22 @@ public:
         result[ii][jj] += right_result_[ii][jj];
   } // ... evaluate(...)
 
+  void evaluate_all(const LocalTestBasisType& test_basis,
+                    const LocalAnsatzBasisType& ansatz_basis,
+                    const QuadratureType& quadrature,
+                    DynamicMatrix<F>& result,
+                    const XT::Common::Parameter& param = {}) const final
+  {
+    // Same as above, but let each integrand use its batched evaluation.
+    left_.access().evaluate_all(test_basis, ansatz_basis, quadrature, result, param);
+    right_.access().evaluate_all(test_basis, ansatz_basis, quadrature, right_result_, param);
+    const size_t rows = test_basis.size(param);
+    const size_t cols = ansatz_basis.size(param);
+    for (size_t ii = 0; ii < rows; ++ii)
+      for (size_t jj = 0; jj < cols; ++jj)
+        result[ii][jj] += right_result_[ii][jj];
+  } // ... evaluate_all(...)
+
 private:
   XT::Common::StorageProvider<BaseType> left_;
   XT::Common::StorageProvider<BaseType> right_;
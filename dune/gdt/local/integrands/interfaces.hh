@@ -13,8 +13,12 @@
 #ifndef DUNE_GDT_LOCAL_INTEGRANDS_INTERFACES_HH
 #define DUNE_GDT_LOCAL_INTEGRANDS_INTERFACES_HH
 
+#include <vector>
+
 #include <dune/common/dynvector.hh>
 
+#include <dune/geometry/quadraturerules.hh>
+
 #include <dune/xt/common/parameter.hh>
 #include <dune/xt/common/timedlogging.hh>
 #include <dune/xt/grid/bound-object.hh>
@@ -26,6 +30,38 @@
 
 namespace Dune {
 namespace GDT {
+namespace internal {
+
+
+/**
+ * Computes result[ii][jj] += <test_values[ii*length:(ii+1)*length], ansatz_values[jj*length:(jj+1)*length]>, used by
+ * the batched evaluate_all(...) of integrands which store their values for all quadrature points contiguously.
+ */
+template <class F>
+void accumulate_flat_products(const std::vector<F>& test_values,
+                              const std::vector<F>& ansatz_values,
+                              const size_t rows,
+                              const size_t cols,
+                              const size_t length,
+                              DynamicMatrix<F>& result)
+{
+  assert(test_values.size() >= rows * length);
+  assert(ansatz_values.size() >= cols * length);
+  for (size_t ii = 0; ii < rows; ++ii) {
+    const F* test_row = test_values.data() + ii * length;
+    auto& result_row = result[ii];
+    for (size_t jj = 0; jj < cols; ++jj) {
+      const F* ansatz_row = ansatz_values.data() + jj * length;
+      F sum = 0;
+      for (size_t kk = 0; kk < length; ++kk)
+        sum += test_row[kk] * ansatz_row[kk];
+      result_row[jj] += sum;
+    }
+  }
+} // ... accumulate_flat_products(...)
+
+
+} // namespace internal
 
 
 // forwards (required for operator+), includes are below
@@ -200,6 +236,7 @@ public:
 
   using typename XT::Grid::ElementBoundObject<Element>::ElementType;
   using DomainType = FieldVector<D, d>;
+  using QuadratureType = QuadratureRule<D, d>;
   using LocalTestBasisType = XT::Functions::ElementFunctionSetInterface<E, t_r, t_rC, TR>;
   using LocalAnsatzBasisType = XT::Functions::ElementFunctionSetInterface<E, a_r, a_rC, AR>;
 
@@ -270,6 +307,39 @@ public:
     return result;
   }
 
+  /**
+   * Computes the sum of the evaluations of this integrand at all points of the given quadrature, weighted by the
+   * quadrature weight and the integration element, for each combination of functions from the two bases (i.e., the
+   * integral of this integrand over the element).
+   *
+   * The default implementation loops over the quadrature points and calls evaluate(...) for each point. Integrands
+   * should override this to avoid the virtual call and the clearing of the result per point, and to store their
+   * values in a layout which allows the compiler to vectorize across quadrature points.
+   *
+   * \note Will throw Exceptions::not_bound_to_an_element_yet error if not bound yet!
+   **/
+  virtual void evaluate_all(const LocalTestBasisType& test_basis,
+                            const LocalAnsatzBasisType& ansatz_basis,
+                            const QuadratureType& quadrature,
+                            DynamicMatrix<F>& result,
+                            const XT::Common::Parameter& param = {}) const
+  {
+    this->ensure_size_and_clear_results(test_basis, ansatz_basis, result, param);
+    const size_t rows = test_basis.size(param);
+    const size_t cols = ansatz_basis.size(param);
+    const auto& geometry = this->element().geometry();
+    for (const auto& quadrature_point : quadrature) {
+      const auto& point_in_reference_element = quadrature_point.position();
+      const auto factor = geometry.integrationElement(point_in_reference_element) * quadrature_point.weight();
+      this->evaluate(test_basis, ansatz_basis, point_in_reference_element, point_values_, param);
+      assert(point_values_.rows() >= rows && "This must not happen!");
+      assert(point_values_.cols() >= cols && "This must not happen!");
+      for (size_t ii = 0; ii < rows; ++ii)
+        for (size_t jj = 0; jj < cols; ++jj)
+          result[ii][jj] += point_values_[ii][jj] * factor;
+    }
+  } // ... evaluate_all(...)
+
 protected:
   void ensure_size_and_clear_results(const LocalTestBasisType& test_basis,
                                      const LocalAnsatzBasisType& ansatz_basis,
@@ -282,6 +352,9 @@ protected:
       result.resize(rows, cols);
     result *= 0;
   } // ... ensure_size_and_clear_results(...)
+
+private:
+  mutable DynamicMatrix<F> point_values_;
 }; // class LocalBinaryElementIntegrandInterface
 
 
@@ -36,6 +36,7 @@ public:
   using typename BaseType::ElementType;
   using typename BaseType::LocalAnsatzBasisType;
   using typename BaseType::LocalTestBasisType;
+  using typename BaseType::QuadratureType;
 
   explicit LocalLaplaceIntegrand(
       XT::Functions::GridFunction<E, d, d, F> diffusion = XT::LA::eye_matrix<FieldMatrix<F, d, d>>(d, d),
@@ -101,11 +102,58 @@ public:
           result[ii][jj] += (weight * ansatz_basis_grads_[jj][rr]) * test_basis_grads_[ii][rr];
   } // ... evaluate(...)
 
+  /**
+   * Stores the test gradients and the weighted ansatz gradients (including the quadrature weight and integration
+   * element) for all quadrature points contiguously per basis function, so that each entry of the result is a single
+   * dot product over all quadrature points.
+   */
+  void evaluate_all(const LocalTestBasisType& test_basis,
+                    const LocalAnsatzBasisType& ansatz_basis,
+                    const QuadratureType& quadrature,
+                    DynamicMatrix<F>& result,
+                    const XT::Common::Parameter& param = {}) const override final
+  {
+    // prepare storage
+    this->ensure_size_and_clear_results(test_basis, ansatz_basis, result, param);
+    const size_t rows = test_basis.size(param);
+    const size_t cols = ansatz_basis.size(param);
+    const size_t length = quadrature.size() * r * d;
+    if (test_values_.size() < rows * length)
+      test_values_.resize(rows * length);
+    if (ansatz_values_.size() < cols * length)
+      ansatz_values_.resize(cols * length);
+    // evaluate
+    const auto& geometry = this->element().geometry();
+    size_t offset = 0;
+    for (const auto& quadrature_point : quadrature) {
+      const auto& point_in_reference_element = quadrature_point.position();
+      const auto factor = geometry.integrationElement(point_in_reference_element) * quadrature_point.weight();
+      test_basis.jacobians(point_in_reference_element, test_basis_grads_, param);
+      ansatz_basis.jacobians(point_in_reference_element, ansatz_basis_grads_, param);
+      const auto weight = local_weight_->evaluate(point_in_reference_element, param);
+      for (size_t rr = 0; rr < r; ++rr) {
+        for (size_t ii = 0; ii < rows; ++ii)
+          for (size_t dd = 0; dd < d; ++dd)
+            test_values_[ii * length + offset + dd] = test_basis_grads_[ii][rr][dd];
+        for (size_t jj = 0; jj < cols; ++jj) {
+          const auto weighted_grad = weight * ansatz_basis_grads_[jj][rr];
+          for (size_t dd = 0; dd < d; ++dd)
+            ansatz_values_[jj * length + offset + dd] = factor * weighted_grad[dd];
+        }
+        offset += d;
+      }
+    }
+    // compute integral
+    internal::accumulate_flat_products(test_values_, ansatz_values_, rows, cols, length, result);
+  } // ... evaluate_all(...)
+
 private:
   const std::unique_ptr<XT::Functions::GridFunctionInterface<E, d, d, F>> weight_;
   std::unique_ptr<typename XT::Functions::GridFunctionInterface<E, d, d, F>::LocalFunctionType> local_weight_;
   mutable std::vector<typename LocalTestBasisType::DerivativeRangeType> test_basis_grads_;
   mutable std::vector<typename LocalAnsatzBasisType::DerivativeRangeType> ansatz_basis_grads_;
+  mutable std::vector<F> test_values_;
+  mutable std::vector<F> ansatz_values_;
 }; // class LocalLaplaceIntegrand
 
 
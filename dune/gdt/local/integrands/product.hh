@@ -52,6 +52,7 @@ public:
   using typename BaseType::ElementType;
   using typename BaseType::LocalAnsatzBasisType;
   using typename BaseType::LocalTestBasisType;
+  using typename BaseType::QuadratureType;
 
   LocalElementProductIntegrand(XT::Functions::GridFunction<E, r, r, F> weight = {1.},
                                const std::string& logging_prefix = "")
@@ -129,11 +130,60 @@ public:
     LOG_(debug) << "  result = " << print(result, {{"oneline", "true"}}) << std::endl;
   } // ... evaluate(...)
 
+  /**
+   * Stores the weighted test values (including the quadrature weight and integration element) and the ansatz values
+   * for all quadrature points contiguously per basis function, so that each entry of the result is a single dot
+   * product over all quadrature points.
+   */
+  void evaluate_all(const LocalTestBasisType& test_basis,
+                    const LocalAnsatzBasisType& ansatz_basis,
+                    const QuadratureType& quadrature,
+                    DynamicMatrix<F>& result,
+                    const XT::Common::Parameter& param = {}) const final
+  {
+    LOG_(debug) << "evaluate_all({test|ansatz}_basis.size()={" << test_basis.size(param) << "|"
+                << ansatz_basis.size(param) << "}, quadrature.size()=" << quadrature.size() << ", param=" << param
+                << ")" << std::endl;
+    // prepare storage
+    this->ensure_size_and_clear_results(test_basis, ansatz_basis, result, param);
+    const size_t rows = test_basis.size(param);
+    const size_t cols = ansatz_basis.size(param);
+    const size_t length = quadrature.size() * r;
+    if (test_values_.size() < rows * length)
+      test_values_.resize(rows * length);
+    if (ansatz_values_.size() < cols * length)
+      ansatz_values_.resize(cols * length);
+    // evaluate
+    const auto& geometry = this->element().geometry();
+    size_t offset = 0;
+    for (const auto& quadrature_point : quadrature) {
+      const auto& point_in_reference_element = quadrature_point.position();
+      const auto factor = geometry.integrationElement(point_in_reference_element) * quadrature_point.weight();
+      test_basis.evaluate(point_in_reference_element, test_basis_values_, param);
+      ansatz_basis.evaluate(point_in_reference_element, ansatz_basis_values_, param);
+      const auto weight = local_weight_->evaluate(point_in_reference_element, param);
+      for (size_t ii = 0; ii < rows; ++ii) {
+        const auto weighted_value = weight * test_basis_values_[ii];
+        for (size_t rr = 0; rr < r; ++rr)
+          test_values_[ii * length + offset + rr] = factor * weighted_value[rr];
+      }
+      for (size_t jj = 0; jj < cols; ++jj)
+        for (size_t rr = 0; rr < r; ++rr)
+          ansatz_values_[jj * length + offset + rr] = ansatz_basis_values_[jj][rr];
+      offset += r;
+    }
+    // compute integral
+    internal::accumulate_flat_products(test_values_, ansatz_values_, rows, cols, length, result);
+    LOG_(debug) << "  result = " << print(result, {{"oneline", "true"}}) << std::endl;
+  } // ... evaluate_all(...)
+
 private:
   const std::unique_ptr<XT::Functions::GridFunctionInterface<E, r, r, F>> weight_;
   std::unique_ptr<typename XT::Functions::GridFunctionInterface<E, r, r, F>::LocalFunctionType> local_weight_;
   mutable std::vector<typename LocalTestBasisType::RangeType> test_basis_values_;
   mutable std::vector<typename LocalAnsatzBasisType::RangeType> ansatz_basis_values_;
+  mutable std::vector<F> test_values_;
+  mutable std::vector<F> ansatz_values_;
 }; // class LocalElementProductIntegrand
 
 
@@ -101,6 +101,47 @@ public:
                          [](const double& a, const double& b) { return std::min(a, b); });
   }
 
+  /// \note Uses the same quadrature as apply(), but maps it to the state intervals directly and evaluates f(0) once.
+  void apply_batch(const size_t num_faces,
+                   const size_t stride,
+                   const R* u,
+                   const R* v,
+                   const typename I::ctype* n,
+                   R* g,
+                   const XT::Common::Parameter& param = {}) const override final
+  {
+    this->check_batch(num_faces, stride);
+    const auto& quadrature = QuadratureRules<R, 1>::rule(GeometryTypes::line, local_flux_inside_->order(param));
+    const auto f_0 = local_flux_inside_->evaluate(x_in_inside_coords_, 0., param);
+    PhysicalDomainType n_ff;
+    StateType uu;
+    // integrates min_max(n * f'(uu), 0) over [0, s], see apply()
+    auto integrate_f = [&](const LocalFluxType& local_flux, const auto& x, const R& s, const auto& min_max) {
+      if (!(s > 0.))
+        return 0.;
+      double ret = 0.;
+      for (const auto& quadrature_point : quadrature) {
+        uu[0] = s * quadrature_point.position()[0];
+        const auto df = local_flux.jacobian(x, uu, param);
+        ret += s * quadrature_point.weight() * min_max(n_ff * df[0], 0.);
+      }
+      return ret;
+    };
+    for (size_t ff = 0; ff < num_faces; ++ff) {
+      for (size_t dd = 0; dd < d; ++dd)
+        n_ff[dd] = n[dd * stride + ff];
+      g[ff] = (f_0 * n_ff)[0]
+              + integrate_f(*local_flux_inside_,
+                            x_in_inside_coords_,
+                            u[ff],
+                            [](const double& a, const double& b) { return std::max(a, b); })
+              + integrate_f(*local_flux_inside_, // <- the flux is x-independent
+                            x_in_inside_coords_,
+                            v[ff],
+                            [](const double& a, const double& b) { return std::min(a, b); });
+    }
+  } // ... apply_batch(...)
+
 private:
   using BaseType::local_flux_inside_;
   using BaseType::local_flux_outside_;
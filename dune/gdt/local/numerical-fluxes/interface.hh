@@ -126,6 +126,43 @@ public:
     ret = XT::Common::convert_to<DynamicStateType>(apply(x_in_local_intersection_coords, u, v, n, param));
   }
 
+  /**
+   * \brief Evaluates the numerical flux for num_faces pairs of states at once (e.g., for a batch of intersections).
+   *
+   * All arrays are in structure-of-arrays layout: the ii-th component of u belonging to face ff is
+   * u[ii * stride + ff], the same holds for v, g and the dd-th component of the unit outer normal n, where
+   * stride >= num_faces.
+   *
+   * \note Only available for x-independent fluxes. As with apply(), the flux has to be bound, but any intersection
+   *       will do.
+   * \note The default implementation calls apply() for each face, derived classes override it by loops over the faces
+   *       which avoid the virtual calls and conversions per face.
+   */
+  virtual void apply_batch(const size_t num_faces,
+                           const size_t stride,
+                           const R* u,
+                           const R* v,
+                           const typename I::ctype* n,
+                           R* g,
+                           const XT::Common::Parameter& param = {}) const
+  {
+    this->check_batch(num_faces, stride);
+    const LocalIntersectionCoords x_in_local_intersection_coords;
+    StateType u_ff, v_ff;
+    PhysicalDomainType n_ff;
+    for (size_t ff = 0; ff < num_faces; ++ff) {
+      for (size_t ii = 0; ii < m; ++ii) {
+        u_ff[ii] = u[ii * stride + ff];
+        v_ff[ii] = v[ii * stride + ff];
+      }
+      for (size_t dd = 0; dd < d; ++dd)
+        n_ff[dd] = n[dd * stride + ff];
+      const StateType g_ff = this->apply(x_in_local_intersection_coords, u_ff, v_ff, n_ff, param);
+      for (size_t ii = 0; ii < m; ++ii)
+        g[ii * stride + ff] = g_ff[ii];
+    }
+  } // ... apply_batch(...)
+
   // Convenience apply methods
   template <class V>
   StateType apply(const LocalIntersectionCoords x_in_local_intersection_coords,
@@ -184,6 +221,16 @@ protected:
       local_flux_outside_->bind(inter.outside());
   }
 
+  void check_batch(const size_t num_faces, const size_t stride) const
+  {
+    DUNE_THROW_IF(this->x_dependent(),
+                  Exceptions::numerical_flux_error,
+                  "Batched evaluation is not available for x-dependent fluxes!");
+    DUNE_THROW_IF(stride < num_faces,
+                  Exceptions::numerical_flux_error,
+                  "num_faces = " << num_faces << "\n   stride = " << stride);
+  }
+
   void compute_entity_coords(const LocalIntersectionCoords& x_in_local_intersection_coords) const
   {
     if (this->x_dependent()) {
@@ -86,6 +86,42 @@ public:
     return ret;
   }
 
+  void apply_batch(const size_t num_faces,
+                   const size_t stride,
+                   const R* u,
+                   const R* v,
+                   const typename I::ctype* n,
+                   R* g,
+                   const XT::Common::Parameter& param = {}) const override final
+  {
+    this->check_batch(num_faces, stride);
+    StateType u_ff, v_ff;
+    for (size_t ff = 0; ff < num_faces; ++ff) {
+      for (size_t ii = 0; ii < m; ++ii) {
+        u_ff[ii] = u[ii * stride + ff];
+        v_ff[ii] = v[ii * stride + ff];
+      }
+      R lambda = lambda_;
+      if (XT::Common::is_zero(lambda)) {
+        const auto df_u = local_flux_inside_->jacobian(x_in_inside_coords_, u_ff, param);
+        const auto df_v = local_flux_outside_->jacobian(x_in_outside_coords_, v_ff, param);
+        for (size_t dd = 0; dd < d; ++dd) {
+          lambda = std::max(lambda, df_u[dd].infinity_norm());
+          lambda = std::max(lambda, df_v[dd].infinity_norm());
+        }
+        lambda = 1. / lambda;
+      }
+      const auto f_u = local_flux_inside_->evaluate(x_in_inside_coords_, u_ff, param);
+      const auto f_v = local_flux_outside_->evaluate(x_in_outside_coords_, v_ff, param);
+      for (size_t ii = 0; ii < m; ++ii) {
+        R g_ii = (u_ff[ii] - v_ff[ii]) * (0.5 / lambda);
+        for (size_t dd = 0; dd < d; ++dd)
+          g_ii += (f_u[dd][ii] + f_v[dd][ii]) * (n[dd * stride + ff] * 0.5);
+        g[ii * stride + ff] = g_ii;
+      }
+    }
+  } // ... apply_batch(...)
+
 private:
   using BaseType::local_flux_inside_;
   using BaseType::local_flux_outside_;
@@ -72,6 +72,31 @@ public:
       return local_flux_outside_->evaluate(x_in_outside_coords_, v, param) * n;
   }
 
+  void apply_batch(const size_t num_faces,
+                   const size_t stride,
+                   const R* u,
+                   const R* v,
+                   const typename I::ctype* n,
+                   R* g,
+                   const XT::Common::Parameter& param = {}) const override final
+  {
+    this->check_batch(num_faces, stride);
+    StateType u_ff, v_ff;
+    PhysicalDomainType n_ff;
+    for (size_t ff = 0; ff < num_faces; ++ff) {
+      u_ff[0] = u[ff];
+      v_ff[0] = v[ff];
+      for (size_t dd = 0; dd < d; ++dd)
+        n_ff[dd] = n[dd * stride + ff];
+      const auto df = local_flux_inside_->jacobian(x_in_inside_coords_, (u_ff + v_ff) / 2., param);
+      // only the upwind state is evaluated
+      if (n_ff * df[0] > 0)
+        g[ff] = (local_flux_inside_->evaluate(x_in_inside_coords_, u_ff, param) * n_ff)[0];
+      else
+        g[ff] = (local_flux_outside_->evaluate(x_in_outside_coords_, v_ff, param) * n_ff)[0];
+    }
+  } // ... apply_batch(...)
+
 private:
   using BaseType::local_flux_inside_;
   using BaseType::local_flux_outside_;
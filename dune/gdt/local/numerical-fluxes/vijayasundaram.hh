@@ -126,6 +126,43 @@ public:
     return P_plus * u + P_minus * v;
   } // ... apply(...)
 
+  void apply_batch(const size_t num_faces,
+                   const size_t stride,
+                   const R* u,
+                   const R* v,
+                   const typename I::ctype* n,
+                   R* g,
+                   const XT::Common::Parameter& param = {}) const override final
+  {
+    this->check_batch(num_faces, stride);
+    StateType u_ff, v_ff, w_ff, T_inv_u, T_inv_v;
+    PhysicalDomainType n_ff;
+    for (size_t ff = 0; ff < num_faces; ++ff) {
+      for (size_t ii = 0; ii < m; ++ii) {
+        u_ff[ii] = u[ii * stride + ff];
+        v_ff[ii] = v[ii * stride + ff];
+        w_ff[ii] = 0.5 * (u_ff[ii] + v_ff[ii]);
+      }
+      for (size_t dd = 0; dd < d; ++dd)
+        n_ff[dd] = n[dd * stride + ff];
+      const auto eigendecomposition = flux_eigen_decomposition_(*local_flux_inside_, w_ff, n_ff, param);
+      const auto& evs = std::get<0>(eigendecomposition);
+      const auto& T = std::get<1>(eigendecomposition);
+      const auto& T_inv = std::get<2>(eigendecomposition);
+      // P_plus * u + P_minus * v = T * (Lambda_plus * T_inv * u + Lambda_minus * T_inv * v), see apply()
+      T_inv.mv(u_ff, T_inv_u);
+      T_inv.mv(v_ff, T_inv_v);
+      for (size_t jj = 0; jj < m; ++jj)
+        w_ff[jj] = XT::Common::max(evs[jj], 0.) * T_inv_u[jj] + XT::Common::min(evs[jj], 0.) * T_inv_v[jj];
+      for (size_t ii = 0; ii < m; ++ii) {
+        R g_ii = 0.;
+        for (size_t jj = 0; jj < m; ++jj)
+          g_ii += T[ii][jj] * w_ff[jj];
+        g[ii * stride + ff] = g_ii;
+      }
+    }
+  } // ... apply_batch(...)
+
 private:
   using BaseType::local_flux_inside_;
   const FluxEigenDecompositionLambdaType flux_eigen_decomposition_;
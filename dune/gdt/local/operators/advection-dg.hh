@@ -11,7 +11,9 @@
 #ifndef DUNE_GDT_LOCAL_OPERATORS_ADVECTION_DG_HH
 #define DUNE_GDT_LOCAL_OPERATORS_ADVECTION_DG_HH
 
+#include <array>
 #include <functional>
+#include <vector>
 
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/grid/common/rangegenerators.hh>
@@ -21,7 +23,9 @@
 #include <dune/xt/grid/intersection.hh>
 
 #include <dune/gdt/exceptions.hh>
+#include <dune/gdt/local/discretefunction.hh>
 #include <dune/gdt/local/dof-vector.hh>
+#include <dune/gdt/local/finite-elements/sum-factorization.hh>
 #include <dune/gdt/type_traits.hh>
 
 #include <dune/gdt/local/numerical-fluxes/interface.hh>
@@ -104,6 +108,7 @@ public:
     , flux_(other.flux_)
     , local_flux_(flux_.local_function())
     , local_mass_matrices_(other.local_mass_matrices_)
+    , use_sum_factorization_(other.use_sum_factorization_)
   {}
 
   std::unique_ptr<BaseType> copy() const override final
@@ -119,6 +124,28 @@ public:
 
   using BaseType::element;
 
+  /**
+   * \brief Controls the use of sum-factorized kernels (disabled by default).
+   *
+   * If enabled and the range basis is a tensor-product Lagrange basis on a cube, the volume integral is computed by
+   * successive 1d contractions (see LocalSumFactorizedLagrangeKernel), without evaluating the basis or its jacobians
+   * in each quadrature point. If the source is a discrete function with the same local basis, its values are obtained
+   * likewise. See examples/benchmark_sum_factorization.cc for a comparison with the generic quadrature loop.
+   */
+  ThisType& use_sum_factorization(const bool use = true)
+  {
+    use_sum_factorization_ = use;
+    return *this;
+  }
+
+  /**
+   * \brief The number of calls to apply() (on this instance) which used the sum-factorized kernel.
+   */
+  size_t num_sum_factorized_applications() const
+  {
+    return num_sum_factorized_applications_;
+  }
+
   void apply(LocalRangeType& local_range, const XT::Common::Parameter& param = {}) const override final
   {
     const auto& u_ = local_sources_[0];
@@ -128,6 +155,34 @@ public:
     const auto u_order = u_->order(param);
     const auto local_basis_order = basis.order(param);
     const auto integrand_order = local_flux_->order(param) * u_order + std::max(local_basis_order - 1, 0);
+    if (sum_factorization_applies(basis, integrand_order)) {
+      apply_sum_factorized(param);
+      ++num_sum_factorized_applications_;
+    } else
+      apply_generic(basis, integrand_order, param);
+    // apply inverse local mass matrix, if required
+    if (local_mass_matrices_.valid())
+      local_mass_matrices_.access().apply_inverse(element(), local_dofs_);
+    // add to local range
+    for (size_t ii = 0; ii < basis.size(param); ++ii)
+      local_range.dofs().add_to_entry(ii, local_dofs_[ii]);
+  } // ... apply(...)
+
+protected:
+  void post_bind(const E& ele) override final
+  {
+    BaseType::post_bind(ele);
+    local_flux_->bind(ele);
+  }
+
+private:
+  using LocalBasisType = typename LocalRangeType::LocalBasisType;
+  using LocalDiscreteSourceType = ConstLocalDiscreteFunction<SV, SGV, m, 1, SF>;
+  using SumFactorizationKernelType = LocalSumFactorizedLagrangeKernel<D, d, RF>;
+
+  void apply_generic(const LocalBasisType& basis, const int integrand_order, const XT::Common::Parameter& param) const
+  {
+    const auto& u_ = local_sources_[0];
     for (const auto& quadrature_point : QuadratureRules<D, d>::rule(element().type(), integrand_order)) {
       // prepare
       const auto point_in_reference_element = quadrature_point.position();
@@ -141,28 +196,106 @@ public:
       for (size_t ii = 0; ii < basis.size(param); ++ii)
         local_dofs_[ii] += integration_factor * quadrature_weight * -1. * (flux_value * basis_jacobians_[ii]);
     }
-    // apply local mass matrix, if required (not optimal, uses a temporary)
-    if (local_mass_matrices_.valid())
-      local_dofs_ = local_mass_matrices_.access().local_mass_matrix_inverse(element()) * local_dofs_;
-    // add to local range
-    for (size_t ii = 0; ii < basis.size(param); ++ii)
-      local_range.dofs().add_to_entry(ii, local_dofs_[ii]);
-  } // ... apply(...)
+  } // ... apply_generic(...)
 
-protected:
-  void post_bind(const E& ele) override final
+  bool sum_factorization_applies(const LocalBasisType& basis, const int integrand_order) const
   {
-    BaseType::post_bind(ele);
-    local_flux_->bind(ele);
-  }
+    if (!use_sum_factorization_ || !element().type().isCube())
+      return false;
+    const auto& finite_element = basis.finite_element();
+    // The finite elements are unique per geometry type and order (see LocalFiniteElementFamilyInterface), so both the
+    // kernel and the check of the source are only redone if the local finite element or the quadrature changes, which
+    // should not happen often.
+    if (!sum_factorization_kernel_ || sum_factorization_finite_element_ != &finite_element
+        || sum_factorization_kernel_->order() != finite_element.order()
+        || sum_factorization_kernel_->quadrature_order() != integrand_order
+        || sum_factorization_kernel_->finite_element_size() != finite_element.size()) {
+      sum_factorization_kernel_ = std::make_unique<SumFactorizationKernelType>(finite_element, integrand_order);
+      sum_factorization_finite_element_ = &finite_element;
+      checked_source_finite_element_ = nullptr;
+    }
+    if (!sum_factorization_kernel_->valid())
+      return false;
+    // the source values can be obtained by sum factorization if the source is discrete with the same local basis
+    discrete_source_ = dynamic_cast<const LocalDiscreteSourceType*>(local_sources_[0].get());
+    if (discrete_source_) {
+      const auto& source_finite_element = discrete_source_->basis().finite_element();
+      if (checked_source_finite_element_ != &source_finite_element) {
+        source_matches_finite_element_ = source_finite_element.size() == finite_element.size()
+                                         && source_finite_element.is_lagrangian()
+                                         && source_finite_element.lagrange_points() == finite_element.lagrange_points();
+        checked_source_finite_element_ = &source_finite_element;
+      }
+      if (!source_matches_finite_element_)
+        discrete_source_ = nullptr;
+    }
+    return true;
+  } // ... sum_factorization_applies(...)
+
+  void apply_sum_factorized(const XT::Common::Parameter& param) const
+  {
+    const auto& kernel = *sum_factorization_kernel_;
+    const size_t num_dofs = kernel.num_dofs();
+    const size_t num_points = kernel.num_points();
+    // values of the source in all quadrature points
+    if (discrete_source_) {
+      const auto& source_dofs = discrete_source_->dofs();
+      tensor_dofs_.resize(num_dofs);
+      for (size_t pp = 0; pp < m; ++pp) {
+        for (size_t ii = 0; ii < num_dofs; ++ii)
+          tensor_dofs_[ii] = source_dofs[pp * num_dofs + kernel.dof_index(ii)];
+        kernel.interpolate(tensor_dofs_, source_values_[pp]);
+      }
+    }
+    // the flux, transformed to the reference element and weighted, in all quadrature points
+    for (size_t pp = 0; pp < m; ++pp)
+      for (size_t jj = 0; jj < d; ++jj)
+        weighted_flux_values_[pp][jj].resize(num_points);
+    const auto geometry = element().geometry();
+    typename LocalSourceType::RangeReturnType source_value;
+    for (size_t qq = 0; qq < num_points; ++qq) {
+      const auto& point_in_reference_element = kernel.point(qq);
+      if (discrete_source_) {
+        for (size_t pp = 0; pp < m; ++pp)
+          source_value[pp] = source_values_[pp][qq];
+      } else
+        source_value = local_sources_[0]->evaluate(point_in_reference_element, param);
+      const auto flux_value = local_flux_->evaluate(point_in_reference_element, source_value, param);
+      const auto J_inv_T = geometry.jacobianInverseTransposed(point_in_reference_element);
+      const auto factor = -1. * geometry.integrationElement(point_in_reference_element) * kernel.weight(qq);
+      // grad phi = J_inv_T * reference_grad phi, thus flux * grad phi = (J_inv_T^T * flux) * reference_grad phi
+      for (size_t pp = 0; pp < m; ++pp)
+        for (size_t jj = 0; jj < d; ++jj) {
+          RF value = 0.;
+          for (size_t kk = 0; kk < d; ++kk)
+            value += J_inv_T[kk][jj] * flux_value[pp][kk];
+          weighted_flux_values_[pp][jj][qq] = factor * value;
+        }
+    }
+    // integrate against the reference gradients of the basis
+    for (size_t pp = 0; pp < m; ++pp) {
+      kernel.integrate_gradients(weighted_flux_values_[pp], tensor_dofs_);
+      for (size_t ii = 0; ii < num_dofs; ++ii)
+        local_dofs_[pp * num_dofs + kernel.dof_index(ii)] += tensor_dofs_[ii];
+    }
+  } // ... apply_sum_factorized(...)
 
-private:
   using BaseType::local_sources_;
   const FluxType& flux_;
   std::unique_ptr<typename FluxType::LocalFunctionType> local_flux_;
   const XT::Common::ConstStorageProvider<LocalMassMatrixProviderType> local_mass_matrices_;
+  bool use_sum_factorization_ = false;
+  mutable size_t num_sum_factorized_applications_ = 0;
   mutable std::vector<typename LocalRangeType::LocalBasisType::DerivativeRangeType> basis_jacobians_;
   mutable XT::LA::CommonDenseVector<RF> local_dofs_;
+  mutable std::unique_ptr<SumFactorizationKernelType> sum_factorization_kernel_;
+  mutable const void* sum_factorization_finite_element_ = nullptr;
+  mutable const void* checked_source_finite_element_ = nullptr;
+  mutable bool source_matches_finite_element_ = false;
+  mutable const LocalDiscreteSourceType* discrete_source_ = nullptr;
+  mutable std::vector<RF> tensor_dofs_;
+  mutable std::array<std::vector<RF>, m> source_values_;
+  mutable std::array<std::array<std::vector<RF>, d>, m> weighted_flux_values_;
 }; // class LocalAdvectionDgVolumeOperator
 
 
@@ -324,13 +457,11 @@ public:
         for (size_t ii = 0; ii < outside_basis.size(param); ++ii)
           outside_local_dofs_[ii] -= integration_factor * quadrature_weight * (g * outside_basis_values_[ii]);
     }
-    // apply local mass matrix, if required (not optimal, uses a temporary)
+    // apply inverse local mass matrix, if required
     if (local_mass_matrices_.valid())
-      inside_local_dofs_ =
-          local_mass_matrices_.access().local_mass_matrix_inverse(intersection().inside()) * inside_local_dofs_;
+      local_mass_matrices_.access().apply_inverse(intersection().inside(), inside_local_dofs_);
     if (compute_outside_ && local_mass_matrices_.valid())
-      outside_local_dofs_ =
-          local_mass_matrices_.access().local_mass_matrix_inverse(local_range_outside.element()) * outside_local_dofs_;
+      local_mass_matrices_.access().apply_inverse(local_range_outside.element(), outside_local_dofs_);
     // add to local range
     for (size_t ii = 0; ii < inside_basis.size(param); ++ii)
       local_range_inside.dofs().add_to_entry(ii, inside_local_dofs_[ii]);
@@ -389,6 +520,29 @@ public:
       const StateRangeType& /*u*/, const StateDomainType& /*n*/, const XT::Common::Parameter& /*param*/)>;
   using LocalMassMatrixProviderType = LocalMassMatrixProvider<RGV, m, 1, RF>;
 
+  // When using this constructor, source has to be set by a call to with_source before calling apply
+  LocalAdvectionDgBoundaryTreatmentByCustomNumericalFluxOperator(
+      LambdaType numerical_boundary_flux,
+      const int numerical_flux_order,
+      const XT::Common::ParameterType& numerical_flux_param_type = {})
+    : BaseType(1, numerical_flux_param_type)
+    , numerical_boundary_flux_(numerical_boundary_flux)
+    , numerical_flux_order_(numerical_flux_order)
+  {}
+
+  // When using this constructor, source has to be set by a call to with_source before calling apply
+  /// Applies the inverse of the local mass matrix.
+  LocalAdvectionDgBoundaryTreatmentByCustomNumericalFluxOperator(
+      const LocalMassMatrixProviderType& local_mass_matrices,
+      LambdaType numerical_boundary_flux,
+      const int numerical_flux_order,
+      const XT::Common::ParameterType& numerical_flux_param_type = {})
+    : BaseType(1, numerical_flux_param_type)
+    , numerical_boundary_flux_(numerical_boundary_flux)
+    , numerical_flux_order_(numerical_flux_order)
+    , local_mass_matrices_(local_mass_matrices)
+  {}
+
   LocalAdvectionDgBoundaryTreatmentByCustomNumericalFluxOperator(
       const SourceType& source,
       LambdaType numerical_boundary_flux,
@@ -472,9 +626,9 @@ public:
       for (size_t ii = 0; ii < inside_basis.size(param); ++ii)
         inside_local_dofs_[ii] += integration_factor * quadrature_weight * (g * inside_basis_values_[ii]);
     }
-    // apply local mass matrix, if required (not optimal, uses a temporary)
+    // apply inverse local mass matrix, if required
     if (local_mass_matrices_.valid())
-      inside_local_dofs_ = local_mass_matrices_.access().local_mass_matrix_inverse(element) * inside_local_dofs_;
+      local_mass_matrices_.access().apply_inverse(element, inside_local_dofs_);
     // add to local range
     for (size_t ii = 0; ii < inside_basis.size(param); ++ii)
       local_range_inside.dofs().add_to_entry(ii, inside_local_dofs_[ii]);
@@ -522,6 +676,31 @@ public:
                                    const XT::Common::Parameter& /*param*/)>;
   using LocalMassMatrixProviderType = LocalMassMatrixProvider<RGV, m, 1, RF>;
 
+  // When using this constructor, source has to be set by a call to with_source before calling apply
+  LocalAdvectionDgBoundaryTreatmentByCustomExtrapolationOperator(
+      const NumericalFluxType& numerical_flux,
+      LambdaType boundary_extrapolation_lambda,
+      const XT::Common::ParameterType& boundary_treatment_param_type = {})
+    : BaseType(1, numerical_flux.parameter_type() + boundary_treatment_param_type)
+    , numerical_flux_(numerical_flux.copy())
+    , local_flux_(numerical_flux_->flux().local_function())
+    , extrapolate_(boundary_extrapolation_lambda)
+  {}
+
+  // When using this constructor, source has to be set by a call to with_source before calling apply
+  /// Applies the inverse of the local mass matrix.
+  LocalAdvectionDgBoundaryTreatmentByCustomExtrapolationOperator(
+      const LocalMassMatrixProviderType& local_mass_matrices,
+      const NumericalFluxType& numerical_flux,
+      LambdaType boundary_extrapolation_lambda,
+      const XT::Common::ParameterType& boundary_treatment_param_type = {})
+    : BaseType(1, numerical_flux.parameter_type() + boundary_treatment_param_type)
+    , numerical_flux_(numerical_flux.copy())
+    , local_flux_(numerical_flux_->flux().local_function())
+    , extrapolate_(boundary_extrapolation_lambda)
+    , local_mass_matrices_(local_mass_matrices)
+  {}
+
   LocalAdvectionDgBoundaryTreatmentByCustomExtrapolationOperator(
       const SourceType& source,
       const NumericalFluxType& numerical_flux,
@@ -609,9 +788,9 @@ public:
       for (size_t ii = 0; ii < inside_basis.size(param); ++ii)
         inside_local_dofs_[ii] += integration_factor * quadrature_weight * (g * inside_basis_values_[ii]);
     }
-    // apply local mass matrix, if required (not optimal, uses a temporary)
+    // apply inverse local mass matrix, if required
     if (local_mass_matrices_.valid())
-      inside_local_dofs_ = local_mass_matrices_.access().local_mass_matrix_inverse(element) * inside_local_dofs_;
+      local_mass_matrices_.access().apply_inverse(element, inside_local_dofs_);
     // add to local range
     for (size_t ii = 0; ii < inside_basis.size(param); ++ii)
       local_range_inside.dofs().add_to_entry(ii, inside_local_dofs_[ii]);
@@ -802,9 +981,9 @@ public:
                              * smoothed_discrete_jump_indicator * (source_jacobian[0] * basis_jacobians_[ii][0]);
       }
     }
-    // apply local mass matrix, if required (not optimal, uses a temporary)
+    // apply inverse local mass matrix, if required
     if (local_mass_matrices_.valid())
-      local_dofs_ = local_mass_matrices_.access().local_mass_matrix_inverse(element()) * local_dofs_;
+      local_mass_matrices_.access().apply_inverse(element(), local_dofs_);
     // add to local range
     for (size_t ii = 0; ii < basis.size(param); ++ii)
       local_range.dofs().add_to_entry(ii, local_dofs_[ii]);
@@ -822,6 +1001,66 @@ private:
 }; // class LocalAdvectionDgArtificialViscosityShockCapturingOperator
 
 
+/**
+ * \brief Applies the inverse of the local mass matrix to the local DoFs of the range, in place.
+ *
+ * Used as a finalization (see LocalizableOperator::append_finalization) of operators whose other local operators do
+ * not apply the inverse of the local mass matrix themselves, so that it is applied only once per element to the sum
+ * of all volume and face contributions.
+ *
+ * \note See also LocalElementOperatorInterface for a description of the template arguments.
+ *
+ * \sa LocalElementOperatorInterface
+ */
+template <class SV, class SGV, size_t m = 1, class SF = double, class RF = SF, class RGV = SGV, class RV = SV>
+class LocalAdvectionDgInverseMassOperator
+  : public LocalElementOperatorInterface<SV, SGV, m, 1, SF, m, 1, RF, RGV, RV>
+{
+  using ThisType = LocalAdvectionDgInverseMassOperator;
+  using BaseType = LocalElementOperatorInterface<SV, SGV, m, 1, SF, m, 1, RF, RGV, RV>;
+
+public:
+  using typename BaseType::LocalRangeType;
+
+  using LocalMassMatrixProviderType = LocalMassMatrixProvider<RGV, m, 1, RF>;
+
+  LocalAdvectionDgInverseMassOperator(const LocalMassMatrixProviderType& local_mass_matrices)
+    : BaseType(0)
+    , local_mass_matrices_(local_mass_matrices)
+  {}
+
+  LocalAdvectionDgInverseMassOperator(const ThisType& other)
+    : BaseType(other)
+    , local_mass_matrices_(other.local_mass_matrices_)
+  {}
+
+  std::unique_ptr<BaseType> copy() const override final
+  {
+    return std::make_unique<ThisType>(*this);
+  }
+
+  bool linear() const override final
+  {
+    return true;
+  }
+
+  void apply(LocalRangeType& local_range, const XT::Common::Parameter& /*param*/ = {}) const override final
+  {
+    auto& range_dofs = local_range.dofs();
+    local_dofs_.resize(range_dofs.size());
+    for (size_t ii = 0; ii < range_dofs.size(); ++ii)
+      local_dofs_[ii] = range_dofs.get_entry(ii);
+    local_mass_matrices_.access().apply_inverse(local_range.element(), local_dofs_);
+    for (size_t ii = 0; ii < range_dofs.size(); ++ii)
+      range_dofs.set_entry(ii, local_dofs_[ii]);
+  } // ... apply(...)
+
+private:
+  const XT::Common::ConstStorageProvider<LocalMassMatrixProviderType> local_mass_matrices_;
+  mutable XT::LA::CommonDenseVector<RF> local_dofs_;
+}; // class LocalAdvectionDgInverseMassOperator
+
+
 } // namespace GDT
 } // namespace Dune
 
@@ -79,6 +79,11 @@ public:
       LocalAdvectionDgBoundaryTreatmentByCustomNumericalFluxOperator<I, V, SGV, m, F, F, RGV, V>;
   using BoundaryTreatmentByCustomExtrapolationOperatorType =
       LocalAdvectionDgBoundaryTreatmentByCustomExtrapolationOperator<I, V, SGV, m, F, F, RGV, V>;
+  using VolumeOperatorType = LocalAdvectionDgVolumeOperator<V, SGV, m, F, F, RGV, V>;
+  using CouplingOperatorType = LocalAdvectionDgCouplingOperator<I, V, SGV, m, F, F, RGV, V>;
+  using ArtificialViscosityOperatorType =
+      LocalAdvectionDgArtificialViscosityShockCapturingOperator<V, SGV, m, F, F, RGV, V>;
+  using InverseMassOperatorType = LocalAdvectionDgInverseMassOperator<V, SGV, m, F, F, RGV, V>;
 
   using typename BaseType::MatrixOperatorType;
   using typename BaseType::RangeFunctionType;
@@ -86,6 +91,12 @@ public:
   using typename BaseType::SourceSpaceType;
   using typename BaseType::VectorType;
 
+  /**
+   * If fuse_inverse_mass_application is true, the local operators only compute the raw volume and face contributions
+   * and the inverse of the local mass matrix is applied once per element to their sum (in a second grid walk, see
+   * LocalizableOperator::append_finalization), instead of once per local operator and element. Only
+   * "colored-finite-differences" jacobians are available in this mode.
+   */
   AdvectionDgOperator(
       const SGV& assembly_grid_view,
       const NumericalFluxType& numerical_flux,
@@ -94,7 +105,8 @@ public:
       const XT::Grid::IntersectionFilter<SGV>& periodicity_exception = XT::Grid::ApplyOn::NoIntersections<SGV>(),
       const double& artificial_viscosity_nu_1 = advection_dg_artificial_viscosity_default_nu_1(),
       const double& artificial_viscosity_alpha_1 = advection_dg_artificial_viscosity_default_alpha_1(),
-      const size_t artificial_viscosity_component = advection_dg_artificial_viscosity_default_component())
+      const size_t artificial_viscosity_component = advection_dg_artificial_viscosity_default_component(),
+      const bool fuse_inverse_mass_application = false)
     : BaseType(assembly_grid_view, source_space, range_space)
     , numerical_flux_(numerical_flux.copy())
     , periodicity_exception_(periodicity_exception.copy())
@@ -102,29 +114,40 @@ public:
     , artificial_viscosity_nu_1_(artificial_viscosity_nu_1)
     , artificial_viscosity_alpha_1_(artificial_viscosity_alpha_1)
     , artificial_viscosity_component_(artificial_viscosity_component)
+    , fuse_inverse_mass_application_(fuse_inverse_mass_application)
   {
     // we assemble these once, to be used in each apply later on
     auto walker = XT::Grid::make_walker(assembly_grid_view);
     walker.append(local_mass_matrix_provider_);
     walker.walk(/*use_tbb=*/true);
     // element contributions
-    this->append(
-        LocalAdvectionDgVolumeOperator<V, SGV, m, F, F, RGV, V>(local_mass_matrix_provider_, numerical_flux_->flux()));
-    // contributions from inner intersections
-    this->append(LocalAdvectionDgCouplingOperator<I, V, SGV, m, F, F, RGV, V>(
-                     local_mass_matrix_provider_, *numerical_flux_, /*compute_outside=*/false),
-                 XT::Grid::ApplyOn::InnerIntersections<SGV>());
-    // contributions from periodic boundaries
-    this->append(LocalAdvectionDgCouplingOperator<I, V, SGV, m, F, F, RGV, V>(
-                     local_mass_matrix_provider_, *numerical_flux_, /*compute_outside=*/false),
+    if (fuse_inverse_mass_application_)
+      this->append(VolumeOperatorType(numerical_flux_->flux()));
+    else
+      this->append(VolumeOperatorType(local_mass_matrix_provider_, numerical_flux_->flux()));
+    // contributions from inner intersections and periodic boundaries
+    const auto coupling_operator =
+        fuse_inverse_mass_application_
+            ? CouplingOperatorType(*numerical_flux_, /*compute_outside=*/false)
+            : CouplingOperatorType(local_mass_matrix_provider_, *numerical_flux_, /*compute_outside=*/false);
+    this->append(coupling_operator, XT::Grid::ApplyOn::InnerIntersections<SGV>());
+    this->append(coupling_operator,
                  *(XT::Grid::ApplyOn::PeriodicBoundaryIntersections<SGV>() && !(*periodicity_exception_)));
     // artificial viscosity by shock capturing [DF2015, Sec. 8.5]
-    this->append(LocalAdvectionDgArtificialViscosityShockCapturingOperator<V, SGV, m, F, F, RGV, V>(
-        local_mass_matrix_provider_,
-        this->assembly_grid_view_,
-        artificial_viscosity_nu_1_,
-        artificial_viscosity_alpha_1_,
-        artificial_viscosity_component_));
+    if (fuse_inverse_mass_application_)
+      this->append(ArtificialViscosityOperatorType(this->assembly_grid_view_,
+                                                   artificial_viscosity_nu_1_,
+                                                   artificial_viscosity_alpha_1_,
+                                                   artificial_viscosity_component_));
+    else
+      this->append(ArtificialViscosityOperatorType(local_mass_matrix_provider_,
+                                                   this->assembly_grid_view_,
+                                                   artificial_viscosity_nu_1_,
+                                                   artificial_viscosity_alpha_1_,
+                                                   artificial_viscosity_component_));
+    // the inverse local mass matrix, once per element, after all contributions have been computed
+    if (fuse_inverse_mass_application_)
+      this->append_finalization(InverseMassOperatorType(local_mass_matrix_provider_));
   } // AdvectionDgOperator(...)
 
   AdvectionDgOperator(ThisType&& source) = default;
@@ -140,11 +163,17 @@ public:
          const XT::Common::ParameterType& boundary_treatment_parameter_type = {},
          const XT::Grid::IntersectionFilter<SGV>& filter = XT::Grid::ApplyOn::BoundaryIntersections<SGV>())
   {
-    this->append(BoundaryTreatmentByCustomNumericalFluxOperatorType(local_mass_matrix_provider_,
-                                                                    numerical_boundary_treatment_flux,
-                                                                    numerical_boundary_treatment_flux_order,
-                                                                    boundary_treatment_parameter_type),
-                 filter.copy());
+    if (fuse_inverse_mass_application_)
+      this->append(BoundaryTreatmentByCustomNumericalFluxOperatorType(numerical_boundary_treatment_flux,
+                                                                      numerical_boundary_treatment_flux_order,
+                                                                      boundary_treatment_parameter_type),
+                   filter);
+    else
+      this->append(BoundaryTreatmentByCustomNumericalFluxOperatorType(local_mass_matrix_provider_,
+                                                                      numerical_boundary_treatment_flux,
+                                                                      numerical_boundary_treatment_flux_order,
+                                                                      boundary_treatment_parameter_type),
+                   filter);
     return *this;
   } // ... append(...)
 
@@ -152,9 +181,14 @@ public:
                    const XT::Common::ParameterType& extrapolation_parameter_type = {},
                    const XT::Grid::IntersectionFilter<SGV>& filter = XT::Grid::ApplyOn::BoundaryIntersections<SGV>())
   {
-    this->append(BoundaryTreatmentByCustomExtrapolationOperatorType(
-                     local_mass_matrix_provider_, *numerical_flux_, extrapolation, extrapolation_parameter_type),
-                 filter.copy());
+    if (fuse_inverse_mass_application_)
+      this->append(BoundaryTreatmentByCustomExtrapolationOperatorType(
+                       *numerical_flux_, extrapolation, extrapolation_parameter_type),
+                   filter);
+    else
+      this->append(BoundaryTreatmentByCustomExtrapolationOperatorType(
+                       local_mass_matrix_provider_, *numerical_flux_, extrapolation, extrapolation_parameter_type),
+                   filter);
     return *this;
   }
 
@@ -167,6 +201,7 @@ protected:
   const double artificial_viscosity_nu_1_;
   const double artificial_viscosity_alpha_1_;
   const size_t artificial_viscosity_component_;
+  const bool fuse_inverse_mass_application_;
 }; // class AdvectionDgOperator
 
 
@@ -180,7 +215,8 @@ make_advection_dg_operator(
     const XT::Grid::IntersectionFilter<AGV>& periodicity_exception = XT::Grid::ApplyOn::NoIntersections<AGV>(),
     const double& artificial_viscosity_nu_1 = advection_dg_artificial_viscosity_default_nu_1(),
     const double& artificial_viscosity_alpha_1 = advection_dg_artificial_viscosity_default_alpha_1(),
-    const size_t artificial_viscosity_component = advection_dg_artificial_viscosity_default_component())
+    const size_t artificial_viscosity_component = advection_dg_artificial_viscosity_default_component(),
+    const bool fuse_inverse_mass_application = false)
 {
   return AdvectionDgOperator<MatrixType, AGV, m, RGV, SGV>(assembly_grid_view,
                                                            numerical_flux,
@@ -189,7 +225,8 @@ make_advection_dg_operator(
                                                            periodicity_exception,
                                                            artificial_viscosity_nu_1,
                                                            artificial_viscosity_alpha_1,
-                                                           artificial_viscosity_component);
+                                                           artificial_viscosity_component,
+                                                           fuse_inverse_mass_application);
 }
 
 
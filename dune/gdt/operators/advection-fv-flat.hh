@@ -0,0 +1,294 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#ifndef DUNE_GDT_OPERATORS_ADVECTION_FV_FLAT_HH
+#define DUNE_GDT_OPERATORS_ADVECTION_FV_FLAT_HH
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/xt/grid/filters.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/la/type_traits.hh>
+
+#include <dune/gdt/local/numerical-fluxes/interface.hh>
+#include <dune/gdt/local/operators/advection-fv.hh>
+#include <dune/gdt/tools/finite-volume-face-data.hh>
+#include <dune/gdt/tools/parallel-for.hh>
+
+#include "interfaces.hh"
+#include "localizable-operator.hh"
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief The finite volume advection operator of AdvectionFvOperator, working on flat arrays only.
+ *
+ * Upon construction, the geometric data of all faces (see FiniteVolumeFaceData) and a cell-to-face connectivity table
+ * (in compressed row storage) are computed. Each application then
+ * - evaluates the numerical flux for all faces, batch-wise (see NumericalFluxInterface::apply_batch), reading the cell
+ *   values directly from the source vector, and
+ * - computes the value of each cell by summing up the (scaled) fluxes of its faces,
+ * without any grid iteration or binding of local functions. Both loops are free of write conflicts and run in
+ * parallel if use_tbb is true. Boundary treatments (see append()) are applied afterwards, in a grid walk over the
+ * elements at the (non-periodic) boundary only. As for AdvectionFvOperator, boundary intersections do not contribute
+ * if no boundary treatment is appended.
+ *
+ * Requires finite volume source and range spaces on the grid view of the operator and an x-independent numerical flux.
+ * AdvectionFvOperator remains the reference implementation (and is required for jacobians).
+ *
+ * \note The connectivity is only valid as long as the grid does not change.
+ *
+ * \sa AdvectionFvOperator
+ */
+template <class M, class GV, size_t m = 1>
+class AdvectionFvFlatOperator : public OperatorInterface<M, GV, m, 1, m, 1, GV>
+{
+  using ThisType = AdvectionFvFlatOperator;
+  using BaseType = OperatorInterface<M, GV, m, 1, m, 1, GV>;
+
+public:
+  using typename BaseType::F;
+  using typename BaseType::RangeSpaceType;
+  using typename BaseType::SourceSpaceType;
+  using typename BaseType::V;
+  using typename BaseType::VectorType;
+
+  using E = XT::Grid::extract_entity_t<GV>;
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using D = typename GV::ctype;
+  static constexpr size_t d = GV::dimension;
+  using NumericalFluxType = NumericalFluxInterface<I, d, m, F>;
+  using BoundaryTreatmentByCustomNumericalFluxOperatorType =
+      LocalAdvectionFvBoundaryTreatmentByCustomNumericalFluxOperator<I, V, GV, m, F, F, GV, V>;
+  using BoundaryTreatmentByCustomExtrapolationOperatorType =
+      LocalAdvectionFvBoundaryTreatmentByCustomExtrapolationOperator<I, V, GV, m, F, F, GV, V>;
+
+  AdvectionFvFlatOperator(const GV& grid_view,
+                          const NumericalFluxType& numerical_flux,
+                          const SourceSpaceType& source_space,
+                          const RangeSpaceType& range_space,
+                          const bool use_tbb = false,
+                          const size_t face_batch_size = 256)
+    : BaseType(numerical_flux.parameter_type())
+    , grid_view_(grid_view)
+    , numerical_flux_(numerical_flux.copy())
+    , source_space_(source_space)
+    , range_space_(range_space)
+    , use_tbb_(use_tbb)
+    , face_batch_size_(face_batch_size)
+    , boundary_op_(grid_view_, source_space_, range_space_, use_tbb_)
+    , has_boundary_treatment_(false)
+  {
+    DUNE_THROW_IF(source_space_.type() != SpaceType::finite_volume || range_space_.type() != SpaceType::finite_volume,
+                  Exceptions::operator_error,
+                  "Only available for finite volume spaces!");
+    DUNE_THROW_IF(numerical_flux_->x_dependent(),
+                  Exceptions::operator_error,
+                  "Not available for x-dependent numerical fluxes!");
+    DUNE_THROW_IF(face_batch_size_ == 0, Exceptions::operator_error, "face_batch_size = 0");
+    // the elements at the (non-periodic) boundary, and one face to bind the numerical flux copies to (any will do,
+    // since the flux is x-independent)
+    for (auto&& element : elements(grid_view_)) {
+      bool at_boundary = false;
+      for (auto&& intersection : intersections(grid_view_, element)) {
+        if (!intersection.neighbor())
+          at_boundary = true;
+        else if (!some_intersection_)
+          some_intersection_ = std::make_unique<I>(intersection);
+      }
+      if (at_boundary)
+        boundary_elements_.push_back(element);
+    }
+    const auto face_filter =
+        XT::Grid::ApplyOn::InnerIntersectionsOnce<GV>() || XT::Grid::ApplyOn::PeriodicBoundaryIntersectionsOnce<GV>();
+    face_data_ = std::make_unique<FiniteVolumeFaceData<GV>>(grid_view_, *face_filter);
+    const size_t num_cells = face_data_->num_cells();
+    DUNE_THROW_IF(num_cells * m != source_space_.mapper().size() || num_cells * m != range_space_.mapper().size(),
+                  Exceptions::operator_error,
+                  "The spaces have to be defined on the grid view of the operator!");
+    // the faces of each cell, with the factor of their flux: +/- |face| / |cell|
+    const auto& inside_cells = face_data_->inside_cells();
+    const auto& outside_cells = face_data_->outside_cells();
+    const auto& face_volumes = face_data_->face_volumes();
+    const auto& inverse_cell_volumes = face_data_->inverse_cell_volumes();
+    const size_t num_faces = face_data_->num_faces();
+    cell_offsets_.assign(num_cells + 1, 0);
+    for (size_t ff = 0; ff < num_faces; ++ff) {
+      ++cell_offsets_[inside_cells[ff] + 1];
+      ++cell_offsets_[outside_cells[ff] + 1];
+    }
+    for (size_t kk = 0; kk < num_cells; ++kk)
+      cell_offsets_[kk + 1] += cell_offsets_[kk];
+    cell_faces_.resize(cell_offsets_[num_cells]);
+    cell_face_factors_.resize(cell_offsets_[num_cells]);
+    std::vector<size_t> fill(cell_offsets_.begin(), cell_offsets_.end() - 1);
+    for (size_t ff = 0; ff < num_faces; ++ff) {
+      cell_faces_[fill[inside_cells[ff]]] = ff;
+      cell_face_factors_[fill[inside_cells[ff]]++] = face_volumes[ff] * inverse_cell_volumes[inside_cells[ff]];
+      cell_faces_[fill[outside_cells[ff]]] = ff;
+      cell_face_factors_[fill[outside_cells[ff]]++] = -face_volumes[ff] * inverse_cell_volumes[outside_cells[ff]];
+    }
+  } // AdvectionFvFlatOperator(...)
+
+  AdvectionFvFlatOperator(ThisType&& source) = default;
+
+  bool linear() const override final
+  {
+    return numerical_flux_->linear();
+  }
+
+  const SourceSpaceType& source_space() const override final
+  {
+    return source_space_;
+  }
+
+  const RangeSpaceType& range_space() const override final
+  {
+    return range_space_;
+  }
+
+  /// \name Boundary treatments, applied in a grid walk over the elements at the boundary (see AdvectionFvOperator)
+  /// \{
+
+  ThisType&
+  append(typename BoundaryTreatmentByCustomNumericalFluxOperatorType::LambdaType numerical_boundary_treatment_flux,
+         const XT::Common::ParameterType& boundary_treatment_parameter_type = {},
+         const XT::Grid::IntersectionFilter<GV>& filter = XT::Grid::ApplyOn::BoundaryIntersections<GV>())
+  {
+    boundary_op_.append(BoundaryTreatmentByCustomNumericalFluxOperatorType(numerical_boundary_treatment_flux,
+                                                                           boundary_treatment_parameter_type),
+                        filter);
+    this->extend_parameter_type(boundary_op_.parameter_type());
+    has_boundary_treatment_ = true;
+    return *this;
+  }
+
+  ThisType& append(typename BoundaryTreatmentByCustomExtrapolationOperatorType::LambdaType extrapolation,
+                   const XT::Common::ParameterType& extrapolation_parameter_type = {},
+                   const XT::Grid::IntersectionFilter<GV>& filter = XT::Grid::ApplyOn::BoundaryIntersections<GV>())
+  {
+    boundary_op_.append(BoundaryTreatmentByCustomExtrapolationOperatorType(
+                            *numerical_flux_, extrapolation, extrapolation_parameter_type),
+                        filter);
+    this->extend_parameter_type(boundary_op_.parameter_type());
+    has_boundary_treatment_ = true;
+    return *this;
+  }
+
+  /// \}
+
+  using BaseType::apply;
+
+  void apply(const VectorType& source, VectorType& range, const XT::Common::Parameter& param = {}) const override final
+  {
+    DUNE_THROW_IF(!source.valid(), Exceptions::operator_error, "source contains inf or nan!");
+    DUNE_THROW_IF(source.size() != source_space_.mapper().size() || range.size() != range_space_.mapper().size(),
+                  Exceptions::operator_error,
+                  "source.size() = " << source.size() << "\n   range.size() = " << range.size());
+    const auto& face_data = *face_data_;
+    const size_t num_faces = face_data.num_faces();
+    const auto& inside_cells = face_data.inside_cells();
+    const auto& outside_cells = face_data.outside_cells();
+    const auto* normals = face_data.normals().data();
+    // the states and fluxes of all faces, in the same layout as the normals (local, so that apply() is reentrant)
+    std::vector<F> face_u(m * num_faces);
+    std::vector<F> face_v(m * num_faces);
+    std::vector<F> face_g(m * num_faces);
+    parallel_for_chunks(
+        0,
+        num_faces,
+        [&](const size_t first, const size_t last) {
+          auto numerical_flux = numerical_flux_->copy();
+          numerical_flux->bind(*some_intersection_);
+          for (size_t begin = first; begin < last; begin += face_batch_size_) {
+            const size_t end = std::min(last, begin + face_batch_size_);
+            for (size_t ii = 0; ii < m; ++ii)
+              for (size_t ff = begin; ff < end; ++ff) {
+                face_u[ii * num_faces + ff] = source.get_entry(inside_cells[ff] * m + ii);
+                face_v[ii * num_faces + ff] = source.get_entry(outside_cells[ff] * m + ii);
+              }
+            numerical_flux->apply_batch(end - begin,
+                                        num_faces,
+                                        face_u.data() + begin,
+                                        face_v.data() + begin,
+                                        normals + begin,
+                                        face_g.data() + begin,
+                                        param);
+          }
+        },
+        use_tbb_);
+    // each cell only writes its own DoFs (after a serial write, which triggers the copy of shared data, if any)
+    if (use_tbb_)
+      ensure_unshared_data(range);
+    parallel_for_chunks(
+        0,
+        face_data.num_cells(),
+        [&](const size_t first, const size_t last) {
+          for (size_t kk = first; kk < last; ++kk)
+            for (size_t ii = 0; ii < m; ++ii) {
+              F value = 0.;
+              for (size_t jj = cell_offsets_[kk]; jj < cell_offsets_[kk + 1]; ++jj)
+                value += cell_face_factors_[jj] * face_g[ii * num_faces + cell_faces_[jj]];
+              range.set_entry(kk * m + ii, value);
+            }
+        },
+        use_tbb_);
+    if (has_boundary_treatment_)
+      boundary_op_.apply_range(source, range, param, boundary_elements_, /*clear_range=*/false);
+    DEBUG_THROW_IF(!range.valid(), Exceptions::operator_error, "range contains inf or nan!");
+  } // ... apply(...)
+
+  const NumericalFluxType& numerical_flux() const
+  {
+    return *numerical_flux_;
+  }
+
+private:
+  const GV grid_view_;
+  std::unique_ptr<const NumericalFluxType> numerical_flux_;
+  const SourceSpaceType& source_space_;
+  const RangeSpaceType& range_space_;
+  const bool use_tbb_;
+  const size_t face_batch_size_;
+  LocalizableOperator<M, GV, m, 1, m, 1, GV> boundary_op_;
+  bool has_boundary_treatment_;
+  std::unique_ptr<I> some_intersection_;
+  std::vector<E> boundary_elements_;
+  std::unique_ptr<const FiniteVolumeFaceData<GV>> face_data_;
+  std::vector<size_t> cell_offsets_;
+  std::vector<size_t> cell_faces_;
+  std::vector<F> cell_face_factors_;
+}; // class AdvectionFvFlatOperator
+
+
+template <class MatrixType, class GV, size_t m, class F>
+std::enable_if_t<XT::LA::is_matrix<MatrixType>::value, AdvectionFvFlatOperator<MatrixType, GV, m>>
+make_advection_fv_flat_operator(
+    const GV& grid_view,
+    const NumericalFluxInterface<XT::Grid::extract_intersection_t<GV>, GV::dimension, m, F>& numerical_flux,
+    const SpaceInterface<GV, m, 1, F>& source_space,
+    const SpaceInterface<GV, m, 1, F>& range_space,
+    const bool use_tbb = false,
+    const size_t face_batch_size = 256)
+{
+  return AdvectionFvFlatOperator<MatrixType, GV, m>(
+      grid_view, numerical_flux, source_space, range_space, use_tbb, face_batch_size);
+}
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_OPERATORS_ADVECTION_FV_FLAT_HH
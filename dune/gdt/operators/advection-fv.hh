@@ -12,15 +12,23 @@
 #ifndef DUNE_GDT_OPERATORS_ADVECTION_FV_HH
 #define DUNE_GDT_OPERATORS_ADVECTION_FV_HH
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <dune/grid/common/partitionset.hh>
 
 #include <dune/xt/common/type_traits.hh>
 #include <dune/xt/grid/type_traits.hh>
 #include <dune/xt/grid/filters.hh>
+#include <dune/xt/grid/walker.hh>
 #include <dune/xt/la/container.hh>
 
 #include <dune/gdt/local/assembler/operator-fd-jacobian-assemblers.hh>
 #include <dune/gdt/local/operators/advection-fv.hh>
+#include <dune/gdt/tools/finite-volume-face-data.hh>
+#include <dune/gdt/tools/parallel-for.hh>
 
 #include "interfaces.hh"
 #include "localizable-operator.hh"
@@ -29,7 +37,193 @@ namespace Dune {
 namespace GDT {
 
 
+namespace internal {
+
+
+/**
+ * \brief Evaluates the numerical flux on the coupling intersections of the visited elements in batches (see
+ *        NumericalFluxInterface::apply_batch), used by AdvectionFvOperator in the face-batched mode.
+ *
+ * If visit_once is true, the filter is expected to contain each intersection once and its flux is added to the inside
+ * and the outside DoFs. Otherwise, each intersection is visited from both sides and its flux is only added to the DoFs
+ * of the visited element, so that disjoint sets of elements may be walked concurrently (at the price of evaluating the
+ * flux twice).
+ *
+ * \note The numerical flux has to be x-independent and the spaces have to be finite volume spaces.
+ */
+template <class SGV, size_t m, class V, class F, class RGV = SGV>
+class AdvectionFvCouplingInFaceBatchesFunctor : public XT::Grid::ElementFunctor<SGV>
+{
+  using ThisType = AdvectionFvCouplingInFaceBatchesFunctor;
+  using BaseType = XT::Grid::ElementFunctor<SGV>;
+  static constexpr size_t d = SGV::dimension;
+
+public:
+  using typename BaseType::E;
+  using I = XT::Grid::extract_intersection_t<SGV>;
+  using NumericalFluxType = NumericalFluxInterface<I, d, m, F>;
+  using SourceMapperType = MapperInterface<SGV>;
+  using RangeMapperType = MapperInterface<RGV>;
+
+  AdvectionFvCouplingInFaceBatchesFunctor(const SGV& grid_view,
+                                          const NumericalFluxType& numerical_flux,
+                                          const XT::Grid::IntersectionFilter<SGV>& filter,
+                                          const V& source,
+                                          V& range,
+                                          const SourceMapperType& source_mapper,
+                                          const RangeMapperType& range_mapper,
+                                          const XT::Common::Parameter& param,
+                                          const size_t batch_size,
+                                          const bool visit_once)
+    : BaseType()
+    , grid_view_(grid_view)
+    , numerical_flux_(numerical_flux.copy())
+    , filter_(filter)
+    , source_(source)
+    , range_(range)
+    , source_mapper_(source_mapper)
+    , range_mapper_(range_mapper)
+    , param_(param)
+    , batch_size_(batch_size)
+    , visit_once_(visit_once)
+    , numerical_flux_is_bound_(false)
+    , num_faces_(0)
+    , u_(m * batch_size_)
+    , v_(m * batch_size_)
+    , g_(m * batch_size_)
+    , n_(d * batch_size_)
+    , inside_dofs_(batch_size_)
+    , outside_dofs_(batch_size_)
+    , inside_factors_(batch_size_)
+    , outside_factors_(batch_size_)
+  {}
+
+  AdvectionFvCouplingInFaceBatchesFunctor(const ThisType& other)
+    : BaseType(other)
+    , grid_view_(other.grid_view_)
+    , numerical_flux_(other.numerical_flux_->copy())
+    , filter_(other.filter_)
+    , source_(other.source_)
+    , range_(other.range_)
+    , source_mapper_(other.source_mapper_)
+    , range_mapper_(other.range_mapper_)
+    , param_(other.param_)
+    , batch_size_(other.batch_size_)
+    , visit_once_(other.visit_once_)
+    , numerical_flux_is_bound_(false)
+    , num_faces_(0)
+    , u_(m * batch_size_)
+    , v_(m * batch_size_)
+    , g_(m * batch_size_)
+    , n_(d * batch_size_)
+    , inside_dofs_(batch_size_)
+    , outside_dofs_(batch_size_)
+    , inside_factors_(batch_size_)
+    , outside_factors_(batch_size_)
+  {}
+
+  BaseType* copy() override final
+  {
+    return new ThisType(*this);
+  }
+
+  void apply_local(const E& element) override final
+  {
+    // the DoFs of an element are contiguous in finite volume spaces
+    for (auto&& intersection : intersections(grid_view_, element)) {
+      if (!filter_.contains(grid_view_, intersection))
+        continue;
+      if (!numerical_flux_is_bound_) {
+        // the flux is x-independent, so one copy bound to any intersection serves all batches
+        numerical_flux_->bind(intersection);
+        numerical_flux_is_bound_ = true;
+      }
+      const auto outside_element = intersection.outside();
+      const size_t u_dofs = source_mapper_.global_index(element, 0);
+      const size_t v_dofs = source_mapper_.global_index(outside_element, 0);
+      for (size_t ii = 0; ii < m; ++ii) {
+        u_[ii * batch_size_ + num_faces_] = source_.get_entry(u_dofs + ii);
+        v_[ii * batch_size_ + num_faces_] = source_.get_entry(v_dofs + ii);
+      }
+      const auto normal = intersection.centerUnitOuterNormal();
+      for (size_t dd = 0; dd < d; ++dd)
+        n_[dd * batch_size_ + num_faces_] = normal[dd];
+      const auto h_intersection = intersection.geometry().volume();
+      inside_dofs_[num_faces_] = range_mapper_.global_index(element, 0);
+      inside_factors_[num_faces_] = h_intersection / element.geometry().volume();
+      if (visit_once_) {
+        outside_dofs_[num_faces_] = range_mapper_.global_index(outside_element, 0);
+        outside_factors_[num_faces_] = h_intersection / outside_element.geometry().volume();
+      }
+      if (++num_faces_ == batch_size_)
+        this->apply_batch();
+    }
+  } // ... apply_local(...)
+
+  void finalize() override final
+  {
+    if (num_faces_ > 0)
+      this->apply_batch();
+  }
+
+private:
+  void apply_batch()
+  {
+    numerical_flux_->apply_batch(num_faces_, batch_size_, u_.data(), v_.data(), n_.data(), g_.data(), param_);
+    for (size_t ff = 0; ff < num_faces_; ++ff)
+      for (size_t ii = 0; ii < m; ++ii) {
+        const auto g_ii = g_[ii * batch_size_ + ff];
+        range_.add_to_entry(inside_dofs_[ff] + ii, g_ii * inside_factors_[ff]);
+        if (visit_once_)
+          range_.add_to_entry(outside_dofs_[ff] + ii, -g_ii * outside_factors_[ff]);
+      }
+    num_faces_ = 0;
+  } // ... apply_batch(...)
+
+  const SGV grid_view_;
+  std::unique_ptr<NumericalFluxType> numerical_flux_;
+  const XT::Grid::IntersectionFilter<SGV>& filter_;
+  const V& source_;
+  V& range_;
+  const SourceMapperType& source_mapper_;
+  const RangeMapperType& range_mapper_;
+  const XT::Common::Parameter& param_;
+  const size_t batch_size_;
+  const bool visit_once_;
+  bool numerical_flux_is_bound_;
+  size_t num_faces_;
+  // the batch, in structure-of-arrays layout (see NumericalFluxInterface::apply_batch)
+  std::vector<F> u_;
+  std::vector<F> v_;
+  std::vector<F> g_;
+  std::vector<typename SGV::ctype> n_;
+  std::vector<size_t> inside_dofs_;
+  std::vector<size_t> outside_dofs_;
+  std::vector<F> inside_factors_;
+  std::vector<F> outside_factors_;
+}; // class AdvectionFvCouplingInFaceBatchesFunctor
+
+
+} // namespace internal
+
+
 /**
+ * If face_batch_size is positive, the contributions of inner (and periodic) intersections are not computed by local
+ * operators in the grid walk, but in a separate traversal which collects batches of face_batch_size intersections and
+ * evaluates the numerical flux for each batch at once (see NumericalFluxInterface::apply_batch). This requires finite
+ * volume source and range spaces and an x-independent numerical flux, and is only available in apply() and
+ * apply_range() with a DoF vector (or a discrete function) as source. If use_tbb is true, the elements are walked
+ * concurrently, each of them only adding the fluxes of its own intersections (see
+ * internal::AdvectionFvCouplingInFaceBatchesFunctor).
+ *
+ * If, in addition, cache_face_data is true, the geometric data of these intersections is computed once (see
+ * FiniteVolumeFaceData) and the traversal runs over these flat arrays only, without any grid iteration (if no other
+ * local operators are appended, e.g. for boundary treatment, the grid walk is skipped entirely). The data is computed
+ * upon construction and recomputed if the number of elements changes, any other change of the grid requires a new
+ * operator. The traversal of the face data is sequential (use_tbb only applies to the grid walk over the appended local
+ * operators) and concurrent calls of apply() are serialized, since they share the face data, the bound numerical flux
+ * and the buffers for the states and fluxes of all faces.
+ *
  * \attention This operator will not work on a grid view with hanging nodes.
  *
  * \todo Refactor the coupling op as in the DG case to be applied on each side individually.
@@ -60,6 +254,7 @@ public:
 
   using typename BaseType::MatrixOperatorType;
   using typename BaseType::RangeSpaceType;
+  using typename BaseType::SourceFunctionInterfaceType;
   using typename BaseType::SourceSpaceType;
   using typename BaseType::VectorType;
 
@@ -69,11 +264,39 @@ public:
       const SourceSpaceType& source_space,
       const RangeSpaceType& range_space,
       const bool use_tbb = false,
-      const XT::Grid::IntersectionFilter<SGV>& periodicity_exception = XT::Grid::ApplyOn::NoIntersections<SGV>())
+      const XT::Grid::IntersectionFilter<SGV>& periodicity_exception = XT::Grid::ApplyOn::NoIntersections<SGV>(),
+      const size_t face_batch_size = 0,
+      const bool cache_face_data = false)
     : BaseType(assembly_grid_view, source_space, range_space, use_tbb)
     , numerical_flux_(numerical_flux.copy())
     , periodicity_exception_(periodicity_exception.copy())
+    , face_batch_size_(face_batch_size)
+    , cache_face_data_(cache_face_data)
   {
+    DUNE_THROW_IF(cache_face_data_ && face_batch_size_ == 0,
+                  Exceptions::operator_error,
+                  "The face data cache requires the face-batched mode (face_batch_size > 0)!");
+    if (face_batch_size_ > 0) {
+      DUNE_THROW_IF(source_space.type() != SpaceType::finite_volume || range_space.type() != SpaceType::finite_volume,
+                    Exceptions::operator_error,
+                    "The face-batched mode requires finite volume spaces!");
+      DUNE_THROW_IF(numerical_flux_->x_dependent(),
+                    Exceptions::operator_error,
+                    "The face-batched mode is not available for x-dependent numerical fluxes!");
+      // contributions from inner intersections and periodic boundaries, see apply_coupling_in_face_batches()
+      coupling_filter_ = std::unique_ptr<XT::Grid::IntersectionFilter<SGV>>(
+          (*(XT::Grid::ApplyOn::InnerIntersectionsOnce<SGV>()
+             || *(XT::Grid::ApplyOn::PeriodicBoundaryIntersectionsOnce<SGV>() && !(*periodicity_exception_))))
+              .copy());
+      // the same intersections, visited from both sides
+      two_sided_coupling_filter_ = std::unique_ptr<XT::Grid::IntersectionFilter<SGV>>(
+          (*(XT::Grid::ApplyOn::InnerIntersections<SGV>()
+             || *(XT::Grid::ApplyOn::PeriodicBoundaryIntersections<SGV>() && !(*periodicity_exception_))))
+              .copy());
+      if (cache_face_data_)
+        this->update_face_data();
+      return;
+    }
     // contributions from inner intersections
     this->append(LocalAdvectionFvCouplingOperator<I, V, SGV, m, F, F, RGV, V>(*numerical_flux_),
                  XT::Grid::ApplyOn::InnerIntersectionsOnce<SGV>());
@@ -86,9 +309,119 @@ public:
     : BaseType(std::move(source))
     , numerical_flux_(std::move(source.numerical_flux_))
     , periodicity_exception_(std::move(source.periodicity_exception_))
+    , face_batch_size_(source.face_batch_size_)
+    , cache_face_data_(source.cache_face_data_)
+    , coupling_filter_(std::move(source.coupling_filter_))
+    , two_sided_coupling_filter_(std::move(source.two_sided_coupling_filter_))
+    , face_data_mutex_()
+    , face_data_(std::move(source.face_data_))
+    , face_data_numerical_flux_(std::move(source.face_data_numerical_flux_))
+    , face_u_(std::move(source.face_u_))
+    , face_v_(std::move(source.face_v_))
+    , face_g_(std::move(source.face_g_))
   {}
 
   using BaseType::append;
+  using BaseType::apply;
+  using BaseType::jacobian_options;
+
+  void apply(const VectorType& source, VectorType& range, const XT::Common::Parameter& param = {}) const override final
+  {
+    if (face_batch_size_ == 0) {
+      BaseType::apply(source, range, param);
+      return;
+    }
+    // skip the grid walk if there is nothing to walk for
+    if (this->local_element_operators_.empty() && this->local_intersection_operators_.empty()
+        && this->local_element_finalizations_.empty()) {
+      DUNE_THROW_IF(!source.valid(), Exceptions::operator_error, "source contains inf or nan!");
+      range.set_all(0);
+    } else
+      BaseType::apply(source, range, param);
+    if (cache_face_data_)
+      this->apply_coupling_from_face_data(source, range, param);
+    else
+      this->apply_coupling_in_face_batches(source, range, param);
+  } // ... apply(...)
+
+  void apply(const SourceFunctionInterfaceType& source_function,
+             VectorType& range,
+             const XT::Common::Parameter& param = {}) const
+  {
+    DUNE_THROW_IF(face_batch_size_ > 0,
+                  Exceptions::operator_error,
+                  "Only DoF vectors can be applied in the face-batched mode!");
+    BaseType::apply(source_function, range, param);
+  }
+
+  /// \sa LocalizableOperator::apply_range
+  template <class ElementRange>
+  void apply_range(const ConstDiscreteFunction<V, SGV, m, 1, F>& source,
+                   VectorType& range,
+                   const XT::Common::Parameter& param,
+                   const ElementRange& element_range,
+                   const bool clear_range = true) const
+  {
+    if (face_batch_size_ == 0) {
+      BaseType::apply_range(source, range, param, element_range, clear_range);
+      return;
+    }
+    // skip the walk if there is nothing to walk for
+    if (this->local_element_operators_.empty() && this->local_intersection_operators_.empty()
+        && this->local_element_finalizations_.empty()) {
+      if (clear_range)
+        range.set_all(0);
+    } else
+      BaseType::apply_range(source, range, param, element_range, clear_range);
+    // each element only adds the fluxes of its own intersections, since other ranges may be applied separately
+    internal::AdvectionFvCouplingInFaceBatchesFunctor<SGV, m, V, F, RGV> coupling_functor(
+        this->assembly_grid_view_,
+        *numerical_flux_,
+        *two_sided_coupling_filter_,
+        source.dofs().vector(),
+        range,
+        this->source_space_.mapper(),
+        this->range_space_.mapper(),
+        param,
+        face_batch_size_,
+        /*visit_once=*/false);
+    coupling_functor.prepare();
+    for (auto&& element : element_range)
+      coupling_functor.apply_local(element);
+    coupling_functor.finalize();
+  } // ... apply_range(...)
+
+  template <class ElementRange>
+  void apply_range(const VectorType& source,
+                   VectorType& range,
+                   const XT::Common::Parameter& param,
+                   const ElementRange& element_range,
+                   const bool clear_range = true) const
+  {
+    DUNE_THROW_IF(!source.valid(), Exceptions::operator_error, "source contains inf or nan!");
+    this->apply_range(make_discrete_function(this->source_space_, source), range, param, element_range, clear_range);
+  }
+
+  template <class ElementRange>
+  void apply_range(const SourceFunctionInterfaceType& source_function,
+                   VectorType& range,
+                   const XT::Common::Parameter& param,
+                   const ElementRange& element_range,
+                   const bool clear_range = true) const
+  {
+    DUNE_THROW_IF(face_batch_size_ > 0,
+                  Exceptions::operator_error,
+                  "Only discrete functions or DoF vectors can be applied in the face-batched mode!");
+    BaseType::apply_range(source_function, range, param, element_range, clear_range);
+  }
+
+  /// \note Only "colored-finite-differences" jacobians are available in the face-batched mode.
+  std::vector<std::string> jacobian_options() const override final
+  {
+    if (face_batch_size_ > 0)
+      return {"colored-finite-differences"};
+    return BaseType::jacobian_options();
+  }
 
   /// \name Non-periodic boundary treatment
   /// \{
@@ -122,8 +455,105 @@ public:
   /// \}
 
 private:
+  void apply_coupling_in_face_batches(const VectorType& source,
+                                      VectorType& range,
+                                      const XT::Common::Parameter& param) const
+  {
+    // concurrently walked elements may only write to their own DoFs, each intersection is then visited from both sides
+    const bool visit_once = !this->use_tbb_;
+    internal::AdvectionFvCouplingInFaceBatchesFunctor<SGV, m, V, F, RGV> coupling_functor(
+        this->assembly_grid_view_,
+        *numerical_flux_,
+        visit_once ? *coupling_filter_ : *two_sided_coupling_filter_,
+        source,
+        range,
+        this->source_space_.mapper(),
+        this->range_space_.mapper(),
+        param,
+        face_batch_size_,
+        visit_once);
+    if (this->use_tbb_)
+      ensure_unshared_data(range);
+    auto walker = XT::Grid::make_walker(this->assembly_grid_view_);
+    walker.append(coupling_functor);
+    walker.walk(this->use_tbb_);
+  } // ... apply_coupling_in_face_batches(...)
+
+  // requires face_data_mutex_ to be locked (or the operator to be under construction)
+  void update_face_data() const
+  {
+    face_data_ = std::make_unique<FiniteVolumeFaceData<SGV>>(this->assembly_grid_view_, *coupling_filter_);
+    DUNE_THROW_IF(face_data_->num_cells() * m != this->source_space_.mapper().size()
+                      || face_data_->num_cells() * m != this->range_space_.mapper().size(),
+                  Exceptions::operator_error,
+                  "The face data cache requires the spaces to be defined on the assembly grid view!");
+    // the flux is x-independent, so any intersection will do, as long as it has an outside (boundary intersections
+    // do not on non-periodic grids)
+    const size_t num_faces = face_data_->num_faces();
+    face_u_.resize(m * num_faces);
+    face_v_.resize(m * num_faces);
+    face_g_.resize(m * num_faces);
+    face_data_numerical_flux_ = numerical_flux_->copy();
+    for (auto&& element : elements(this->assembly_grid_view_))
+      for (auto&& intersection : intersections(this->assembly_grid_view_, element))
+        if (coupling_filter_->contains(this->assembly_grid_view_, intersection)) {
+          face_data_numerical_flux_->bind(intersection);
+          return;
+        }
+  } // ... update_face_data(...)
+
+  void apply_coupling_from_face_data(const VectorType& source,
+                                     VectorType& range,
+                                     const XT::Common::Parameter& param) const
+  {
+    std::lock_guard<std::mutex> lock(face_data_mutex_);
+    if (face_data_->num_cells() * m != this->source_space_.mapper().size())
+      this->update_face_data();
+    const auto& face_data = *face_data_;
+    const size_t num_faces = face_data.num_faces();
+    const auto& inside_cells = face_data.inside_cells();
+    const auto& outside_cells = face_data.outside_cells();
+    const auto& face_volumes = face_data.face_volumes();
+    const auto& inverse_cell_volumes = face_data.inverse_cell_volumes();
+    for (size_t begin = 0; begin < num_faces; begin += face_batch_size_) {
+      const size_t end = std::min(num_faces, begin + face_batch_size_);
+      for (size_t ii = 0; ii < m; ++ii)
+        for (size_t ff = begin; ff < end; ++ff) {
+          face_u_[ii * num_faces + ff] = source.get_entry(inside_cells[ff] * m + ii);
+          face_v_[ii * num_faces + ff] = source.get_entry(outside_cells[ff] * m + ii);
+        }
+      face_data_numerical_flux_->apply_batch(end - begin,
+                                             num_faces,
+                                             face_u_.data() + begin,
+                                             face_v_.data() + begin,
+                                             face_data.normals().data() + begin,
+                                             face_g_.data() + begin,
+                                             param);
+      for (size_t ff = begin; ff < end; ++ff) {
+        const auto inside_factor = face_volumes[ff] * inverse_cell_volumes[inside_cells[ff]];
+        const auto outside_factor = face_volumes[ff] * inverse_cell_volumes[outside_cells[ff]];
+        for (size_t ii = 0; ii < m; ++ii) {
+          const auto g_ii = face_g_[ii * num_faces + ff];
+          range.add_to_entry(inside_cells[ff] * m + ii, g_ii * inside_factor);
+          range.add_to_entry(outside_cells[ff] * m + ii, -g_ii * outside_factor);
+        }
+      }
+    }
+  } // ... apply_coupling_from_face_data(...)
+
   std::unique_ptr<const NumericalFluxType> numerical_flux_;
   std::unique_ptr<XT::Grid::IntersectionFilter<SGV>> periodicity_exception_;
+  const size_t face_batch_size_;
+  const bool cache_face_data_;
+  std::unique_ptr<XT::Grid::IntersectionFilter<SGV>> coupling_filter_;
+  std::unique_ptr<XT::Grid::IntersectionFilter<SGV>> two_sided_coupling_filter_;
+  mutable std::mutex face_data_mutex_;
+  mutable std::unique_ptr<const FiniteVolumeFaceData<SGV>> face_data_;
+  mutable std::unique_ptr<NumericalFluxType> face_data_numerical_flux_;
+  // the states and fluxes of all faces, in the same layout as the normals
+  mutable std::vector<F> face_u_;
+  mutable std::vector<F> face_v_;
+  mutable std::vector<F> face_g_;
 }; // class AdvectionFvOperator
 
 
@@ -134,10 +564,18 @@ make_advection_fv_operator(
     const NumericalFluxInterface<XT::Grid::extract_intersection_t<AGV>, AGV::dimension, m, F>& numerical_flux,
     const SpaceInterface<SGV, m, 1, F>& source_space,
     const SpaceInterface<RGV, m, 1, F>& range_space,
-    const XT::Grid::IntersectionFilter<AGV>& periodicity_exception = XT::Grid::ApplyOn::NoIntersections<AGV>())
+    const XT::Grid::IntersectionFilter<AGV>& periodicity_exception = XT::Grid::ApplyOn::NoIntersections<AGV>(),
+    const size_t face_batch_size = 0,
+    const bool cache_face_data = false)
 {
-  return AdvectionFvOperator<MatrixType, AGV, m, RGV, SGV>(
-      assembly_grid_view, numerical_flux, source_space, range_space, periodicity_exception);
+  return AdvectionFvOperator<MatrixType, AGV, m, RGV, SGV>(assembly_grid_view,
+                                                           numerical_flux,
+                                                           source_space,
+                                                           range_space,
+                                                           /*use_tbb=*/false,
+                                                           periodicity_exception,
+                                                           face_batch_size,
+                                                           cache_face_data);
 }
 
 
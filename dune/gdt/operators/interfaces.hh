@@ -12,7 +12,10 @@
 #ifndef DUNE_GDT_OPERATORS_INTERFACES_HH
 #define DUNE_GDT_OPERATORS_INTERFACES_HH
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <memory>
 #include <type_traits>
 
 #include <dune/xt/common/parameter.hh>
@@ -28,6 +31,7 @@
 #include <dune/gdt/exceptions.hh>
 #include <dune/gdt/print.hh>
 #include <dune/gdt/spaces/interface.hh>
+#include <dune/gdt/tools/fgmres.hh>
 #include <dune/gdt/tools/sparsity-pattern.hh>
 
 namespace Dune {
@@ -474,7 +478,7 @@ public:
    */
   virtual std::vector<std::string> invert_options() const
   {
-    return {"newton"};
+    return {"newton", "jfnk"};
   }
 
   /**
@@ -485,15 +489,70 @@ invert_options(some_type).get<std::string>("type") == some_type
 \endcode
    * and possibly other key/value pairs.
    *
+   * - "newton": solves for the update with the linear solvers of XT::LA::Solver (starting with the last successful
+   *   one). The jacobian is reassembled every jacobian_lag iterations, and whenever the last update had to be damped
+   *   or the linear solve failed (see also the apply_inverse variant with a NewtonJacobianCache, to keep the jacobian
+   *   for subsequent calls). If forcing is "fixed", the relative precision of the linear solve is 0.1 * precision, if
+   *   it is "eisenstat_walker", it is chosen adaptively [Eisenstat, Walker, 1996, Choice 2], bounded by forcing_max.
+   * - "jfnk": jacobian-free Newton-Krylov, solves for the update with (flexible) GMRES up to krylov_precision (relative
+   *   to the residual), where the jacobian is only applied by finite differences of the operator in the direction
+   *   of the Krylov vectors (with a step size of fd_eps * (1 + |source|_2) / |direction|_2). If preconditioner is
+   *   "jacobian", the jacobian is assembled every preconditioner_lag iterations and each Krylov vector is
+   *   preconditioned by an inexact solve with it (up to preconditioner_precision), otherwise ("none") no matrix is
+   *   assembled at all.
+   *
    * \todo Allow to pass jacobian options as subcfg in newton.
    */
   virtual XT::Common::Configuration invert_options(const std::string& type) const
   {
     if (type == "newton")
-      return {{"type", type}, {"precision", "1e-7"}, {"max_iter", "100"}, {"max_dampening_iter", "1000"}};
+      return {{"type", type},
+              {"precision", "1e-7"},
+              {"max_iter", "100"},
+              {"max_dampening_iter", "1000"},
+              {"jacobian_lag", "1"},
+              {"forcing", "fixed"},
+              {"forcing_max", "0.9"}};
+    else if (type == "jfnk")
+      return {{"type", type},
+              {"precision", "1e-7"},
+              {"max_iter", "100"},
+              {"max_dampening_iter", "1000"},
+              {"krylov_precision", "1e-3"},
+              {"krylov_max_iter", "200"},
+              {"krylov_restart", "30"},
+              {"fd_eps", "1e-7"},
+              {"preconditioner", "none"},
+              {"preconditioner_lag", "5"},
+              {"preconditioner_precision", "1e-2"}};
     DUNE_THROW(Exceptions::operator_error, "type = " << type);
   } // ... invert_options(...)
 
+  /**
+   * \brief The jacobian (and its solver) of the "newton" inversion, to be kept between calls of apply_inverse.
+   *
+   * The operator to be inverted is usually a temporary (e.g., the residual operator of an implicit time step), so the
+   * cache is owned by the caller (e.g., the time stepper) and the jacobian is identified by the spaces, which have to
+   * outlive the cache. Changing the size of a space (e.g. by grid adaptation) discards the jacobian.
+   */
+  struct NewtonJacobianCache
+  {
+    bool matches(const SourceSpaceType& src_space, const RangeSpaceType& rng_space) const
+    {
+      return jacobian_op && source_space == &src_space && range_space == &rng_space
+             && source_size == src_space.mapper().size() && range_size == rng_space.mapper().size();
+    }
+
+    const SourceSpaceType* source_space = nullptr;
+    const RangeSpaceType* range_space = nullptr;
+    size_t source_size = 0;
+    size_t range_size = 0;
+    std::unique_ptr<MatrixOperatorType> jacobian_op;
+    std::unique_ptr<XT::LA::Solver<M>> jacobian_solver;
+    size_t age = std::numeric_limits<size_t>::max();
+    std::string linear_solver_type;
+  }; // struct NewtonJacobianCache
+
   /**
    * Given source is used as initial guess.
    *
@@ -510,21 +569,72 @@ invert_options(some_type).get<std::string>("type") == some_type
     const auto type = opts.get<std::string>("type");
     const XT::Common::Configuration default_opts = this->invert_options(type);
     if (type == "newton") {
+      NewtonJacobianCache jacobian_cache;
+      this->apply_inverse_by_newton(range, source, opts, jacobian_cache, param);
+    } else if (type == "jfnk") {
       // some preparations
       auto residual_op = *this - range;
       auto residual = range.copy();
+      auto rhs = range.copy();
       auto update = source.copy();
       auto candidate = source.copy();
-      // one matrix for all jacobians
-      MatrixOperatorType jacobian_op(this->source_space().grid_view(),
-                                     this->source_space(),
-                                     this->range_space(),
-                                     make_element_and_intersection_sparsity_pattern(
-                                         this->source_space(), this->range_space(), this->source_space().grid_view()));
-      XT::LA::Solver<M> jacobian_solver(jacobian_op.matrix());
+      auto perturbed_residual = range.copy();
       const auto precision = opts.get("precision", default_opts.get<double>("precision"));
       const auto max_iter = opts.get("max_iter", default_opts.get<size_t>("max_iter"));
-      const auto max_dampening_iter = opts.get("max_dampening_iter", default_opts.get<size_t>("max_iter"));
+      const auto max_dampening_iter = opts.get("max_dampening_iter", default_opts.get<size_t>("max_dampening_iter"));
+      const auto krylov_precision = opts.get("krylov_precision", default_opts.get<double>("krylov_precision"));
+      const auto krylov_max_iter = opts.get("krylov_max_iter", default_opts.get<size_t>("krylov_max_iter"));
+      const auto krylov_restart = opts.get("krylov_restart", default_opts.get<size_t>("krylov_restart"));
+      const auto fd_eps = opts.get("fd_eps", default_opts.get<double>("fd_eps"));
+      const auto preconditioner = opts.get("preconditioner", default_opts.get<std::string>("preconditioner"));
+      const auto preconditioner_lag = opts.get("preconditioner_lag", default_opts.get<size_t>("preconditioner_lag"));
+      const auto preconditioner_precision =
+          opts.get("preconditioner_precision", default_opts.get<double>("preconditioner_precision"));
+      DUNE_THROW_IF(preconditioner != "none" && preconditioner != "jacobian",
+                    Exceptions::operator_error,
+                    "preconditioner = " << preconditioner << "\nopts:\n"
+                                        << opts);
+      DUNE_THROW_IF(preconditioner_lag == 0, Exceptions::operator_error, "preconditioner_lag = 0\nopts:\n" << opts);
+      // the lagged jacobian is only allocated if required
+      std::unique_ptr<MatrixOperatorType> jacobian_op;
+      std::unique_ptr<XT::LA::Solver<M>> jacobian_solver;
+      if (preconditioner == "jacobian") {
+        jacobian_op = std::make_unique<MatrixOperatorType>(
+            this->source_space().grid_view(),
+            this->source_space(),
+            this->range_space(),
+            make_element_and_intersection_sparsity_pattern(
+                this->source_space(), this->range_space(), this->source_space().grid_view()));
+        jacobian_solver = std::make_unique<XT::LA::Solver<M>>(jacobian_op->matrix());
+      }
+      // the directional derivative of the residual at source, J v ~= (R(source + h v) - R(source)) / h
+      const auto apply_jacobian = [&](const VectorType& direction, VectorType& result) {
+        const auto direction_norm = direction.l2_norm();
+        if (!(direction_norm > 0.)) {
+          result *= 0.;
+          return;
+        }
+        const auto h = fd_eps * (1. + source.l2_norm()) / direction_norm;
+        candidate = source;
+        candidate.axpy(h, direction);
+        residual_op.apply(candidate, perturbed_residual, param);
+        result = perturbed_residual;
+        result -= residual;
+        result *= 1. / h;
+      };
+      const auto apply_preconditioner = [&](const VectorType& vector, VectorType& result) {
+        result = vector;
+        if (!jacobian_solver)
+          return;
+        try {
+          jacobian_solver->apply(vector,
+                                 result,
+                                 {{"type", jacobian_solver->types().at(0)},
+                                  {"precision", XT::Common::to_string(preconditioner_precision)}});
+        } catch (const XT::LA::Exceptions::linear_solver_failed&) {
+          result = vector; // <- an inexact preconditioner is fine for flexible GMRES
+        }
+      };
       size_t l = 0;
       Timer timer;
       while (true) {
@@ -541,40 +651,33 @@ invert_options(some_type).get<std::string>("type") == some_type
                       Exceptions::operator_error,
                       "max iterations reached!\n|residual|_l2 = " << res << "\nopts:\n"
                                                                   << opts);
-        LOG_(debug) << "       computing jacobi matrix ... " << std::flush;
-        timer.reset();
-        jacobian_op.matrix() *= 0.;
-        residual_op.jacobian(source, jacobian_op, {{"type", residual_op.jacobian_options().at(0)}}, param);
-        jacobian_op.walk(/*use_tbb=*/true);
-        LOG_(debug) << "took " << timer.elapsed() << "s\n       solving for defect ... " << std::flush;
-        timer.reset();
-        residual *= -1.;
-        update = source; // <- initial guess for the linear solver
-        bool linear_solve_succeeded = false;
-        std::vector<std::string> tried_linear_solvers;
-        for (const auto& linear_solver_type : jacobian_solver.types()) {
-          try {
-            tried_linear_solvers.push_back(linear_solver_type);
-            jacobian_solver.apply(
-                residual,
-                update,
-                {{"type", linear_solver_type}, {"precision", XT::Common::to_string(0.1 * precision)}});
-            linear_solve_succeeded = true;
-          } catch (const XT::LA::Exceptions::linear_solver_failed&) {
-          }
-        }
-        DUNE_THROW_IF(!linear_solve_succeeded,
-                      Exceptions::operator_error,
-                      "could not solve linear system for defect!\nTried the following linear solvers: "
-                          << tried_linear_solvers << "\nopts:\n"
-                          << opts);
-        LOG_(debug) << "took " << timer.elapsed() << "s";
-        if (tried_linear_solvers.size() > 1) {
-          LOG_(debug) << ", took " << tried_linear_solvers.size() << " attempts with different linear solvers";
+        if (jacobian_op && l % preconditioner_lag == 0) {
+          LOG_(debug) << "       computing jacobi matrix for the preconditioner ... " << std::flush;
+          timer.reset();
+          jacobian_op->matrix() *= 0.;
+          residual_op.jacobian(source, *jacobian_op, {{"type", residual_op.jacobian_options().at(0)}}, param);
+          jacobian_op->walk(/*use_tbb=*/true);
+          LOG_(debug) << "took " << timer.elapsed() << "s" << std::endl;
         }
+        LOG_(debug) << "       solving for defect ... " << std::flush;
+        timer.reset();
+        rhs = residual;
+        rhs *= -1.;
+        update *= 0.;
+        double krylov_residual = 0.;
+        const auto krylov_iterations = internal::fgmres(apply_jacobian,
+                                                        apply_preconditioner,
+                                                        rhs,
+                                                        update,
+                                                        krylov_precision,
+                                                        krylov_max_iter,
+                                                        krylov_restart,
+                                                        krylov_residual);
+        LOG_(debug) << "took " << timer.elapsed() << "s and " << krylov_iterations
+                    << " Krylov iterations (|defect|_l2 = " << krylov_residual << ")";
         LOG_(debug) << "\n       computing update ... " << std::flush;
         timer.reset();
-        // try the automatic dampening strategy proposed in [DF2015, Sec. 8.4.4.1, p. 432]
+        // the same automatic dampening strategy as above
         size_t k = 0;
         auto candidate_res = 2 * res; // any number such that we enter the while loop at least once
         double lambda = 1;
@@ -585,8 +688,8 @@ invert_options(some_type).get<std::string>("type") == some_type
                             << res << "\nl = " << l << "\nopts:\n"
                             << opts);
           candidate = source + update * lambda;
-          residual_op.apply(candidate, residual, param);
-          candidate_res = residual.l2_norm();
+          residual_op.apply(candidate, perturbed_residual, param);
+          candidate_res = perturbed_residual.l2_norm();
           lambda /= 2;
           k += 1;
         }
@@ -598,6 +701,25 @@ invert_options(some_type).get<std::string>("type") == some_type
       DUNE_THROW(Exceptions::operator_error, "type = " << type);
   } // ... apply_inverse(...)
 
+  /**
+   * \brief Same as above, but the "newton" inversion keeps its jacobian (and its solver) in the given jacobian_cache
+   *        for the next call with the same cache, which is beneficial for implicit time stepping with small time steps.
+   *
+   * The cache is not used by the other inversion algorithms.
+   */
+  void apply_inverse(const VectorType& range,
+                     VectorType& source,
+                     const XT::Common::Configuration& opts,
+                     NewtonJacobianCache& jacobian_cache,
+                     const XT::Common::Parameter& param = {}) const
+  {
+    DUNE_THROW_IF(!opts.has_key("type"), Exceptions::operator_error, "opts = " << opts);
+    if (opts.get<std::string>("type") == "newton")
+      this->apply_inverse_by_newton(range, source, opts, jacobian_cache, param);
+    else
+      this->apply_inverse(range, source, opts, param);
+  } // ... apply_inverse(...)
+
   /// \}
   /// \name These methods should be implemented and define the functionality of the operators jacobian.
   /// \{
@@ -981,6 +1103,181 @@ invert_options(some_type).get<std::string>("type") == some_type
   }
 
   /// \}
+
+private:
+  /// \brief The "newton" inversion, \sa invert_options
+  void apply_inverse_by_newton(const VectorType& range,
+                               VectorType& source,
+                               const XT::Common::Configuration& opts,
+                               NewtonJacobianCache& jacobian_cache,
+                               const XT::Common::Parameter& param) const
+  {
+    const XT::Common::Configuration default_opts = this->invert_options("newton");
+    // some preparations
+    auto residual_op = *this - range;
+    auto residual = range.copy();
+    auto update = source.copy();
+    auto candidate = source.copy();
+    const auto precision = opts.get("precision", default_opts.get<double>("precision"));
+    const auto max_iter = opts.get("max_iter", default_opts.get<size_t>("max_iter"));
+    const auto max_dampening_iter = opts.get("max_dampening_iter", default_opts.get<size_t>("max_dampening_iter"));
+    const auto jacobian_lag = opts.get("jacobian_lag", default_opts.get<size_t>("jacobian_lag"));
+    const auto forcing = opts.get("forcing", default_opts.get<std::string>("forcing"));
+    const auto forcing_max = opts.get("forcing_max", default_opts.get<double>("forcing_max"));
+    DUNE_THROW_IF(jacobian_lag == 0, Exceptions::operator_error, "jacobian_lag = 0\nopts:\n" << opts);
+    DUNE_THROW_IF(forcing != "fixed" && forcing != "eisenstat_walker",
+                  Exceptions::operator_error,
+                  "forcing = " << forcing << "\nopts:\n"
+                               << opts);
+    DUNE_THROW_IF(!(forcing_max > 0.) || !(forcing_max < 1.),
+                  Exceptions::operator_error,
+                  "forcing_max = " << forcing_max << "\nopts:\n"
+                                   << opts);
+    // one matrix for all jacobians, possibly kept from the last call
+    if (!jacobian_cache.matches(this->source_space(), this->range_space())) {
+      jacobian_cache.source_space = &this->source_space();
+      jacobian_cache.range_space = &this->range_space();
+      jacobian_cache.source_size = this->source_space().mapper().size();
+      jacobian_cache.range_size = this->range_space().mapper().size();
+      jacobian_cache.jacobian_op = std::make_unique<MatrixOperatorType>(
+          this->source_space().grid_view(),
+          this->source_space(),
+          this->range_space(),
+          make_element_and_intersection_sparsity_pattern(
+              this->source_space(), this->range_space(), this->source_space().grid_view()));
+      jacobian_cache.jacobian_solver = std::make_unique<XT::LA::Solver<M>>(jacobian_cache.jacobian_op->matrix());
+      jacobian_cache.age = std::numeric_limits<size_t>::max();
+      jacobian_cache.linear_solver_type.clear();
+    }
+    auto& jacobian_op = *jacobian_cache.jacobian_op;
+    auto& jacobian_solver = *jacobian_cache.jacobian_solver;
+    const auto assemble_jacobian = [&]() {
+      jacobian_op.matrix() *= 0.;
+      residual_op.jacobian(source, jacobian_op, {{"type", residual_op.jacobian_options().at(0)}}, param);
+      jacobian_op.walk(/*use_tbb=*/true);
+      jacobian_cache.age = 0;
+    };
+    size_t l = 0;
+    double previous_res = 0.;
+    double linear_precision = 0.1 * precision;
+    bool previous_update_was_damped = false;
+    Timer timer;
+    while (true) {
+      timer.reset();
+      LOG_(debug) << "l = " << l << ": computing residual ... " << std::flush;
+      residual_op.apply(source, residual, param);
+      auto res = residual.l2_norm();
+      LOG_(debug) << "took " << timer.elapsed() << "s, |residual|_l2 = " << res << std::endl;
+      if (res < precision) {
+        LOG_(debug) << "       residual below tolerance, succeeded!" << std::endl;
+        break;
+      }
+      DUNE_THROW_IF(l >= max_iter,
+                    Exceptions::operator_error,
+                    "max iterations reached!\n|residual|_l2 = " << res << "\nopts:\n"
+                                                                << opts);
+      // an outdated jacobian is only kept as long as it yields undamped updates
+      bool jacobian_is_current = false;
+      if (jacobian_cache.age >= jacobian_lag || previous_update_was_damped) {
+        LOG_(debug) << "       computing jacobi matrix ... " << std::flush;
+        timer.reset();
+        assemble_jacobian();
+        jacobian_is_current = true;
+        LOG_(debug) << "took " << timer.elapsed() << "s" << std::endl;
+      } else
+        LOG_(debug) << "       reusing jacobi matrix of age " << jacobian_cache.age << std::endl;
+      if (forcing == "eisenstat_walker")
+        linear_precision = eisenstat_walker_forcing(l, res, previous_res, linear_precision, precision, forcing_max);
+      LOG_(debug) << "       solving for defect (relative precision " << linear_precision << ") ... " << std::flush;
+      timer.reset();
+      residual *= -1.;
+      // try the last successful linear solver first
+      std::vector<std::string> linear_solver_types = jacobian_solver.types();
+      const auto last_successful =
+          std::find(linear_solver_types.begin(), linear_solver_types.end(), jacobian_cache.linear_solver_type);
+      if (last_successful != linear_solver_types.end())
+        std::rotate(linear_solver_types.begin(), last_successful, last_successful + 1);
+      bool linear_solve_succeeded = false;
+      std::vector<std::string> tried_linear_solvers;
+      while (!linear_solve_succeeded) {
+        for (const auto& linear_solver_type : linear_solver_types) {
+          try {
+            tried_linear_solvers.push_back(linear_solver_type);
+            update = source; // <- initial guess for the linear solver
+            jacobian_solver.apply(
+                residual,
+                update,
+                {{"type", linear_solver_type}, {"precision", XT::Common::to_string(linear_precision)}});
+            linear_solve_succeeded = true;
+            jacobian_cache.linear_solver_type = linear_solver_type;
+            break;
+          } catch (const XT::LA::Exceptions::linear_solver_failed&) {
+          }
+        }
+        if (linear_solve_succeeded || jacobian_is_current)
+          break;
+        // the outdated jacobian might be the culprit
+        assemble_jacobian();
+        jacobian_is_current = true;
+      }
+      DUNE_THROW_IF(!linear_solve_succeeded,
+                    Exceptions::operator_error,
+                    "could not solve linear system for defect!\nTried the following linear solvers: "
+                        << tried_linear_solvers << "\nopts:\n"
+                        << opts);
+      LOG_(debug) << "took " << timer.elapsed() << "s";
+      if (tried_linear_solvers.size() > 1) {
+        LOG_(debug) << ", took " << tried_linear_solvers.size() << " attempts with different linear solvers";
+      }
+      LOG_(debug) << "\n       computing update ... " << std::flush;
+      timer.reset();
+      // try the automatic dampening strategy proposed in [DF2015, Sec. 8.4.4.1, p. 432]
+      size_t k = 0;
+      auto candidate_res = 2 * res; // any number such that we enter the while loop at least once
+      double lambda = 1;
+      while (!(candidate_res / res < 1)) {
+        DUNE_THROW_IF(k >= max_dampening_iter,
+                      Exceptions::operator_error,
+                      "max iterations reached when trying to compute automatic dampening!\n|residual|_l2 = "
+                          << res << "\nl = " << l << "\nopts:\n"
+                          << opts);
+        candidate = source + update * lambda;
+        residual_op.apply(candidate, residual, param);
+        candidate_res = residual.l2_norm();
+        lambda /= 2;
+        k += 1;
+      }
+      source = candidate;
+      previous_update_was_damped = (k > 1);
+      previous_res = res;
+      jacobian_cache.age += 1;
+      LOG_(debug) << "took " << timer.elapsed() << "s and a dampening of " << 2 * lambda << std::endl;
+      l += 1;
+    }
+  } // ... apply_inverse_by_newton(...)
+
+  /**
+   * \brief The relative precision of the linear solve in the l-th Newton iteration [Eisenstat, Walker, 1996, Choice 2,
+   *        with gamma = 0.9 and alpha = 2], safeguarded against a too rapid decrease and against oversolving.
+   */
+  static double eisenstat_walker_forcing(const size_t l,
+                                         const double res,
+                                         const double previous_res,
+                                         const double previous_forcing,
+                                         const double precision,
+                                         const double forcing_max)
+  {
+    const double gamma = 0.9;
+    if (l == 0 || !(previous_res > 0.))
+      return forcing_max;
+    double forcing = gamma * std::pow(res / previous_res, 2);
+    const double safeguard = gamma * std::pow(previous_forcing, 2);
+    if (safeguard > 0.1)
+      forcing = std::max(forcing, safeguard);
+    // no need to solve more accurately than required to reach precision
+    forcing = std::max(forcing, 0.5 * precision / res);
+    return std::min(forcing, forcing_max);
+  } // ... eisenstat_walker_forcing(...)
 }; // class OperatorInterface
 
 
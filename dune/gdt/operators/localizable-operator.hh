@@ -11,7 +11,11 @@
 #ifndef DUNE_GDT_OPERATORS_LOCALIZABLE_OPERATOR_HH
 #define DUNE_GDT_OPERATORS_LOCALIZABLE_OPERATOR_HH
 
+#include <algorithm>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
 
 #include <dune/xt/la/type_traits.hh>
 #include <dune/xt/grid/type_traits.hh>
@@ -21,6 +25,8 @@
 #include <dune/gdt/local/assembler/operator-applicators.hh>
 #include <dune/gdt/local/operators/generic.hh>
 #include <dune/gdt/local/operators/interfaces.hh>
+#include <dune/gdt/tools/colored-finite-differences.hh>
+#include <dune/gdt/tools/sparsity-pattern.hh>
 
 #include "interfaces.hh"
 
@@ -288,9 +294,25 @@ public:
     , range_space_(range_space)
     , linear_(true)
     , use_tbb_(use_tbb)
+    , face_neighbor_stencil_(false)
+    , coloring_range_size_(0)
   {}
 
-  LocalizableOperator(ThisType&& source) = default;
+  LocalizableOperator(ThisType&& source)
+    : BaseType(std::move(source))
+    , assembly_grid_view_(source.assembly_grid_view_)
+    , source_space_(source.source_space_)
+    , range_space_(source.range_space_)
+    , linear_(source.linear_)
+    , use_tbb_(source.use_tbb_)
+    , face_neighbor_stencil_(source.face_neighbor_stencil_)
+    , local_element_operators_(std::move(source.local_element_operators_))
+    , local_intersection_operators_(std::move(source.local_intersection_operators_))
+    , local_element_finalizations_(std::move(source.local_element_finalizations_))
+    , coloring_mutex_()
+    , coloring_(std::move(source.coloring_))
+    , coloring_range_size_(source.coloring_range_size_)
+  {}
 
   bool linear() const override final
   {
@@ -325,6 +347,43 @@ public:
     return *this;
   }
 
+  /**
+   * \brief Appends a local element operator which is applied in a second grid walk, after the contributions of all
+   *        local operators appended by append() have been added to the range (e.g., to post-process the local DoFs of
+   *        each element).
+   *
+   * \note In apply_range(), the second walk is restricted to the given range of elements. This is only correct if all
+   *       contributions to the DoFs of an element stem from the element itself and its intersections (i.e., if no
+   *       local intersection operator contributes to the outside).
+   * \note Only "colored-finite-differences" jacobians are available for operators with finalizations.
+   */
+  ThisType& append_finalization(const LocalElementOperatorType& local_operator,
+                                const XT::Grid::ElementFilter<AGV>& filter = XT::Grid::ApplyOn::AllElements<AGV>())
+  {
+    linear_ = linear_ && local_operator.linear();
+    this->extend_parameter_type(local_operator.parameter_type());
+    local_element_finalizations_.emplace_back(local_operator.copy(), filter.copy());
+    return *this;
+  }
+
+  /**
+   * \brief Declares that the local operators only access the source on each element and on its face neighbors (as,
+   *        e.g., first order finite volume schemes or DG schemes without reconstruction do).
+   *
+   * This can not be deduced from the local operators and is required for split-phase communication, see
+   * ExplicitRungeKuttaTimeStepper::use_split_phase_communication.
+   */
+  ThisType& declare_face_neighbor_stencil(const bool value = true)
+  {
+    face_neighbor_stencil_ = value;
+    return *this;
+  }
+
+  bool face_neighbor_stencil() const
+  {
+    return face_neighbor_stencil_;
+  }
+
   ThisType& operator+=(const LocalElementOperatorType& local_op)
   {
     return this->append(local_op);
@@ -375,24 +434,42 @@ public:
     }
     // and apply it in a grid walk
     localizable_op.assemble(use_tbb_);
+    // - finalizations, in a second grid walk
+    if (!local_element_finalizations_.empty()) {
+      auto finalizing_op =
+          make_localizable_operator_applicator(this->assembly_grid_view_, source_function, range_function);
+      for (const auto& op_and_filter : local_element_finalizations_) {
+        const auto local_op = op_and_filter.first->with_source(source_function);
+        const auto& filter = *op_and_filter.second;
+        finalizing_op.append(*local_op, param, filter);
+      }
+      finalizing_op.assemble(use_tbb_);
+    }
     DEBUG_THROW_IF(!range.valid(), Exceptions::operator_error, "range contains inf or nan!");
   } // ... apply(...)
 
   // The respective Base::apply would not ent up in the correct apply above!
-  void apply(const VectorType& source, VectorType& range, const XT::Common::Parameter& param = {}) const override final
+  void apply(const VectorType& source, VectorType& range, const XT::Common::Parameter& param = {}) const override
   {
     DUNE_THROW_IF(!source.valid(), Exceptions::operator_error, "source contains inf or nan!");
     const auto source_function = make_discrete_function(this->source_space_, source);
     apply(source_function, range, param);
   } // ... apply(...)
 
+  /**
+   * Applies the operator on the given range of elements only. If clear_range is false, the contributions are added to
+   * range, which allows to apply the operator on a disjoint decomposition of the grid view in several calls (e.g., to
+   * overlap communication with computation).
+   */
   template <class ElementRange>
   void apply_range(const SourceFunctionInterfaceType& source_function,
                    VectorType& range,
                    const XT::Common::Parameter& param,
-                   const ElementRange& element_range) const
+                   const ElementRange& element_range,
+                   const bool clear_range = true) const
   {
-    range.set_all(0);
+    if (clear_range)
+      range.set_all(0);
     auto range_function = make_discrete_function(this->range_space_, range);
     // set up the actual operator
     auto localizable_op =
@@ -411,6 +488,17 @@ public:
     }
     // and apply it in a grid walk
     localizable_op.assemble_range(element_range);
+    // - finalizations, in a second walk over the same elements
+    if (!local_element_finalizations_.empty()) {
+      auto finalizing_op =
+          make_localizable_operator_applicator(this->assembly_grid_view_, source_function, range_function);
+      for (const auto& op_and_filter : local_element_finalizations_) {
+        const auto local_op = op_and_filter.first->with_source(source_function);
+        const auto& filter = *op_and_filter.second;
+        finalizing_op.append(*local_op, param, filter);
+      }
+      finalizing_op.assemble_range(element_range);
+    }
     DEBUG_THROW_IF(!range.valid(), Exceptions::operator_error, "range contains inf or nan!");
   } // ... apply_range(...)
 
@@ -418,11 +506,12 @@ public:
   void apply_range(const VectorType& source,
                    VectorType& range,
                    const XT::Common::Parameter& param,
-                   const ElementRange& element_range) const
+                   const ElementRange& element_range,
+                   const bool clear_range = true) const
   {
     DUNE_THROW_IF(!source.valid(), Exceptions::operator_error, "source contains inf or nan!");
     const auto source_function = make_discrete_function(this->source_space_, source);
-    apply_range(source_function, range, param, element_range);
+    apply_range(source_function, range, param, element_range, clear_range);
   } // ... apply_range(...)
 
   // additional convenience apply methods to match the correct one above
@@ -443,14 +532,32 @@ public:
     return ret;
   }
 
-  std::vector<std::string> jacobian_options() const override final
+  /**
+   * - "finite-differences": perturbs each source DoF separately in the local operators (see
+   *   LocalElementOperatorFiniteDifferenceJacobianAssembler), requires one local application per DoF and element or
+   *   intersection
+   * - "colored-finite-differences": perturbs all structurally orthogonal source DoFs at once (see
+   *   colored_finite_difference_jacobian), requires about as many applications of this operator as there are DoFs in
+   *   the stencil of an element, the only option for operators with finalizations (see append_finalization)
+   *
+   * \note The coloring is computed once from the stencil of this operator (the element pattern, or the element and
+   *       intersection pattern if local intersection operators are present), the pattern of the matrix of jacobian_op
+   *       has to contain it. It is recomputed if the number of DoFs of the spaces changes (e.g., after adaptation).
+   */
+  std::vector<std::string> jacobian_options() const override
   {
-    return {"finite-differences"};
+    if (local_element_finalizations_.empty())
+      return {"finite-differences", "colored-finite-differences"};
+    else
+      return {"colored-finite-differences"};
   }
 
   XT::Common::Configuration jacobian_options(const std::string& type) const override final
   {
-    DUNE_THROW_IF(type != this->jacobian_options().at(0), Exceptions::operator_error, "type = " << type);
+    const auto options = this->jacobian_options();
+    DUNE_THROW_IF(std::find(options.begin(), options.end(), type) == options.end(),
+                  Exceptions::operator_error,
+                  "type = " << type << "\n   jacobian_options() = " << options);
     return {{"type", type}, {"eps", "1e-7"}};
   }
 
@@ -467,9 +574,14 @@ public:
                   Exceptions::operator_error,
                   "this->parameter_type() = " << this->parameter_type() << "\n   param.type() = " << param.type());
     DUNE_THROW_IF(!opts.has_key("type"), Exceptions::operator_error, opts);
-    DUNE_THROW_IF(opts.get<std::string>("type") != jacobian_options().at(0), Exceptions::operator_error, opts);
-    const auto default_opts = jacobian_options(jacobian_options().at(0));
+    const auto type = opts.get<std::string>("type");
+    const auto default_opts = jacobian_options(type);
     const auto eps = opts.get("eps", default_opts.template get<double>("eps"));
+    if (type == "colored-finite-differences") {
+      colored_finite_difference_jacobian(
+          *this, source, jacobian_op.matrix(), *jacobian_coloring(), jacobian_op.scaling, eps, param);
+      return;
+    }
     const auto parameter = param + XT::Common::Parameter({"finite-difference-jacobians.eps", eps});
     // append the same local ops with the same filters as in apply() above
     // - element contributions
@@ -488,16 +600,40 @@ public:
   } // ... jacobian(...)
 
 protected:
+  std::shared_ptr<const ColumnColoring> jacobian_coloring() const
+  {
+    std::lock_guard<std::mutex> lock(coloring_mutex_);
+    if (!coloring_ || coloring_range_size_ != range_space_.mapper().size()
+        || coloring_->num_cols() != source_space_.mapper().size()) {
+      const auto pattern =
+          local_intersection_operators_.empty()
+              ? make_element_sparsity_pattern(range_space_, source_space_, assembly_grid_view_, use_tbb_)
+              : make_element_and_intersection_sparsity_pattern(
+                    range_space_, source_space_, assembly_grid_view_, use_tbb_);
+      coloring_ = std::make_shared<ColumnColoring>(pattern, source_space_.mapper().size());
+      coloring_range_size_ = range_space_.mapper().size();
+      LOG_(debug) << "computed a coloring of the jacobian pattern with " << coloring_->num_colors() << " colors"
+                  << std::endl;
+    }
+    return coloring_;
+  } // ... jacobian_coloring(...)
+
   const AGV assembly_grid_view_;
   const SourceSpaceType& source_space_;
   const RangeSpaceType& range_space_;
   bool linear_;
   const bool use_tbb_;
+  bool face_neighbor_stencil_;
   std::list<std::pair<std::unique_ptr<LocalElementOperatorType>, std::unique_ptr<XT::Grid::ElementFilter<AGV>>>>
       local_element_operators_;
   std::list<
       std::pair<std::unique_ptr<LocalIntersectionOperatorType>, std::unique_ptr<XT::Grid::IntersectionFilter<AGV>>>>
       local_intersection_operators_;
+  std::list<std::pair<std::unique_ptr<LocalElementOperatorType>, std::unique_ptr<XT::Grid::ElementFilter<AGV>>>>
+      local_element_finalizations_;
+  mutable std::mutex coloring_mutex_;
+  mutable std::shared_ptr<const ColumnColoring> coloring_;
+  mutable size_t coloring_range_size_;
 }; // class LocalizableOperator
 
 
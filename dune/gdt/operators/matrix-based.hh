@@ -28,6 +28,8 @@
 #include <dune/gdt/local/bilinear-forms/interfaces.hh>
 #include <dune/gdt/local/operators/interfaces.hh>
 #include <dune/gdt/operators/interfaces.hh>
+#include <dune/gdt/tools/matrix-scatter.hh>
+#include <dune/gdt/tools/parallel-for.hh>
 #include <dune/gdt/tools/sparsity-pattern.hh>
 #include <dune/gdt/type_traits.hh>
 
@@ -255,6 +257,7 @@ class MatrixOperator
 
 public:
   using AssemblyGridViewType = SGV;
+  using PositionCacheType = LocalMatrixPositionCache<M, SGV, RGV, SGV>;
 
   using typename BaseOperatorType::F;
   using typename BaseOperatorType::FieldType;
@@ -286,6 +289,8 @@ public:
     , BaseOperatorType(source_spc, range_spc, MatrixStorage::access(), logging_prefix)
     , BaseWalkerType(assembly_grid_view)
     , scaling(1.)
+    , position_cache_(std::make_shared<PositionCacheType>(assembly_grid_view))
+    , cache_matrix_positions_(false)
   {
     LOG__(BaseOperatorType, info) << "MatrixOperator(assembly_grid_view=" << &assembly_grid_view
                                   << ", source_space=" << &source_spc << ", range_space=" << &range_spc
@@ -304,6 +309,8 @@ public:
     , BaseOperatorType(source_spc, range_spc, MatrixStorage::access(), logging_prefix)
     , BaseWalkerType(assembly_grid_view)
     , scaling(1.)
+    , position_cache_(std::make_shared<PositionCacheType>(assembly_grid_view))
+    , cache_matrix_positions_(false)
   {
     LOG__(BaseOperatorType, info) << "MatrixOperator(assembly_grid_view=" << &assembly_grid_view
                                   << ", source_space=" << &source_spc << ", range_space=" << &range_spc
@@ -321,6 +328,8 @@ public:
     , BaseOperatorType(other)
     , BaseWalkerType(other)
     , scaling(other.scaling)
+    , position_cache_(other.position_cache_)
+    , cache_matrix_positions_(other.cache_matrix_positions_)
   {
     // If this constructor is defaulted, the Intel Compiler thinks it is deleted (tested with icc 2021.1 Beta 20200827)
   }
@@ -341,6 +350,23 @@ public:
 
   FieldType scaling;
 
+  /**
+   * \brief Caches the positions of all local blocks in the matrix, see LocalMatrixPositionCache.
+   *
+   * Subsequent calls to assemble() on the same grid then reduce the scatter of local matrices to indexed adds. The
+   * cache is rebuilt in assemble() whenever one of the mappers of source or range space was adapted (or on first use).
+   *
+   * \note Only has an effect for matrices with a known CSR layout and if a single thread is available, see
+   *       LocalMatrixScatter.
+   */
+  ThisType& cache_matrix_positions(const bool cache = true)
+  {
+    cache_matrix_positions_ = cache;
+    if (!cache_matrix_positions_)
+      position_cache_->invalidate();
+    return *this;
+  }
+
   using BaseWalkerType::append;
 
   ThisType& append(const LocalElementBilinearFormInterface<E, r_r, r_rC, F, F, s_r, s_rC, F>& local_bilinear_form,
@@ -363,7 +389,8 @@ public:
                                         local_bilinear_form,
                                         MatrixStorage::access(),
                                         param + XT::Common::Parameter("matrixoperator.scaling", scaling),
-                                        derived_logging_prefix),
+                                        derived_logging_prefix,
+                                        position_cache_.get()),
                  filter);
     return *this;
   } // ... append(...)
@@ -387,7 +414,8 @@ public:
                                         this->source_space(),
                                         local_bilinear_form,
                                         MatrixStorage::access(),
-                                        param + XT::Common::Parameter("matrixoperator.scaling", scaling)),
+                                        param + XT::Common::Parameter("matrixoperator.scaling", scaling),
+                                        position_cache_.get()),
                  filter);
     return *this;
   } // ... append(...)
@@ -402,7 +430,8 @@ public:
                                         this->source_space(),
                                         local_bilinear_form,
                                         MatrixStorage::access(),
-                                        param + XT::Common::Parameter("matrixoperator.scaling", scaling)),
+                                        param + XT::Common::Parameter("matrixoperator.scaling", scaling),
+                                        position_cache_.get()),
                  filter);
     return *this;
   } // ... append(...)
@@ -495,6 +524,11 @@ public:
 
   ThisType& assemble(const bool use_tbb = false) override final
   {
+    if (cache_matrix_positions_)
+      position_cache_->update(MatrixStorage::access(), this->range_space().mapper(), this->source_space().mapper());
+    // the local assemblers access the backend of the matrix concurrently
+    if (use_tbb)
+      ensure_unshared_data(MatrixStorage::access());
     this->walk(use_tbb);
     return *this;
   }
@@ -502,9 +536,15 @@ public:
   template <class EntityRange>
   ThisType& assemble_range(const EntityRange& entity_range)
   {
+    if (cache_matrix_positions_)
+      position_cache_->update(MatrixStorage::access(), this->range_space().mapper(), this->source_space().mapper());
     this->walk_range(entity_range);
     return *this;
   }
+
+private:
+  std::shared_ptr<PositionCacheType> position_cache_;
+  bool cache_matrix_positions_;
 }; // class MatrixOperator
 
 
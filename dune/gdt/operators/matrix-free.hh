@@ -0,0 +1,309 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+#ifndef DUNE_GDT_OPERATORS_MATRIX_FREE_HH
+#define DUNE_GDT_OPERATORS_MATRIX_FREE_HH
+
+#include <list>
+#include <tuple>
+
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/grid/walker.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/exceptions.hh>
+#include <dune/gdt/local/assembler/bilinear-form-applicators.hh>
+#include <dune/gdt/local/bilinear-forms/interfaces.hh>
+#include <dune/gdt/operators/interfaces.hh>
+#include <dune/gdt/operators/matrix-based.hh>
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief Linear operator given by local bilinear forms, which are evaluated on the fly in each application.
+ *
+ * Accepts the same local element, coupling intersection and intersection bilinear forms as MatrixOperator, but never
+ * assembles a matrix: in apply(), each local bilinear form is evaluated for the test basis and the local source
+ * function in a single grid walk, see LocalElementBilinearFormApplicator. This trades memory (no global or local
+ * matrices) for recomputation in each application and is thus suited for iterative methods which only require the
+ * action of the operator, e.g. high-order IPDG discretizations where the matrix does not fit into memory.
+ *
+ * \note Within an element, LocalElementIntegralBilinearForm evaluates its integrand for all quadrature points at once
+ *       by evaluate_all() (see LocalBinaryElementIntegrandInterface), which is vectorized for the Laplace, elliptic
+ *       and product integrands. Since the local source takes the place of the ansatz basis, this computes a single
+ *       column of the local matrix. Intersection integrands are evaluated point by point. The local bilinear forms
+ *       are evaluated one element (or intersection) at a time, parallelism across elements is available by use_tbb.
+ *
+ * The jacobian (of type "self") is obtained by appending all local bilinear forms to the given MatrixOperator, which
+ * is only required for apply_inverse().
+ *
+ * \note See OperatorInterface for a description of the template arguments.
+ *
+ * \sa OperatorInterface
+ * \sa MatrixOperator
+ */
+template <class M, class SGV, size_t s_r = 1, size_t s_rC = 1, size_t r_r = s_r, size_t r_rC = s_rC, class RGV = SGV>
+class MatrixFreeOperator : public OperatorInterface<M, SGV, s_r, s_rC, r_r, r_rC, RGV>
+{
+  using ThisType = MatrixFreeOperator;
+  using BaseType = OperatorInterface<M, SGV, s_r, s_rC, r_r, r_rC, RGV>;
+
+public:
+  using AssemblyGridViewType = SGV;
+
+  using typename BaseType::F;
+  using typename BaseType::MatrixOperatorType;
+  using typename BaseType::RangeSpaceType;
+  using typename BaseType::SourceSpaceType;
+  using typename BaseType::V;
+  using typename BaseType::VectorType;
+
+  using E = XT::Grid::extract_entity_t<SGV>;
+  using I = XT::Grid::extract_intersection_t<SGV>;
+  using ElementFilterType = XT::Grid::ElementFilter<SGV>;
+  using IntersectionFilterType = XT::Grid::IntersectionFilter<SGV>;
+  using ApplyOnAllElements = XT::Grid::ApplyOn::AllElements<SGV>;
+  using ApplyOnAllIntersections = XT::Grid::ApplyOn::AllIntersections<SGV>;
+
+  using LocalElementBilinearFormType = LocalElementBilinearFormInterface<E, r_r, r_rC, F, F, s_r, s_rC, F>;
+  using LocalCouplingIntersectionBilinearFormType =
+      LocalCouplingIntersectionBilinearFormInterface<I, r_r, r_rC, F, F, s_r, s_rC, F>;
+  using LocalIntersectionBilinearFormType = LocalIntersectionBilinearFormInterface<I, r_r, r_rC, F, F, s_r, s_rC, F>;
+
+  MatrixFreeOperator(AssemblyGridViewType assembly_grid_view,
+                     const SourceSpaceType& source_spc,
+                     const RangeSpaceType& range_spc,
+                     const bool use_tbb = false,
+                     const std::string& logging_prefix = "")
+    : BaseType({},
+               logging_prefix.empty() ? "MatrixFreeOperator" : logging_prefix,
+               /*logging_disabled=*/logging_prefix.empty())
+    , assembly_grid_view_(assembly_grid_view)
+    , source_space_(source_spc)
+    , range_space_(range_spc)
+    , use_tbb_(use_tbb)
+  {
+    LOG_(info) << "MatrixFreeOperator(assembly_grid_view=" << &assembly_grid_view << ", source_space=" << &source_spc
+               << ", range_space=" << &range_spc << ", use_tbb=" << use_tbb << ")" << std::endl;
+  }
+
+  MatrixFreeOperator(ThisType&& source) = default;
+
+  bool linear() const override final
+  {
+    return true;
+  }
+
+  const SourceSpaceType& source_space() const override final
+  {
+    return source_space_;
+  }
+
+  const RangeSpaceType& range_space() const override final
+  {
+    return range_space_;
+  }
+
+  ThisType& append(const LocalElementBilinearFormType& local_bilinear_form,
+                   const XT::Common::Parameter& param = {},
+                   const ElementFilterType& filter = ApplyOnAllElements())
+  {
+    LOG_(info) << this->logger.prefix << ".append(local_element_bilinear_form=" << &local_bilinear_form
+               << ", param=" << param << ", element_filter=" << &filter << ")" << std::endl;
+    element_data_.emplace_back(local_bilinear_form.copy(), param, std::unique_ptr<ElementFilterType>(filter.copy()));
+    return *this;
+  }
+
+  ThisType& append(const LocalCouplingIntersectionBilinearFormType& local_bilinear_form,
+                   const XT::Common::Parameter& param = {},
+                   const IntersectionFilterType& filter = ApplyOnAllIntersections())
+  {
+    coupling_intersection_data_.emplace_back(
+        local_bilinear_form.copy(), param, std::unique_ptr<IntersectionFilterType>(filter.copy()));
+    return *this;
+  }
+
+  ThisType& append(const LocalIntersectionBilinearFormType& local_bilinear_form,
+                   const XT::Common::Parameter& param = {},
+                   const IntersectionFilterType& filter = ApplyOnAllIntersections())
+  {
+    intersection_data_.emplace_back(
+        local_bilinear_form.copy(), param, std::unique_ptr<IntersectionFilterType>(filter.copy()));
+    return *this;
+  }
+
+  ThisType& operator+=(const LocalElementBilinearFormType& bilinearform)
+  {
+    return this->append(bilinearform);
+  }
+
+  ThisType& operator+=(const std::tuple<const LocalElementBilinearFormType&,
+                                        const XT::Common::Parameter&,
+                                        const ElementFilterType&>& bilinearform_param_filter_tuple)
+  {
+    return this->append(std::get<0>(bilinearform_param_filter_tuple),
+                        std::get<1>(bilinearform_param_filter_tuple),
+                        std::get<2>(bilinearform_param_filter_tuple));
+  }
+
+  ThisType& operator+=(const LocalCouplingIntersectionBilinearFormType& bilinearform)
+  {
+    return this->append(bilinearform);
+  }
+
+  ThisType& operator+=(const std::tuple<const LocalCouplingIntersectionBilinearFormType&,
+                                        const XT::Common::Parameter&,
+                                        const IntersectionFilterType&>& bilinearform_param_filter_tuple)
+  {
+    return this->append(std::get<0>(bilinearform_param_filter_tuple),
+                        std::get<1>(bilinearform_param_filter_tuple),
+                        std::get<2>(bilinearform_param_filter_tuple));
+  }
+
+  ThisType& operator+=(const LocalIntersectionBilinearFormType& bilinearform)
+  {
+    return this->append(bilinearform);
+  }
+
+  ThisType& operator+=(const std::tuple<const LocalIntersectionBilinearFormType&,
+                                        const XT::Common::Parameter&,
+                                        const IntersectionFilterType&>& bilinearform_param_filter_tuple)
+  {
+    return this->append(std::get<0>(bilinearform_param_filter_tuple),
+                        std::get<1>(bilinearform_param_filter_tuple),
+                        std::get<2>(bilinearform_param_filter_tuple));
+  }
+
+  using BaseType::apply;
+
+  void apply(const VectorType& source,
+             VectorType& range,
+             const XT::Common::Parameter& /*param*/ = {}) const override final
+  {
+    DUNE_THROW_IF(!source.valid(), Exceptions::operator_error, "source contains inf or nan!");
+    DUNE_THROW_IF(source.size() != source_space_.mapper().size(),
+                  XT::Common::Exceptions::shapes_do_not_match,
+                  "source.size() = " << source.size()
+                                     << "\n   source_space.mapper().size() = " << source_space_.mapper().size());
+    DUNE_THROW_IF(range.size() != range_space_.mapper().size(),
+                  XT::Common::Exceptions::shapes_do_not_match,
+                  "range.size() = " << range.size()
+                                    << "\n   range_space.mapper().size() = " << range_space_.mapper().size());
+    range.set_all(0);
+    const auto source_function = make_discrete_function(source_space_, source);
+    XT::Grid::Walker<SGV> walker(assembly_grid_view_);
+    for (const auto& data : element_data_)
+      walker.append(new LocalElementBilinearFormApplicator<V, SGV, r_r, r_rC, F, RGV, s_r, s_rC, F>(
+                        range_space_, *std::get<0>(data), source_function, range, std::get<1>(data)),
+                    *std::get<2>(data));
+    for (const auto& data : coupling_intersection_data_)
+      walker.append(new LocalCouplingIntersectionBilinearFormApplicator<V, SGV, r_r, r_rC, F, RGV, s_r, s_rC, F>(
+                        range_space_, *std::get<0>(data), source_function, range, std::get<1>(data)),
+                    *std::get<2>(data));
+    for (const auto& data : intersection_data_)
+      walker.append(new LocalIntersectionBilinearFormApplicator<V, SGV, r_r, r_rC, F, RGV, s_r, s_rC, F>(
+                        range_space_, *std::get<0>(data), source_function, range, std::get<1>(data)),
+                    *std::get<2>(data));
+    walker.walk(use_tbb_);
+    DEBUG_THROW_IF(!range.valid(), Exceptions::operator_error, "range contains inf or nan!");
+  } // ... apply(...)
+
+  std::vector<std::string> jacobian_options() const override final
+  {
+    return {"self"};
+  }
+
+  XT::Common::Configuration jacobian_options(const std::string& type) const override final
+  {
+    DUNE_THROW_IF(type != jacobian_options().at(0),
+                  Exceptions::operator_error,
+                  "requested jacobian type is not one of the available ones!\n\n"
+                      << "type = " << type << "\njacobian_options() = " << jacobian_options());
+    return {{"type", jacobian_options().at(0)}};
+  }
+
+  using BaseType::jacobian;
+
+  /// \note The local bilinear forms are appended to jacobian_op, call jacobian_op.assemble() to obtain the matrix.
+  void jacobian(const VectorType& /*source*/,
+                MatrixOperatorType& jacobian_op,
+                const XT::Common::Configuration& opts,
+                const XT::Common::Parameter& /*param*/ = {}) const override final
+  {
+    DUNE_THROW_IF(!opts.has_key("type"), Exceptions::operator_error, opts);
+    DUNE_THROW_IF(opts.get<std::string>("type") != jacobian_options().at(0), Exceptions::operator_error, opts);
+    for (const auto& data : element_data_)
+      jacobian_op.append(*std::get<0>(data), std::get<1>(data), *std::get<2>(data));
+    for (const auto& data : coupling_intersection_data_)
+      jacobian_op.append(*std::get<0>(data), std::get<1>(data), *std::get<2>(data));
+    for (const auto& data : intersection_data_)
+      jacobian_op.append(*std::get<0>(data), std::get<1>(data), *std::get<2>(data));
+  } // ... jacobian(...)
+
+private:
+  const AssemblyGridViewType assembly_grid_view_;
+  const SourceSpaceType& source_space_;
+  const RangeSpaceType& range_space_;
+  const bool use_tbb_;
+  std::list<std::tuple<std::unique_ptr<LocalElementBilinearFormType>,
+                       XT::Common::Parameter,
+                       std::unique_ptr<ElementFilterType>>>
+      element_data_;
+  std::list<std::tuple<std::unique_ptr<LocalCouplingIntersectionBilinearFormType>,
+                       XT::Common::Parameter,
+                       std::unique_ptr<IntersectionFilterType>>>
+      coupling_intersection_data_;
+  std::list<std::tuple<std::unique_ptr<LocalIntersectionBilinearFormType>,
+                       XT::Common::Parameter,
+                       std::unique_ptr<IntersectionFilterType>>>
+      intersection_data_;
+}; // class MatrixFreeOperator
+
+
+/**
+ * \note Use as in
+\code
+auto op = make_matrix_free_operator<MatrixType>(assembly_grid_view, source_space, range_space);
+\endcode
+ */
+template <class MatrixType, class SGV, size_t s_r, size_t s_rC, class F, class RGV, size_t r_r, size_t r_rC>
+typename std::enable_if<XT::LA::is_matrix<MatrixType>::value,
+                        MatrixFreeOperator<MatrixType, SGV, s_r, s_rC, r_r, r_rC, RGV>>::type
+make_matrix_free_operator(SGV assembly_grid_view,
+                          const SpaceInterface<SGV, s_r, s_rC, F>& source_space,
+                          const SpaceInterface<RGV, r_r, r_rC, F>& range_space,
+                          const bool use_tbb = false,
+                          const std::string& logging_prefix = "")
+{
+  return MatrixFreeOperator<MatrixType, SGV, s_r, s_rC, r_r, r_rC, RGV>(
+      assembly_grid_view, source_space, range_space, use_tbb, logging_prefix);
+}
+
+/**
+ * \note Use as in
+\code
+auto op = make_matrix_free_operator<MatrixType>(space);
+\endcode
+ */
+template <class MatrixType, class GV, size_t r, size_t rC, class F>
+typename std::enable_if<XT::LA::is_matrix<MatrixType>::value, MatrixFreeOperator<MatrixType, GV, r, rC>>::type
+make_matrix_free_operator(const SpaceInterface<GV, r, rC, F>& space,
+                          const bool use_tbb = false,
+                          const std::string& logging_prefix = "")
+{
+  return MatrixFreeOperator<MatrixType, GV, r, rC>(space.grid_view(), space, space, use_tbb, logging_prefix);
+}
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_OPERATORS_MATRIX_FREE_HH
@@ -10,8 +10,8 @@
 #ifndef DUNE_GDT_OPERATORS_OSWALD_INTERPOLATION_HH
 #define DUNE_GDT_OPERATORS_OSWALD_INTERPOLATION_HH
 
+#include <limits>
 #include <map>
-#include <set>
 #include <vector>
 
 #include <dune/grid/common/rangegenerators.hh>
@@ -19,6 +19,7 @@
 #include <dune/xt/common/memory.hh>
 #include <dune/xt/grid/boundaryinfo/allneumann.hh>
 #include <dune/xt/grid/boundaryinfo/interfaces.hh>
+#include <dune/xt/grid/filters.hh>
 #include <dune/xt/grid/walker.hh>
 #include <dune/xt/grid/type_traits.hh>
 
@@ -26,6 +27,7 @@
 #include <dune/gdt/exceptions.hh>
 #include <dune/gdt/spaces/h1/continuous-lagrange.hh>
 #include <dune/gdt/tools/dirichlet-constraints.hh>
+#include <dune/gdt/tools/parallel-for.hh>
 
 #include "interfaces.hh"
 
@@ -33,6 +35,19 @@ namespace Dune {
 namespace GDT {
 
 
+/**
+ * \brief Averages a discontinuous function in the Lagrange points of a continuous Lagrange space of the same order.
+ *
+ * Upon assemble(), each DoF of the range space is associated with its global Lagrange point (the ones of a continuous
+ * Lagrange space on the assembly grid view) and the DoFs of each Lagrange point are stored in compressed row storage,
+ * together with the averaging weight of the Lagrange point (one over the number of its DoFs, zero on the Dirichlet
+ * boundary). Each application then computes the value of each DoF of the range (source value in the Lagrange point of
+ * the DoF) and averages these values per Lagrange point. The latter is a sparse matrix-vector product free of write
+ * conflicts, which runs in parallel if assemble() was called with use_tbb = true.
+ *
+ * If the source space is a discontinuous Lagrange space with the same DoFs as the range space (e.g., the same space),
+ * the source DoFs are the values in the Lagrange points and are read directly, without evaluating the source.
+ */
 template <class M,
           class AssemblyGridView,
           size_t dim = 1,
@@ -48,6 +63,7 @@ class OswaldInterpolationOperator : public OperatorInterface<M, SGV, dim, dim_co
   using ThisType = OswaldInterpolationOperator;
 
 public:
+  using typename BaseType::F;
   using typename BaseType::RangeSpaceType;
   using typename BaseType::SourceSpaceType;
   using typename BaseType::VectorType;
@@ -68,6 +84,8 @@ public:
     , range_space_(rng_spc)
     , boundary_info_(boundary_info)
     , assembled_(false)
+    , use_tbb_(false)
+    , source_DoFs_are_range_DoFs_(false)
     , global_DoF_id_to_global_LP_id_map_()
   {
     DUNE_THROW_IF(!range_space_.is_lagrangian(), Exceptions::operator_error, "This does not make any sense!");
@@ -87,6 +105,8 @@ public:
     , range_space_(rng_spc)
     , boundary_info_(new XT::Grid::AllNeumannBoundaryInfo<I>()) // Anything without Dirichlet
     , assembled_(false)
+    , use_tbb_(false)
+    , source_DoFs_are_range_DoFs_(false)
   {
     DUNE_THROW_IF(!range_space_.is_lagrangian(), Exceptions::operator_error, "This does not make any sense!");
     DUNE_THROW_IF(range_space_.continuous(0), Exceptions::operator_error, "This does not make any sense!");
@@ -119,13 +139,17 @@ public:
         range_space_.max_polorder() != order, Exceptions::operator_error, "Not implemented yet for variable orders!");
     auto cg_space = make_continuous_lagrange_space(assembly_grid_view_, order);
     // determine Dirichlet DoFs
-    DirichletConstraints<I, decltype(cg_space)> dirichlet_constraints(boundary_info_.access(), cg_space);
+    SortedDirichletConstraints<I, decltype(cg_space)> dirichlet_constraints(boundary_info_.access(), cg_space);
     auto walker = XT::Grid::make_walker(assembly_grid_view_);
-    walker.append(dirichlet_constraints);
+    // only (Dirichlet or process) boundary intersections are relevant
+    walker.append(dirichlet_constraints,
+                  XT::Grid::ApplyOn::GenericFilteredIntersections<AGV>(
+                      [](const AGV& /*grid_view*/, const I& intersection) {
+                        return intersection.boundary() || !intersection.neighbor();
+                      }));
     walker.walk(use_tbb);
-    boundary_LPs_ = std::move(dirichlet_constraints.dirichlet_DoFs());
-    global_LP_id_to_global_DoF_id_map_.resize(cg_space.mapper().size());
     global_DoF_id_to_global_LP_id_map_.resize(range_space_.mapper().size(), std::numeric_limits<size_t>::max());
+    source_DoFs_are_range_DoFs_ = source_DoFs_are_range_DoFs(order);
     DynamicVector<size_t> global_lagrange_point_indices(cg_space.mapper().max_local_size());
     DynamicVector<size_t> global_DoF_indices(range_space_.mapper().max_local_size());
     // walk the grid
@@ -140,13 +164,32 @@ public:
                         << "\nlagrange_points.size() = " << lagrange_points.size());
       cg_space.mapper().global_indices(element, global_lagrange_point_indices);
       range_space_.mapper().global_indices(element, global_DoF_indices);
-      for (size_t ii = 0; ii < lagrange_points.size(); ++ii) {
-        const auto global_LP_id = global_lagrange_point_indices[ii];
-        const auto global_DoF_id = global_DoF_indices[ii];
-        global_LP_id_to_global_DoF_id_map_[global_LP_id].insert(global_DoF_id);
-        global_DoF_id_to_global_LP_id_map_[global_DoF_id] = global_LP_id;
-      }
+      for (size_t ii = 0; ii < lagrange_points.size(); ++ii)
+        global_DoF_id_to_global_LP_id_map_[global_DoF_indices[ii]] = global_lagrange_point_indices[ii];
     }
+    // the DoFs of each Lagrange point, in compressed row storage (in increasing order per Lagrange point)
+    const size_t num_LPs = cg_space.mapper().size();
+    global_LP_id_offsets_.assign(num_LPs + 1, 0);
+    for (const auto& global_LP_id : global_DoF_id_to_global_LP_id_map_)
+      if (global_LP_id != std::numeric_limits<size_t>::max())
+        ++global_LP_id_offsets_[global_LP_id + 1];
+    for (size_t pp = 0; pp < num_LPs; ++pp)
+      global_LP_id_offsets_[pp + 1] += global_LP_id_offsets_[pp];
+    global_LP_id_to_global_DoF_ids_.resize(global_LP_id_offsets_[num_LPs]);
+    std::vector<size_t> fill(global_LP_id_offsets_.begin(), global_LP_id_offsets_.end() - 1);
+    for (size_t global_DoF_id = 0; global_DoF_id < global_DoF_id_to_global_LP_id_map_.size(); ++global_DoF_id) {
+      const auto global_LP_id = global_DoF_id_to_global_LP_id_map_[global_DoF_id];
+      if (global_LP_id != std::numeric_limits<size_t>::max())
+        global_LP_id_to_global_DoF_ids_[fill[global_LP_id]++] = global_DoF_id;
+    }
+    // the averaging weights, the range is set to zero on the Dirichlet boundary
+    global_LP_weights_.assign(num_LPs, 0.);
+    for (size_t pp = 0; pp < num_LPs; ++pp)
+      if (global_LP_id_offsets_[pp + 1] > global_LP_id_offsets_[pp])
+        global_LP_weights_[pp] = 1. / (global_LP_id_offsets_[pp + 1] - global_LP_id_offsets_[pp]);
+    for (const auto& global_LP_id : dirichlet_constraints.dirichlet_DoFs())
+      global_LP_weights_[global_LP_id] = 0.;
+    use_tbb_ = use_tbb;
     assembled_ = true;
     return *this;
   } // ... assemble(...)
@@ -161,15 +204,16 @@ public:
     DUNE_THROW_IF(!source.valid(), Exceptions::operator_error, "source contains inf or nan!");
     DUNE_THROW_IF(!source_space_.contains(source), Exceptions::operator_error, "");
     DUNE_THROW_IF(!range_space_.contains(range), Exceptions::operator_error, "");
+    if (source_DoFs_are_range_DoFs_) {
+      average(source, range);
+      return;
+    }
+    // evaluate the source in the Lagrange point of each DoF associated with assembly_grid_view_
+    // (might only be a subset of the range DoFs, the others are left untouched)
     const auto source_function = make_discrete_function(source_space_, source);
     auto local_source = source_function.local_function();
     DynamicVector<size_t> global_DoF_indices(range_space_.mapper().max_local_size());
-    // clear range on those DoFs associated with assembly_grid_view_ individually
-    // (might only be a subset, range *= 0 would clear too much)
-    for (const auto& DoF_id : global_DoF_id_to_global_LP_id_map_)
-      if (DoF_id != std::numeric_limits<size_t>::max())
-        range[DoF_id] = 0;
-    // walk the grid to average on all inner Lagrange points
+    std::vector<F> values_in_lagrange_points(range_space_.mapper().size(), 0.);
     auto range_basis = range_space_.basis().localize();
     for (auto&& element : elements(assembly_grid_view_)) {
       local_source->bind(element);
@@ -181,32 +225,76 @@ public:
                     "This should not happen, the range_space is broken:\n"
                         << "global_DoF_indices.size() = " << global_DoF_indices.size() << "\n"
                         << "lagrange_points.size() = " << lagrange_points.size());
-      for (size_t ii = 0; ii < lagrange_points.size(); ++ii) {
-        const auto& lagrange_point = lagrange_points[ii];
-        const auto global_DoF_id = global_DoF_indices[ii];
-        const auto global_LP_id = global_DoF_id_to_global_LP_id_map_.at(global_DoF_id);
-        const auto& DoFs_per_global_LP = global_LP_id_to_global_DoF_id_map_.at(global_LP_id);
-        const auto source_value = local_source->evaluate(lagrange_point)[0] / DoFs_per_global_LP.size();
-        for (const auto& DoF_id : DoFs_per_global_LP) {
-          range[DoF_id] += source_value;
-        }
-      }
+      for (size_t ii = 0; ii < lagrange_points.size(); ++ii)
+        values_in_lagrange_points[global_DoF_indices[ii]] = local_source->evaluate(lagrange_points[ii])[0];
     }
-    // set Dirichlet DoFs to zero
-    for (const auto& global_LP_id : boundary_LPs_)
-      for (const auto& global_DoF_id : global_LP_id_to_global_DoF_id_map_.at(global_LP_id))
-        range[global_DoF_id] = 0;
+    average(values_in_lagrange_points, range);
   } // ... apply(...)
 
 private:
+  /**
+   * The source DoFs can only be the values in the Lagrange points of the range DoFs for the same kind of space, with
+   * the same DoF numbering on each element of the assembly grid view (given if both are the same space).
+   */
+  bool source_DoFs_are_range_DoFs(const int order) const
+  {
+    if (source_space_.type() != SpaceType::discontinuous_lagrange || source_space_.min_polorder() != order
+        || source_space_.max_polorder() != order || source_space_.mapper().size() != range_space_.mapper().size())
+      return false;
+    if (static_cast<const void*>(&source_space_) == static_cast<const void*>(&range_space_))
+      return true;
+    DynamicVector<size_t> global_source_DoF_indices(source_space_.mapper().max_local_size());
+    DynamicVector<size_t> global_DoF_indices(range_space_.mapper().max_local_size());
+    for (auto&& element : elements(assembly_grid_view_)) {
+      const size_t local_size = range_space_.mapper().local_size(element);
+      if (source_space_.mapper().local_size(element) != local_size)
+        return false;
+      source_space_.mapper().global_indices(element, global_source_DoF_indices);
+      range_space_.mapper().global_indices(element, global_DoF_indices);
+      for (size_t ii = 0; ii < local_size; ++ii)
+        if (global_source_DoF_indices[ii] != global_DoF_indices[ii])
+          return false;
+    }
+    return true;
+  } // ... source_DoFs_are_range_DoFs(...)
+
+  /**
+   * Sets each range DoF to the weighted sum of the values of all DoFs of its Lagrange point. Each Lagrange point only
+   * reads and writes its own DoFs, so the Lagrange points can be processed concurrently (and values may be range).
+   */
+  template <class ValuesType>
+  void average(const ValuesType& values, VectorType& range) const
+  {
+    if (global_LP_id_to_global_DoF_ids_.empty())
+      return;
+    ensure_unshared_data(range);
+    parallel_for_chunks(
+        0,
+        global_LP_weights_.size(),
+        [&](const size_t first, const size_t last) {
+          for (size_t pp = first; pp < last; ++pp) {
+            F value = 0.;
+            for (size_t jj = global_LP_id_offsets_[pp]; jj < global_LP_id_offsets_[pp + 1]; ++jj)
+              value += values[global_LP_id_to_global_DoF_ids_[jj]];
+            value *= global_LP_weights_[pp];
+            for (size_t jj = global_LP_id_offsets_[pp]; jj < global_LP_id_offsets_[pp + 1]; ++jj)
+              range[global_LP_id_to_global_DoF_ids_[jj]] = value;
+          }
+        },
+        use_tbb_);
+  } // ... average(...)
+
   const AssemblyGridViewType assembly_grid_view_;
   const SourceSpaceType& source_space_;
   const RangeSpaceType& range_space_;
   const XT::Common::ConstStorageProvider<XT::Grid::BoundaryInfo<I>> boundary_info_;
   bool assembled_;
+  bool use_tbb_;
+  bool source_DoFs_are_range_DoFs_;
   std::vector<size_t> global_DoF_id_to_global_LP_id_map_;
-  std::vector<std::set<size_t>> global_LP_id_to_global_DoF_id_map_;
-  std::set<size_t> boundary_LPs_;
+  std::vector<size_t> global_LP_id_offsets_;
+  std::vector<size_t> global_LP_id_to_global_DoF_ids_;
+  std::vector<F> global_LP_weights_;
 }; // class OswaldInterpolationOperator
 
 
@@ -0,0 +1,122 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#ifndef DUNE_GDT_OPERATORS_RECONSTRUCTION_FLUX_EIGEN_DECOMPOSITIONS_HH
+#define DUNE_GDT_OPERATORS_RECONSTRUCTION_FLUX_EIGEN_DECOMPOSITIONS_HH
+
+#include <cmath>
+
+#include <dune/common/fvector.hh>
+
+#include <dune/xt/common/matrix.hh>
+#include <dune/xt/common/parameter.hh>
+
+#include <dune/gdt/tools/euler.hh>
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief Closed form eigendecomposition of the jacobians of the Euler flux, to be used in the linear reconstruction.
+ *
+ * Returns a lambda computing the eigenvectors T of A_dd(u) and their inverse in conservative variables, using
+ * EulerTools (instead of a general eigensolver and a QR decomposition of T in each cell, see
+ * internal::EigenvectorWrapper). Only available in 1d and 2d.
+ *
+ * \sa LinearReconstructionOperator
+ */
+template <size_t d, class R>
+auto make_euler_flux_eigen_decomposition(const EulerTools<d, R>& euler_tools)
+{
+  static_assert(d <= 2, "EulerTools only provides the eigenvectors of the flux jacobian in 1d and 2d!");
+  return [euler_tools](const auto& u,
+                       const size_t dd,
+                       auto& eigenvectors,
+                       auto& eigenvectors_inverse,
+                       const XT::Common::Parameter& /*param*/) {
+    static constexpr size_t m = EulerTools<d, R>::m;
+    FieldVector<R, m> w;
+    for (size_t ii = 0; ii < m; ++ii)
+      w[ii] = u[ii];
+    DUNE_THROW_IF(!(euler_tools.density(w)[0] > 0.) || !(euler_tools.pressure(w)[0] > 0.),
+                  Dune::MathError,
+                  "Density and pressure have to be positive!\n   w = " << w);
+    FieldVector<double, d> n(0.);
+    n[dd] = 1.;
+    const auto T = euler_tools.eigenvectors_flux_jacobian(w, n);
+    const auto T_inv = euler_tools.eigenvectors_inv_flux_jacobian(w, n);
+    for (size_t ii = 0; ii < m; ++ii)
+      for (size_t jj = 0; jj < m; ++jj) {
+        XT::Common::set_matrix_entry(eigenvectors, ii, jj, T[ii][jj]);
+        XT::Common::set_matrix_entry(eigenvectors_inverse, ii, jj, T_inv[ii][jj]);
+      }
+  };
+} // ... make_euler_flux_eigen_decomposition(...)
+
+
+/**
+ * \brief Closed form eigendecomposition of the jacobians of the shallow water flux, to be used in the linear
+ *        reconstruction.
+ *
+ * For the conservative variables u = (h, h v_1, ..., h v_d) and the flux f_dd(u) = (h v_dd, h v_dd v + 0.5 g h^2 e_dd),
+ * the jacobian A_dd(u) has the eigenvalues v_dd - c, v_dd (d - 1 times) and v_dd + c, with c = sqrt(g h), and the
+ * eigenvectors (1, v - c e_dd), e_k (k != dd) and (1, v + c e_dd).
+ *
+ * \sa make_euler_flux_eigen_decomposition
+ */
+template <size_t d, class R = double>
+auto make_shallow_water_flux_eigen_decomposition(const R& gravity = 9.81)
+{
+  return [gravity](const auto& u,
+                   const size_t dd,
+                   auto& eigenvectors,
+                   auto& eigenvectors_inverse,
+                   const XT::Common::Parameter& /*param*/) {
+    static constexpr size_t m = d + 1;
+    const R h = u[0];
+    DUNE_THROW_IF(!(h > 0.), Dune::MathError, "The water height has to be positive!\n   h = " << h);
+    FieldVector<R, d> v;
+    for (size_t kk = 0; kk < d; ++kk)
+      v[kk] = u[kk + 1] / h;
+    const R c = std::sqrt(gravity * h);
+    for (size_t ii = 0; ii < m; ++ii)
+      for (size_t jj = 0; jj < m; ++jj) {
+        XT::Common::set_matrix_entry(eigenvectors, ii, jj, 0.);
+        XT::Common::set_matrix_entry(eigenvectors_inverse, ii, jj, 0.);
+      }
+    // the acoustic waves: first and last column of T, first and last row of T^{-1}
+    XT::Common::set_matrix_entry(eigenvectors, 0, 0, 1.);
+    XT::Common::set_matrix_entry(eigenvectors, 0, m - 1, 1.);
+    for (size_t kk = 0; kk < d; ++kk) {
+      XT::Common::set_matrix_entry(eigenvectors, kk + 1, 0, v[kk] - (kk == dd ? c : 0.));
+      XT::Common::set_matrix_entry(eigenvectors, kk + 1, m - 1, v[kk] + (kk == dd ? c : 0.));
+    }
+    XT::Common::set_matrix_entry(eigenvectors_inverse, 0, 0, (v[dd] + c) / (2. * c));
+    XT::Common::set_matrix_entry(eigenvectors_inverse, 0, dd + 1, -1. / (2. * c));
+    XT::Common::set_matrix_entry(eigenvectors_inverse, m - 1, 0, (c - v[dd]) / (2. * c));
+    XT::Common::set_matrix_entry(eigenvectors_inverse, m - 1, dd + 1, 1. / (2. * c));
+    // the shear waves
+    size_t col = 1;
+    for (size_t kk = 0; kk < d; ++kk) {
+      if (kk == dd)
+        continue;
+      XT::Common::set_matrix_entry(eigenvectors, kk + 1, col, 1.);
+      XT::Common::set_matrix_entry(eigenvectors_inverse, col, 0, -v[kk]);
+      XT::Common::set_matrix_entry(eigenvectors_inverse, col, kk + 1, 1.);
+      ++col;
+    }
+  };
+} // ... make_shallow_water_flux_eigen_decomposition(...)
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_OPERATORS_RECONSTRUCTION_FLUX_EIGEN_DECOMPOSITIONS_HH
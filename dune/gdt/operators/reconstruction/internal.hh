@@ -11,6 +11,11 @@
 #ifndef DUNE_GDT_OPERATORS_RECONSTRUCTION_INTERNAL_HH
 #define DUNE_GDT_OPERATORS_RECONSTRUCTION_INTERNAL_HH
 
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
 #include <dune/xt/common/debug.hh>
 #include <dune/xt/common/fvector.hh>
 #include <dune/xt/common/lapacke.hh>
@@ -66,12 +71,27 @@ public:
   using LocalFluxType = typename AnalyticalFluxType::LocalFunctionType;
   using FluxDomainType = XT::Common::FieldVector<typename AnalyticalFluxType::D, dimRange>;
 
-  EigenvectorWrapperBase(const AnalyticalFluxType& analytical_flux, const bool flux_is_affine)
+  // Computes the eigenvectors of the jacobian of the (x-independent) flux in direction dd at u and their inverse in
+  // closed form, see flux-eigen-decompositions.hh. Should throw a Dune::MathError if u is not admissible.
+  using FluxEigenDecompositionLambdaType = std::function<void(const VectorType& /*u*/,
+                                                              const size_t /*dd*/,
+                                                              MatrixType& /*eigenvectors*/,
+                                                              MatrixType& /*eigenvectors_inverse*/,
+                                                              const XT::Common::Parameter& /*param*/)>;
+
+  EigenvectorWrapperBase(const AnalyticalFluxType& analytical_flux,
+                         const bool flux_is_affine,
+                         FluxEigenDecompositionLambdaType flux_eigen_decomposition = {})
     : analytical_flux_(analytical_flux)
     , local_flux_(analytical_flux_.local_function())
     , flux_is_affine_(flux_is_affine)
+    , flux_eigen_decomposition_(flux_eigen_decomposition)
     , computed_(false)
-  {}
+  {
+    DUNE_THROW_IF(flux_eigen_decomposition_ && analytical_flux_.x_dependent(),
+                  Dune::NotImplemented,
+                  "Closed form eigendecompositions are not available for x-dependent fluxes!");
+  }
 
   virtual ~EigenvectorWrapperBase() {}
 
@@ -80,10 +100,25 @@ public:
                                     const VectorType& u,
                                     const XT::Common::Parameter& param)
   {
-    if (!computed_ || !flux_is_affine_) {
-      compute_eigenvectors_impl(entity, x_local, u, param);
-      computed_ = true;
-    }
+    // the eigenvectors of affine fluxes do not depend on u, the ones of x-independent fluxes only on u and param
+    // (neighboring cells often share their state, e.g. away from shocks)
+    if (computed_ && (flux_is_affine_ || (!analytical_flux_.x_dependent() && same_state(u, param))))
+      return;
+    compute_eigenvectors_impl(entity, x_local, u, param);
+    computed_ = true;
+    last_u_ = u;
+    remember_param(param);
+  }
+
+  // Called by the linear reconstruction with the states of all cells, which allows to decompose several cells at once
+  // (see BatchedEigenvectorWrapper).
+  virtual void compute_eigenvectors_of_cell(const size_t cell_index,
+                                            const E& entity,
+                                            const DomainType& x_local,
+                                            const std::vector<VectorType>& cell_states,
+                                            const XT::Common::Parameter& param)
+  {
+    compute_eigenvectors(entity, x_local, cell_states[cell_index], param);
   }
 
   virtual void compute_eigenvectors_impl(const E& entity,
@@ -102,11 +137,51 @@ public:
     return flux_is_affine_;
   }
 
+  const FluxEigenDecompositionLambdaType& flux_eigen_decomposition() const
+  {
+    return flux_eigen_decomposition_;
+  }
+
 protected:
+  bool same_state(const VectorType& u, const XT::Common::Parameter& param) const
+  {
+    for (size_t ii = 0; ii < dimRange; ++ii)
+      if (u[ii] != last_u_[ii])
+        return false;
+    if (param.keys() != last_param_keys_)
+      return false;
+    size_t offset = 0;
+    for (const auto& key : last_param_keys_) {
+      const auto& values = param.get(key);
+      if (offset + values.size() > last_param_values_.size()
+          || !std::equal(values.begin(), values.end(), last_param_values_.begin() + offset))
+        return false;
+      offset += values.size();
+    }
+    return offset == last_param_values_.size();
+  } // ... same_state(...)
+
+  // Stores the values of param contiguously, reusing the storage of the previous call (the keys are only copied if
+  // they change, which they usually do not).
+  void remember_param(const XT::Common::Parameter& param)
+  {
+    if (param.keys() != last_param_keys_)
+      last_param_keys_ = param.keys();
+    last_param_values_.clear();
+    for (const auto& key : last_param_keys_) {
+      const auto& values = param.get(key);
+      last_param_values_.insert(last_param_values_.end(), values.begin(), values.end());
+    }
+  } // ... remember_param(...)
+
   const AnalyticalFluxType& analytical_flux_;
   const std::unique_ptr<LocalFluxType> local_flux_;
   const bool flux_is_affine_;
+  const FluxEigenDecompositionLambdaType flux_eigen_decomposition_;
   bool computed_;
+  VectorType last_u_;
+  std::vector<std::string> last_param_keys_;
+  std::vector<double> last_param_values_;
 }; // class EigenvectorWrapperBase<...>
 
 template <class AnalyticalFluxType, class MatrixImp, class VectorImp>
@@ -125,10 +200,13 @@ class DummyEigenVectorWrapper : public EigenvectorWrapperBase<AnalyticalFluxType
 public:
   using typename BaseType::DomainType;
   using typename BaseType::E;
+  using typename BaseType::FluxEigenDecompositionLambdaType;
   using typename BaseType::MatrixType;
   using typename BaseType::VectorType;
 
-  DummyEigenVectorWrapper(const AnalyticalFluxType& analytical_flux, const bool flux_is_affine)
+  DummyEigenVectorWrapper(const AnalyticalFluxType& analytical_flux,
+                          const bool flux_is_affine,
+                          FluxEigenDecompositionLambdaType /*flux_eigen_decomposition*/ = {})
     : BaseType(analytical_flux, flux_is_affine)
   {}
 
@@ -181,11 +259,14 @@ public:
   using BaseType::dimRange;
   using typename BaseType::DomainType;
   using typename BaseType::E;
+  using typename BaseType::FluxEigenDecompositionLambdaType;
   using typename BaseType::RangeFieldType;
   using JacobianType = DynamicVector<MatrixType>;
 
-  EigenvectorWrapper(const AnalyticalFluxType& analytical_flux, const bool flux_is_affine)
-    : BaseType(analytical_flux, flux_is_affine)
+  EigenvectorWrapper(const AnalyticalFluxType& analytical_flux,
+                     const bool flux_is_affine,
+                     FluxEigenDecompositionLambdaType flux_eigen_decomposition = {})
+    : BaseType(analytical_flux, flux_is_affine, flux_eigen_decomposition)
     , work_(1)
     , scale_(dimRange)
     , rconde_(dimRange)
@@ -198,6 +279,11 @@ public:
     , QR_(std::make_unique<JacobianType>(dimDomain, MatrixType(dimRange, dimRange, 0., 0)))
     , tau_(V::create(dimRange))
   {
+    if (flux_eigen_decomposition_) {
+      // no general eigensolves or QR decompositions required
+      eigenvectors_inverse_ = std::make_unique<JacobianType>(dimDomain, MatrixType(dimRange, dimRange, 0., 0));
+      return;
+    }
 #if HAVE_MKL || HAVE_LAPACKE
     int ilo, ihi;
     double norm;
@@ -238,6 +324,19 @@ public:
                                  const VectorType& u,
                                  const XT::Common::Parameter& param) override final
   {
+    if (flux_eigen_decomposition_) {
+      try {
+        for (size_t dd = 0; dd < dimDomain; ++dd)
+          flux_eigen_decomposition_(u, dd, (*eigenvectors_)[dd], (*eigenvectors_inverse_)[dd], param);
+      } catch (const Dune::MathError&) {
+        // use scalar limiters, as below
+        for (size_t dd = 0; dd < dimDomain; ++dd) {
+          XT::LA::eye_matrix((*eigenvectors_)[dd]);
+          XT::LA::eye_matrix((*eigenvectors_inverse_)[dd]);
+        }
+      }
+      return;
+    }
     local_flux_->bind(entity);
     try {
       local_flux_->jacobian(x_local, u, *jacobian_, param);
@@ -317,6 +416,10 @@ public:
 
   void apply_inverse_eigenvectors(const size_t dd, const VectorType& u, VectorType& ret) const override final
   {
+    if (eigenvectors_inverse_) {
+      (*eigenvectors_inverse_)[dd].mv(u, ret);
+      return;
+    }
     thread_local VectorType work = V::create(dimRange);
     XT::LA::solve_qr_factorized((*QR_)[dd], tau_[dd], permutations_[dd], ret, u, &work);
   }
@@ -328,12 +431,14 @@ public:
 
 protected:
   using BaseType::computed_;
+  using BaseType::flux_eigen_decomposition_;
   using BaseType::flux_is_affine_;
   using BaseType::local_flux_;
   std::vector<RangeFieldType> work_, scale_, rconde_, rcondv_;
   std::vector<int> iwork_;
   std::unique_ptr<JacobianType> jacobian_;
   std::unique_ptr<JacobianType> eigenvectors_;
+  std::unique_ptr<JacobianType> eigenvectors_inverse_; // only with a closed form eigendecomposition
   RangeFieldType eigenvectors_rcond_;
   FieldVector<std::vector<RangeFieldType>, dimDomain> eigenvalues_;
   FieldVector<RangeFieldType, dimRange> dummy_complex_eigenvalues_;
@@ -343,6 +448,175 @@ protected:
 }; // class EigenvectorWrapper<...>
 
 
+/**
+ * \brief Computes real eigendecompositions A = T diag(lambda) T^{-1} of many small matrices with compile-time sizes.
+ *
+ * Uses the QR based eigensolver for FieldMatrix of dune-xt-la (only falling back to the default eigensolver if it
+ * fails) and does not call into LAPACK, the overhead of which dominates for small m. If a decomposition fails or the
+ * eigenvectors are badly conditioned, T = T^{-1} = I is used for this matrix (i.e., scalar limiting, as in
+ * EigenvectorWrapper).
+ */
+template <class R, size_t m>
+void batched_real_eigendecompositions(const size_t num_matrices,
+                                      const XT::Common::FieldMatrix<R, m, m>* matrices,
+                                      XT::Common::FieldMatrix<R, m, m>* eigenvectors,
+                                      XT::Common::FieldMatrix<R, m, m>* eigenvectors_inverse)
+{
+  using MatrixType = XT::Common::FieldMatrix<R, m, m>;
+  std::vector<double> eigenvalues(m);
+  MatrixType matrix;
+  for (size_t kk = 0; kk < num_matrices; ++kk) {
+    auto& T = eigenvectors[kk];
+    auto& T_inv = eigenvectors_inverse[kk];
+    try {
+      try {
+        matrix = matrices[kk];
+        XT::LA::internal::fmatrix_compute_real_eigenvalues_and_real_right_eigenvectors_using_qr(matrix, eigenvalues, T);
+      } catch (const Dune::MathError&) {
+        // not shared between threads, only needed in the rare case of a failing QR iteration
+        auto eigensolver_options = hyperbolic_default_eigensolver_options<MatrixType>();
+        const auto eigensolver = XT::LA::EigenSolver<MatrixType>(matrices[kk], &eigensolver_options);
+        T = eigensolver.real_eigenvectors();
+      }
+      T_inv = T;
+      T_inv.invert();
+      DUNE_THROW_IF(T.infinity_norm() * T_inv.infinity_norm() > 1e5,
+                    Dune::MathError,
+                    "Eigenvector condition too high!");
+    } catch (const Dune::MathError&) {
+      XT::LA::eye_matrix(T);
+      XT::LA::eye_matrix(T_inv);
+    }
+  }
+} // ... batched_real_eigendecompositions(...)
+
+
+/**
+ * \brief Eigenvector wrapper for x-independent fluxes, which decomposes the jacobians of batch_size cells at once (see
+ *        batched_real_eigendecompositions).
+ *
+ * The eigenvectors of a cell are taken from the current batch if it contains the cell, otherwise the jacobians of the
+ * next batch_size cells (by index, starting with this one) are decomposed. Since the grid walkers mostly visit the
+ * elements in index order, almost all cells hit the current batch. Works without LAPACK.
+ */
+template <class AnalyticalFluxType, size_t batch_size = 64>
+class BatchedEigenvectorWrapper
+  : public EigenvectorWrapperBase<
+        AnalyticalFluxType,
+        XT::Common::FieldMatrix<typename AnalyticalFluxType::R, AnalyticalFluxType::rC, AnalyticalFluxType::rC>,
+        FieldVector<typename AnalyticalFluxType::R, AnalyticalFluxType::rC>>
+{
+  using BaseType = EigenvectorWrapperBase<
+      AnalyticalFluxType,
+      XT::Common::FieldMatrix<typename AnalyticalFluxType::R, AnalyticalFluxType::rC, AnalyticalFluxType::rC>,
+      FieldVector<typename AnalyticalFluxType::R, AnalyticalFluxType::rC>>;
+  static_assert(batch_size > 0, "");
+
+public:
+  using BaseType::dimDomain;
+  using BaseType::dimRange;
+  using typename BaseType::DomainType;
+  using typename BaseType::E;
+  using typename BaseType::FluxEigenDecompositionLambdaType;
+  using typename BaseType::MatrixType;
+  using typename BaseType::RangeFieldType;
+  using typename BaseType::VectorType;
+
+  BatchedEigenvectorWrapper(const AnalyticalFluxType& analytical_flux,
+                            const bool flux_is_affine,
+                            FluxEigenDecompositionLambdaType flux_eigen_decomposition = {})
+    : BaseType(analytical_flux, flux_is_affine)
+    , jacobian_(dimDomain)
+    , jacobians_(dimDomain * batch_size)
+    , eigenvectors_(dimDomain * batch_size)
+    , eigenvectors_inverse_(dimDomain * batch_size)
+    , batch_begin_(0)
+    , batch_end_(0)
+    , current_(0)
+  {
+    DUNE_THROW_IF(analytical_flux.x_dependent(), Dune::NotImplemented, "Not available for x-dependent fluxes!");
+    DUNE_THROW_IF(flux_eigen_decomposition,
+                  Dune::NotImplemented,
+                  "Use EigenvectorWrapper for closed form eigendecompositions!");
+  }
+
+  void compute_eigenvectors_of_cell(const size_t cell_index,
+                                    const E& entity,
+                                    const DomainType& x_local,
+                                    const std::vector<VectorType>& cell_states,
+                                    const XT::Common::Parameter& param) override final
+  {
+    if (flux_is_affine_ && computed_)
+      return;
+    if (!(batch_begin_ <= cell_index && cell_index < batch_end_)) {
+      const size_t num_cells = flux_is_affine_ ? 1 : std::min(batch_size, cell_states.size() - cell_index);
+      decompose(entity, x_local, cell_states.data() + cell_index, num_cells, param);
+      batch_begin_ = cell_index;
+      batch_end_ = cell_index + num_cells;
+      computed_ = true;
+    }
+    current_ = cell_index - batch_begin_;
+  } // ... compute_eigenvectors_of_cell(...)
+
+  void compute_eigenvectors_impl(const E& entity,
+                                 const DomainType& x_local,
+                                 const VectorType& u,
+                                 const XT::Common::Parameter& param) override final
+  {
+    decompose(entity, x_local, &u, 1, param);
+    batch_begin_ = batch_end_ = current_ = 0;
+  }
+
+  void apply_eigenvectors(const size_t dd, const VectorType& u, VectorType& ret) const override final
+  {
+    eigenvectors_[dd * batch_size + current_].mv(u, ret);
+  }
+
+  void apply_inverse_eigenvectors(const size_t dd, const VectorType& u, VectorType& ret) const override final
+  {
+    eigenvectors_inverse_[dd * batch_size + current_].mv(u, ret);
+  }
+
+  const MatrixType& eigenvectors(const size_t dd) const override final
+  {
+    return eigenvectors_[dd * batch_size + current_];
+  }
+
+private:
+  void decompose(const E& entity,
+                 const DomainType& x_local,
+                 const VectorType* states,
+                 const size_t num_cells,
+                 const XT::Common::Parameter& param)
+  {
+    // the flux is x-independent, so any entity will do
+    local_flux_->bind(entity);
+    for (size_t kk = 0; kk < num_cells; ++kk) {
+      local_flux_->jacobian(x_local, states[kk], jacobian_, param);
+      for (size_t dd = 0; dd < dimDomain; ++dd)
+        jacobians_[dd * batch_size + kk] = jacobian_[dd];
+    }
+    for (size_t dd = 0; dd < dimDomain; ++dd)
+      batched_real_eigendecompositions<RangeFieldType, dimRange>(num_cells,
+                                                                 jacobians_.data() + dd * batch_size,
+                                                                 eigenvectors_.data() + dd * batch_size,
+                                                                 eigenvectors_inverse_.data() + dd * batch_size);
+  } // ... decompose(...)
+
+  using BaseType::computed_;
+  using BaseType::flux_is_affine_;
+  using BaseType::local_flux_;
+  DynamicVector<MatrixType> jacobian_;
+  // the matrices of cell kk of the batch in direction dd are stored at dd * batch_size + kk
+  std::vector<MatrixType> jacobians_;
+  std::vector<MatrixType> eigenvectors_;
+  std::vector<MatrixType> eigenvectors_inverse_;
+  size_t batch_begin_;
+  size_t batch_end_;
+  size_t current_;
+}; // class BatchedEigenvectorWrapper<...>
+
+
 template <class AnalyticalFluxType, size_t block_size = (AnalyticalFluxType::r == 1) ? 2 : 4>
 class BlockedEigenvectorWrapper
   : public EigenvectorWrapperBase<
@@ -375,12 +649,17 @@ public:
   using LocalV = typename XT::Common::VectorAbstraction<LocalVectorType>;
   using NonblockedJacobianType = DynamicVector<XT::LA::CommonDenseMatrix<RangeFieldType>>;
 
-  BlockedEigenvectorWrapper(const AnalyticalFluxType& analytical_flux, const bool flux_is_affine)
+  BlockedEigenvectorWrapper(const AnalyticalFluxType& analytical_flux,
+                            const bool flux_is_affine,
+                            typename BaseType::FluxEigenDecompositionLambdaType flux_eigen_decomposition = {})
     : BaseType(analytical_flux, flux_is_affine)
     , jacobian_(std::make_unique<JacobianType>())
     , nonblocked_jacobian_(std::make_unique<NonblockedJacobianType>(
           dimDomain, XT::LA::CommonDenseMatrix<RangeFieldType>(dimRange, dimRange, 0., 0)))
   {
+    DUNE_THROW_IF(flux_eigen_decomposition,
+                  Dune::NotImplemented,
+                  "Closed form eigendecompositions are not available for blocked jacobians!");
     std::fill_n(&(eigenvalues_[0][0]), dimDomain * num_blocks, std::vector<double>(block_size, 0.));
   }
 
@@ -22,6 +22,7 @@
 #include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
 #include <dune/gdt/tools/discretevalued-grid-function.hh>
 
+#include "flux-eigen-decompositions.hh"
 #include "slopes.hh"
 #include "internal.hh"
 
@@ -39,6 +40,7 @@ public:
   using typename BaseType::E;
   using SlopeType = SlopeBase<E, EigenvectorWrapperType>;
   using LocalVectorType = typename EigenvectorWrapperType::VectorType;
+  using FluxEigenDecompositionLambdaType = typename EigenvectorWrapperType::FluxEigenDecompositionLambdaType;
   using StencilType = DynamicVector<LocalVectorType>;
   using StencilsType = std::vector<StencilType>;
   using DomainType = typename BoundaryValueType::DomainType;
@@ -52,7 +54,8 @@ public:
                             const AnalyticalFluxType& analytical_flux,
                             const SlopeType& slope,
                             const XT::Common::Parameter& param,
-                            const bool flux_is_affine = false)
+                            const bool flux_is_affine = false,
+                            const FluxEigenDecompositionLambdaType& flux_eigen_decomposition = {})
 
     : grid_view_(grid_view)
     , source_values_(source_values)
@@ -60,7 +63,7 @@ public:
     , analytical_flux_(analytical_flux)
     , slope_(slope.copy())
     , param_(param)
-    , eigenvector_wrapper_(analytical_flux, flux_is_affine)
+    , eigenvector_wrapper_(analytical_flux, flux_is_affine, flux_eigen_decomposition)
     , slopes_(d)
     , stencils_(d, StencilType(stencil_size))
   {}
@@ -73,7 +76,8 @@ public:
     , analytical_flux_(other.analytical_flux_)
     , slope_(other.slope_->copy())
     , param_(other.param_)
-    , eigenvector_wrapper_(analytical_flux_, other.eigenvector_wrapper_.affine())
+    , eigenvector_wrapper_(
+          analytical_flux_, other.eigenvector_wrapper_.affine(), other.eigenvector_wrapper_.flux_eigen_decomposition())
     , slopes_(d)
     , stencils_(d, StencilType(stencil_size))
   {}
@@ -98,7 +102,7 @@ public:
     if (analytical_flux_.x_dependent())
       x_local_ = entity.geometry().local(entity.geometry().center());
     const auto entity_index = grid_view_.indexSet().index(entity);
-    eigenvector_wrapper_.compute_eigenvectors(entity, x_local_, source_values_[entity_index], param_);
+    eigenvector_wrapper_.compute_eigenvectors_of_cell(entity_index, entity, x_local_, source_values_, param_);
 
     for (size_t dd = 0; dd < d; ++dd) {
       // no need to reconstruct in all directions, as we are only regarding the center of the face, which will
@@ -167,19 +171,28 @@ class LocalPointwiseLinearReconstructionOperator : public XT::Grid::ElementFunct
   using LocalVectorType = typename EigenvectorWrapperType::VectorType;
   using SlopeType = SlopeBase<EntityType, EigenvectorWrapperType>;
   using SlopeFunctorType = LinearSlopeElementFunctor<AnalyticalFluxType, BoundaryValueType, GV, EigenvectorWrapperType>;
+  using FluxEigenDecompositionLambdaType = typename SlopeFunctorType::FluxEigenDecompositionLambdaType;
   using ReconstructedFunctionType = DiscreteValuedGridFunction<GV, dimRange, 1, RangeFieldType>;
 
 public:
-  explicit LocalPointwiseLinearReconstructionOperator(ReconstructedFunctionType& reconstructed_function,
-                                                      const GV& grid_view,
-                                                      const std::vector<LocalVectorType>& source_values,
-                                                      const BoundaryValueType& boundary_values,
-                                                      const AnalyticalFluxType& analytical_flux,
-                                                      const SlopeType& slope,
-                                                      const XT::Common::Parameter& param,
-                                                      const bool flux_is_affine = false)
-    : slope_functor_(std::make_unique<SlopeFunctorType>(
-        grid_view, source_values, boundary_values, analytical_flux, slope, param, flux_is_affine))
+  explicit LocalPointwiseLinearReconstructionOperator(
+      ReconstructedFunctionType& reconstructed_function,
+      const GV& grid_view,
+      const std::vector<LocalVectorType>& source_values,
+      const BoundaryValueType& boundary_values,
+      const AnalyticalFluxType& analytical_flux,
+      const SlopeType& slope,
+      const XT::Common::Parameter& param,
+      const bool flux_is_affine = false,
+      const FluxEigenDecompositionLambdaType& flux_eigen_decomposition = {})
+    : slope_functor_(std::make_unique<SlopeFunctorType>(grid_view,
+                                                        source_values,
+                                                        boundary_values,
+                                                        analytical_flux,
+                                                        slope,
+                                                        param,
+                                                        flux_is_affine,
+                                                        flux_eigen_decomposition))
     , reconstructed_function_(reconstructed_function)
   {}
 
@@ -235,6 +248,7 @@ class LocalLinearReconstructionOperator : public XT::Grid::ElementFunctor<GV>
   using TargetBasisType = typename TargetType::SpaceType::GlobalBasisType::LocalizedType;
   using LocalDofVectorType = typename TargetType::DofVectorType::LocalDofVectorType;
   using SlopeFunctorType = LinearSlopeElementFunctor<AnalyticalFluxType, BoundaryValueType, GV, EigenvectorWrapperType>;
+  using FluxEigenDecompositionLambdaType = typename SlopeFunctorType::FluxEigenDecompositionLambdaType;
 
 public:
   explicit LocalLinearReconstructionOperator(const std::vector<LocalVectorType>& source_values,
@@ -244,9 +258,16 @@ public:
                                              const BoundaryValueType& boundary_values,
                                              const SlopeType& slope,
                                              const XT::Common::Parameter& param,
-                                             const bool flux_is_affine = false)
-    : slope_functor_(std::make_unique<SlopeFunctorType>(
-        target_space.grid_view(), source_values, boundary_values, analytical_flux, slope, param, flux_is_affine))
+                                             const bool flux_is_affine = false,
+                                             const FluxEigenDecompositionLambdaType& flux_eigen_decomposition = {})
+    : slope_functor_(std::make_unique<SlopeFunctorType>(target_space.grid_view(),
+                                                        source_values,
+                                                        boundary_values,
+                                                        analytical_flux,
+                                                        slope,
+                                                        param,
+                                                        flux_is_affine,
+                                                        flux_eigen_decomposition))
     , target_space_(target_space)
     , target_vector_(target_vector)
     , target_(target_space_, target_vector_, "range")
@@ -318,6 +339,7 @@ public:
   using EigenvectorWrapperType = EigenvectorWrapperImp;
   using LocalVectorType = typename EigenvectorWrapperType::VectorType;
   using MatrixType = typename EigenvectorWrapperType::MatrixType;
+  using FluxEigenDecompositionLambdaType = typename EigenvectorWrapperType::FluxEigenDecompositionLambdaType;
   using E = XT::Grid::extract_entity_t<GV>;
   using SlopeType = SlopeBase<E, EigenvectorWrapperType>;
   static constexpr size_t dimDomain = BoundaryValueType::d;
@@ -328,13 +350,15 @@ public:
                                const BoundaryValueType& boundary_values,
                                const SourceSpaceType& source_space,
                                const SlopeType& slope = default_minmod_slope(),
-                               const bool flux_is_affine = false)
+                               const bool flux_is_affine = false,
+                               FluxEigenDecompositionLambdaType flux_eigen_decomposition = {})
     : analytical_flux_(analytical_flux)
     , boundary_values_(boundary_values)
     , source_space_(source_space)
     , range_space_(source_space_.grid_view(), 1)
     , slope_(slope)
     , flux_is_affine_(flux_is_affine)
+    , flux_eigen_decomposition_(flux_eigen_decomposition)
   {}
 
   bool linear() const override final
@@ -373,7 +397,15 @@ public:
                                                                            ReconstructionSpaceType,
                                                                            VectorType,
                                                                            EigenvectorWrapperType>(
-        source_values, range_space_, range, analytical_flux_, boundary_values_, slope_, param, flux_is_affine_);
+        source_values,
+        range_space_,
+        range,
+        analytical_flux_,
+        boundary_values_,
+        slope_,
+        param,
+        flux_is_affine_,
+        flux_eigen_decomposition_);
     auto walker = XT::Grid::Walker<GV>(grid_view);
     walker.append(local_reconstruction_operator);
     walker.walk(true);
@@ -392,6 +424,7 @@ private:
   ReconstructionSpaceType range_space_;
   const SlopeType& slope_;
   const bool flux_is_affine_;
+  const FluxEigenDecompositionLambdaType flux_eigen_decomposition_;
 }; // class LinearReconstructionOperator<...>
 
 
@@ -413,6 +446,7 @@ public:
   using BoundaryValueType = BoundaryValueImp;
   using EigenvectorWrapperType = EigenvectorWrapperImp;
   using LocalVectorType = typename EigenvectorWrapperType::VectorType;
+  using FluxEigenDecompositionLambdaType = typename EigenvectorWrapperType::FluxEigenDecompositionLambdaType;
   using E = XT::Grid::extract_entity_t<GV>;
   using SlopeType = SlopeBase<E, EigenvectorWrapperType>;
   using R = typename BoundaryValueType::R;
@@ -426,12 +460,14 @@ public:
                                         const BoundaryValueType& boundary_values,
                                         const SpaceType& space,
                                         const SlopeType& slope = default_minmod_slope(),
-                                        const bool flux_is_affine = false)
+                                        const bool flux_is_affine = false,
+                                        FluxEigenDecompositionLambdaType flux_eigen_decomposition = {})
     : analytical_flux_(analytical_flux)
     , boundary_values_(boundary_values)
     , space_(space)
     , slope_(slope)
     , flux_is_affine_(flux_is_affine)
+    , flux_eigen_decomposition_(flux_eigen_decomposition)
   {}
 
   bool linear() const
@@ -461,7 +497,15 @@ public:
     // do reconstruction
     auto local_reconstruction_operator =
         LocalPointwiseLinearReconstructionOperator<AnalyticalFluxType, BoundaryValueType, GV, EigenvectorWrapperType>(
-            range, grid_view, source_values, boundary_values_, analytical_flux_, slope_, param, flux_is_affine_);
+            range,
+            grid_view,
+            source_values,
+            boundary_values_,
+            analytical_flux_,
+            slope_,
+            param,
+            flux_is_affine_,
+            flux_eigen_decomposition_);
     auto walker = XT::Grid::Walker<GV>(grid_view);
     walker.append(local_reconstruction_operator);
     walker.walk(true);
@@ -479,6 +523,7 @@ private:
   const SpaceType& space_;
   const SlopeType& slope_;
   const bool flux_is_affine_;
+  const FluxEigenDecompositionLambdaType flux_eigen_decomposition_;
 }; // class PointwiseLinearReconstructionOperator<...>
 
 
@@ -12,7 +12,14 @@
 #ifndef DUNE_GDT_SPACES_BASIS_DEFAULT_HH
 #define DUNE_GDT_SPACES_BASIS_DEFAULT_HH
 
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+#include <dune/common/hash.hh>
+
 #include <dune/xt/common/memory.hh>
+#include <dune/xt/common/timedlogging.hh>
 #include <dune/xt/functions/interfaces/grid-function.hh>
 
 #include <dune/gdt/exceptions.hh>
@@ -27,6 +34,13 @@ namespace GDT {
 /**
  * Applies no transformation in evaluate, but left-multiplication by the geometry transformations jacobian inverse
  * transpose in jacobian.
+ *
+ * The values and jacobians of the local finite elements on the reference element only depend on the geometry type,
+ * the finite element order and the evaluation point. Since the integrands evaluate the basis in the points of the same
+ * quadrature rules on every element, each localized basis tabulates these once, so that only the geometry
+ * transformation remains to be applied per element (see LocalizedDefaultGlobalBasis). The number of cache hits and
+ * misses is available via reference_tabulation_hits() and reference_tabulation_misses() and is reported to the debug
+ * logger "gdt.spaces.basis.default" once the last basis (or localized basis) is destroyed.
  */
 template <class GV, size_t r = 1, size_t rC = 1, class R = double>
 class DefaultGlobalBasis : public GlobalBasisInterface<GV, r, rC, R>
@@ -43,6 +57,50 @@ public:
   using typename BaseType::LocalizedType;
   using FiniteElementFamilyType = LocalFiniteElementFamilyInterface<D, d, R, r, rC>;
 
+private:
+  /**
+   * Accumulates the hits and misses of the tabulations of all localized bases (and all copies of this basis).
+   */
+  class TabulationStatistics
+  {
+  public:
+    TabulationStatistics()
+      : hits_(0)
+      , misses_(0)
+    {}
+
+    ~TabulationStatistics()
+    {
+      const size_t hits = hits_;
+      const size_t misses = misses_;
+      if (hits + misses > 0)
+        XT::Common::TimedLogger().get("gdt.spaces.basis.default").debug()
+            << "reference tabulation: " << hits << " hits, " << misses << " misses (hit rate "
+            << (100. * hits) / (hits + misses) << "%)" << std::endl;
+    }
+
+    void add(const size_t hits, const size_t misses)
+    {
+      hits_ += hits;
+      misses_ += misses;
+    }
+
+    size_t hits() const
+    {
+      return hits_;
+    }
+
+    size_t misses() const
+    {
+      return misses_;
+    }
+
+  private:
+    std::atomic<size_t> hits_;
+    std::atomic<size_t> misses_;
+  }; // class TabulationStatistics
+
+public:
   DefaultGlobalBasis(const ThisType&) = default;
   DefaultGlobalBasis(ThisType&&) = default;
 
@@ -51,13 +109,29 @@ public:
 
   DefaultGlobalBasis(const GridViewType& grid_view,
                      const FiniteElementFamilyType& local_finite_elements,
-                     const int order)
-    : grid_view_(grid_view)
+                     const int order,
+                     const std::string& logging_prefix = "",
+                     const bool logging_disabled = true)
+    : BaseType(logging_prefix.empty() ? "DefaultGlobalBasis" : logging_prefix, logging_disabled)
+    , grid_view_(grid_view)
     , local_finite_elements_(local_finite_elements)
     , fe_order_(order)
     , max_size_(0)
+    , tabulation_statistics_(std::make_shared<TabulationStatistics>())
   {}
 
+  /// \note Only contains the statistics of localized bases which have already been destroyed.
+  size_t reference_tabulation_hits() const
+  {
+    return tabulation_statistics_->hits();
+  }
+
+  /// \note Only contains the statistics of localized bases which have already been destroyed.
+  size_t reference_tabulation_misses() const
+  {
+    return tabulation_statistics_->misses();
+  }
+
   size_t max_size() const override final
   {
     return max_size_;
@@ -78,6 +152,16 @@ public:
   }
 
 private:
+  /**
+   * Tabulates the reference values and reference jacobians, keyed on (geometry type, point in reference element), the
+   * finite element order is fixed by the global basis. Quadrature points are reproduced bitwise on each element, so
+   * exact comparison of the points is what we want here. Since the points of a quadrature are usually visited in the
+   * same order on each element, we first compare with the successor of the last point, before we search all points.
+   * To bound the memory consumption in case the basis is evaluated in arbitrary points (e.g., for visualization), no
+   * new points are tabulated once max_tabulated_points() is reached.
+   *
+   * The tabulation belongs to this localized basis and is thus neither shared between threads nor locked.
+   */
   class LocalizedDefaultGlobalBasis : public LocalizedGlobalFiniteElementInterface<E, r, rC, R>
   {
     using ThisType = LocalizedDefaultGlobalBasis;
@@ -93,13 +177,45 @@ private:
     using typename BaseType::LocalFiniteElementType;
     using typename BaseType::RangeType;
 
+    static constexpr size_t max_tabulated_points()
+    {
+      return 4096;
+    }
+
     LocalizedDefaultGlobalBasis(const DefaultGlobalBasis<GV, r, rC, R>& self)
       : BaseType()
       , self_(self)
+      , tabulation_statistics_(self_.tabulation_statistics_)
+      , next_tabulation_(0)
+      , tabulation_hits_(0)
+      , tabulation_misses_(0)
     {}
 
     LocalizedDefaultGlobalBasis(const ThisType&) = delete;
-    LocalizedDefaultGlobalBasis(ThisType&&) = default;
+
+    LocalizedDefaultGlobalBasis(ThisType&& source)
+      : BaseType(std::move(source))
+      , self_(source.self_)
+      , tabulation_statistics_(source.tabulation_statistics_)
+      , current_local_fe_(std::move(source.current_local_fe_))
+      , size_(source.size_)
+      , order_(source.order_)
+      , geometry_type_(source.geometry_type_)
+      , tabulations_(std::move(source.tabulations_))
+      , tabulation_indices_(std::move(source.tabulation_indices_))
+      , next_tabulation_(source.next_tabulation_)
+      , tabulation_hits_(source.tabulation_hits_)
+      , tabulation_misses_(source.tabulation_misses_)
+    {
+      source.tabulation_hits_ = 0;
+      source.tabulation_misses_ = 0;
+    }
+
+    ~LocalizedDefaultGlobalBasis()
+    {
+      // we hold our own reference to the statistics, since we might outlive self_
+      tabulation_statistics_->add(tabulation_hits_, tabulation_misses_);
+    }
 
     ThisType& operator=(const ThisType&) = delete;
     ThisType& operator=(ThisType&&) = delete;
@@ -146,7 +262,7 @@ private:
     {
       DUNE_THROW_IF(!current_local_fe_.valid(), Exceptions::not_bound_to_an_element_yet, "");
       this->assert_inside_reference_element(point_in_reference_element);
-      current_local_fe_.access().basis().evaluate(point_in_reference_element, result);
+      result = this->tabulation(point_in_reference_element).values;
     }
 
     void jacobians(const DomainType& point_in_reference_element,
@@ -155,8 +271,8 @@ private:
     {
       DUNE_THROW_IF(!current_local_fe_.valid(), Exceptions::not_bound_to_an_element_yet, "");
       this->assert_inside_reference_element(point_in_reference_element);
-      // evaluate jacobian of shape functions
-      current_local_fe_.access().basis().jacobian(point_in_reference_element, result);
+      // jacobians of the shape functions
+      const auto& reference_jacobians = this->tabulation(point_in_reference_element).jacobians;
       // Apply transformation:
       // Let f: E -> R^r be a basis function, and g: E' -> E be the mapping from reference to actual element, then f
       // \circ g is a shape function. We have the chain rule J_f = J(f \circ g \circ g^{-1}) = J(f \circ g) J_g^{-1}.
@@ -165,13 +281,11 @@ private:
       // so we have to multiply J_inv_T from the left to the transposed shape function jacobians (i.e. the shape
       // function gradients) to get the transposed jacobian of the basis function (basis function gradient).
       const auto J_inv_T = this->element().geometry().jacobianInverseTransposed(point_in_reference_element);
-      auto tmp_value = result[0][0];
-      const size_t basis_size = current_local_fe_.access().basis().size();
+      const size_t basis_size = reference_jacobians.size();
+      result.resize(basis_size);
       for (size_t ii = 0; ii < basis_size; ++ii)
-        for (size_t rr = 0; rr < r; ++rr) {
-          J_inv_T.mv(result[ii][rr], tmp_value);
-          result[ii][rr] = tmp_value;
-        }
+        for (size_t rr = 0; rr < r; ++rr)
+          J_inv_T.mv(reference_jacobians[ii][rr], result[ii][rr]);
     } // ... jacobian(...)
 
     // required by LocalizedGlobalFiniteElementInterface
@@ -207,17 +321,96 @@ private:
     }
 
   private:
+    struct Tabulation
+    {
+      GeometryType geometry_type;
+      DomainType point;
+      std::vector<RangeType> values;
+      std::vector<DerivativeRangeType> jacobians;
+    };
+
+    struct Key
+    {
+      GeometryType geometry_type;
+      DomainType point;
+
+      bool operator==(const Key& other) const
+      {
+        return geometry_type == other.geometry_type && point == other.point;
+      }
+    };
+
+    struct KeyHash
+    {
+      size_t operator()(const Key& key) const
+      {
+        size_t seed = 0;
+        hash_combine(seed, key.geometry_type.id());
+        hash_combine(seed, key.geometry_type.dim());
+        for (size_t ii = 0; ii < d; ++ii)
+          hash_combine(seed, key.point[ii]);
+        return seed;
+      }
+    };
+
+    /// \note The reference is only valid until the next call.
+    const Tabulation& tabulation(const DomainType& point_in_reference_element) const
+    {
+      // usually, the points are visited in the same order as on the last element
+      if (next_tabulation_ < tabulations_.size()) {
+        const auto& candidate = tabulations_[next_tabulation_];
+        if (candidate.geometry_type == geometry_type_ && candidate.point == point_in_reference_element) {
+          ++tabulation_hits_;
+          return tabulations_[next_tabulation_++];
+        }
+      }
+      const Key key{geometry_type_, point_in_reference_element};
+      const auto search_result = tabulation_indices_.find(key);
+      if (search_result != tabulation_indices_.end()) {
+        ++tabulation_hits_;
+        next_tabulation_ = search_result->second + 1;
+        return tabulations_[search_result->second];
+      }
+      ++tabulation_misses_;
+      const auto& basis = current_local_fe_.access().basis();
+      if (tabulations_.size() >= max_tabulated_points()) {
+        // do not grow the tabulation any further, but evaluate into a buffer
+        untabulated_.geometry_type = geometry_type_;
+        untabulated_.point = point_in_reference_element;
+        basis.evaluate(point_in_reference_element, untabulated_.values);
+        basis.jacobian(point_in_reference_element, untabulated_.jacobians);
+        return untabulated_;
+      }
+      tabulations_.emplace_back();
+      auto& tabulation = tabulations_.back();
+      tabulation.geometry_type = geometry_type_;
+      tabulation.point = point_in_reference_element;
+      basis.evaluate(point_in_reference_element, tabulation.values);
+      basis.jacobian(point_in_reference_element, tabulation.jacobians);
+      tabulation_indices_.emplace(key, tabulations_.size() - 1);
+      next_tabulation_ = tabulations_.size();
+      return tabulation;
+    } // ... tabulation(...)
+
     const DefaultGlobalBasis<GV, r, rC, R>& self_;
+    std::shared_ptr<TabulationStatistics> tabulation_statistics_;
     XT::Common::ConstStorageProvider<LocalFiniteElementInterface<D, d, R, r, rC>> current_local_fe_;
     size_t size_;
     int order_;
     Dune::GeometryType geometry_type_;
+    mutable std::vector<Tabulation> tabulations_;
+    mutable std::unordered_map<Key, size_t, KeyHash> tabulation_indices_;
+    mutable Tabulation untabulated_;
+    mutable size_t next_tabulation_;
+    mutable size_t tabulation_hits_;
+    mutable size_t tabulation_misses_;
   }; // class LocalizedDefaultGlobalBasis
 
   const GridViewType& grid_view_;
   const FiniteElementFamilyType& local_finite_elements_;
   const int fe_order_;
   size_t max_size_;
+  std::shared_ptr<TabulationStatistics> tabulation_statistics_;
 }; // class DefaultGlobalBasis
 
 
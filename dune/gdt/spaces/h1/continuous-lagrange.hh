@@ -152,6 +152,11 @@ public:
     return true;
   }
 
+  bool locally_determined_finite_elements() const final
+  {
+    return true;
+  }
+
   void update_after_adapt() final
   {
     // check: the mapper does not work for non-conforming intersections
@@ -14,10 +14,23 @@
 #ifndef DUNE_GDT_SPACES_INTERFACE_HH
 #define DUNE_GDT_SPACES_INTERFACE_HH
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/referenceelements.hh>
 #include <dune/geometry/type.hh>
 
 #include <dune/grid/utility/persistentcontainer.hh>
 
+#include <dune/xt/common/float_cmp.hh>
 #include <dune/xt/common/timedlogging.hh>
 #include <dune/xt/la/container/vector-interface.hh>
 #include <dune/xt/la/solver.hh>
@@ -46,6 +59,79 @@ template <class V, class GV, size_t r, size_t rC, class R>
 class ConstDiscreteFunction;
 
 
+namespace internal {
+
+
+/**
+ * \brief Identifies a local restriction or prolongation matrix: the finite elements of father and child (geometry type,
+ *        size, order and FE data) and the position of the child in the father, given by the sub-entities (codim and
+ *        index) of the reference element of the father whose centers are the corners of the child.
+ *
+ * For the usual refinement rules, the corners of the children are vertices, edge midpoints, face centers or the center
+ * of the father, so this identifies the refinement rule exactly instead of comparing coordinates.
+ */
+template <class R>
+struct TransferMatrixKey
+{
+  bool restriction;
+  std::vector<unsigned int> finite_elements;
+  std::vector<R> fe_data;
+  std::vector<std::pair<int, int>> child_corners;
+
+  bool operator<(const TransferMatrixKey& other) const
+  {
+    return std::tie(restriction, finite_elements, fe_data, child_corners)
+           < std::tie(other.restriction, other.finite_elements, other.fe_data, other.child_corners);
+  }
+}; // struct TransferMatrixKey
+
+
+/**
+ * \brief Thread-safe cache of the local restriction and prolongation matrices of a space, see
+ *        SpaceInterface::restrict_to and SpaceInterface::prolong_onto.
+ *
+ * References to cached matrices stay valid until clear() is called.
+ */
+template <class R>
+class TransferMatrixCache
+{
+public:
+  using KeyType = TransferMatrixKey<R>;
+
+  const DynamicMatrix<R>& get(const KeyType& key, const std::function<DynamicMatrix<R>()>& compute) const
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      const auto search_result = matrices_.find(key);
+      if (search_result != matrices_.end())
+        return search_result->second;
+    }
+    auto matrix = compute();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return matrices_.emplace(key, std::move(matrix)).first->second;
+  }
+
+  size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return matrices_.size();
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    matrices_.clear();
+  }
+
+private:
+  mutable std::mutex mutex_;
+  mutable std::map<KeyType, DynamicMatrix<R>> matrices_;
+}; // class TransferMatrixCache
+
+
+} // namespace internal
+
+
 template <class GridView, size_t range_dim = 1, size_t range_dim_columns = 1, class RangeField = double>
 class SpaceInterface : public XT::Common::WithLogger<SpaceInterface<GridView, range_dim, range_dim_columns, RangeField>>
 {
@@ -76,6 +162,8 @@ public:
     : Logger(logging_prefix.empty() ? "Space" : logging_prefix, logging_disabled)
     , dof_communicator_(nullptr)
     , adapted_(false)
+    , transfer_matrices_(std::make_shared<internal::TransferMatrixCache<R>>())
+    , transfer_matrices_enabled_(true)
   {}
 
   SpaceInterface(const ThisType& other) = default;
@@ -119,6 +207,16 @@ public:
    */
   virtual bool is_lagrangian() const = 0;
 
+  /**
+   * If this returns true, the local finite element (and its FE data, see GlobalBasisInterface) on an element does not
+   * depend on global information (as for DG, FV or continuous Lagrange spaces), so it does not change during grid
+   * adaptation unless the element changes. Used in prolong_onto() to copy the DoF data of unchanged elements.
+   */
+  virtual bool locally_determined_finite_elements() const
+  {
+    return false;
+  }
+
   /// \}
   /// \name These methods are required for grid adaptation.
   /// \{
@@ -130,6 +228,10 @@ public:
    * \attention This implementation only makes sense if the evaluation of the global basis coincides with the evaluation
    *            of the finite elements basis.
    *
+   * \note On affine elements, the projection of the data of each child element is a mat-vec with a matrix which only
+   *       depends on the refinement rule, these matrices are cached (see transfer_matrices() and
+   *       use_transfer_matrices()).
+   *
    * \note Override this method if this is not the correct choice for the space in question!
    */
   virtual void restrict_to(const ElementType& element,
@@ -151,6 +253,32 @@ public:
       auto element_basis = this->basis().localize();
       element_restriction_FE_data = element_basis->default_data(element.type());
       element_basis->restore(element, element_restriction_FE_data);
+      if (this->use_transfer_matrices() && element.geometry().affine()) {
+        DynamicVector<R> restricted_DoFs(element_basis->size(), 0.);
+        bool all_children_known = true;
+        for (auto&& child_element : descendantElements(element, element.level() + 1)) {
+          // ensure we have data on all descendant elements of the next level
+          this->restrict_to(child_element, persistent_data);
+          const auto& child_restriction_data = persistent_data[child_element];
+          auto child_basis = this->basis().localize();
+          child_basis->restore(child_element, child_restriction_data.first);
+          const auto& child_in_element = child_element.geometryInFather();
+          auto key = transfer_key(/*restriction=*/true, *element_basis, *child_basis);
+          for (int ii = 0; ii < child_in_element.corners(); ++ii)
+            all_children_known =
+                all_children_known && append_to_transfer_key(key, element.type(), child_in_element.corner(ii));
+          if (!all_children_known)
+            break; // an unknown refinement rule, use the projection below
+          const auto& restriction_matrix = transfer_matrices_->get(key, [&]() {
+            return compute_restriction_matrix(element.type(), *element_basis, child_element, *child_basis);
+          });
+          restriction_matrix.umv(child_restriction_data.second, restricted_DoFs);
+        }
+        if (all_children_known) {
+          element_restriction_DoF_data = restricted_DoFs;
+          return;
+        }
+      }
       auto lhs = LocalElementIntegralBilinearForm<E, r, rC, R, R>(LocalProductIntegrand<E, r, R, R>())
                      .apply2(*element_basis, *element_basis);
       DynamicVector<R> rhs(element_basis->size(), 0.);
@@ -193,7 +321,7 @@ public:
                      const auto restriction_data_value = restriction_data_as_function_on_child_element.evaluate(x);
                      basis.evaluate(x, child_basis_values);
                      for (size_t ii = 0; ii < basis.size(); ++ii)
-                       result = child_basis_values[ii] * restriction_data_value;
+                       result[ii] = child_basis_values[ii] * restriction_data_value;
                    })
                    .apply(element_basis_on_child_element);
       }
@@ -231,6 +359,10 @@ public:
    * \attention This implementation only makes sense if the evaluation of the global basis coincides with the evaluation
    *            of the finite elements basis.
    *
+   * \note On affine elements, the interpolation of the data of a father element is a mat-vec with a matrix which only
+   *       depends on the refinement rule, these matrices are cached (see transfer_matrices() and
+   *       use_transfer_matrices()).
+   *
    * \note Override this method if this is not the correct choice for the space in question.
    */
   virtual void
@@ -265,6 +397,38 @@ public:
                                 << "\nfather: " << print(*father) << "\nfather.level() = " << father->level()
                                 << "\nfather_dof_data.size() = " << father_dof_data.size()
                                 << "\nfather_basis->size() = " << father_basis->size());
+      bool use_transfer_matrix =
+          this->use_transfer_matrices() && element.geometry().affine() && father->geometry().affine();
+      auto key = transfer_key(/*restriction=*/false, *father_basis, *element_basis);
+      // the element may not be a child of the father with data, but a descendant of a later generation, whose corners
+      // are not among the centers of the sub-entities of the father
+      for (int ii = 0; use_transfer_matrix && ii < element.geometry().corners(); ++ii)
+        use_transfer_matrix = append_to_transfer_key(
+            key, father->type(), father->geometry().local(element.geometry().corner(ii)));
+      if (use_transfer_matrix) {
+        const auto& prolongation_matrix = transfer_matrices_->get(key, [&]() {
+          // column jj contains the interpolation of the jj-th basis function of the father
+          DynamicMatrix<R> matrix(element_basis->size(), father_basis->size(), 0.);
+          DynamicVector<R> column(element_basis->size(), 0.);
+          for (size_t jj = 0; jj < father_basis->size(); ++jj) {
+            element_basis->interpolate(
+                [&](const auto& point_in_element_reference_element_coordinates) {
+                  father_basis->evaluate(father->geometry().local(
+                                             element.geometry().global(point_in_element_reference_element_coordinates)),
+                                         father_basis_values);
+                  return father_basis_values[jj];
+                },
+                father_basis->order(),
+                column);
+            for (size_t ii = 0; ii < element_basis->size(); ++ii)
+              matrix[ii][jj] = column[ii];
+          }
+          return matrix;
+        });
+        element_dof_data.resize(prolongation_matrix.N());
+        prolongation_matrix.mv(father_dof_data, element_dof_data);
+        return;
+      }
       element_basis->interpolate(
           [&](const auto& point_in_element_reference_element_coordinates) {
             const auto point_in_physical_coordinates =
@@ -279,34 +443,17 @@ public:
           },
           father_basis->order(),
           element_dof_data);
-    } else {
-      // This grid element is unchanged, but the FE may have changed (if the FE depends on global information), so we
-      // cannot simply copy the old data, but rather interpolate it anew.
-      // - restore the original FE
-      const auto& original_element_data = persistent_data[element];
-      const auto& original_element_FE_data = original_element_data.first;
-      const auto& original_element_DoF_data = original_element_data.second;
-      auto original_basis = this->basis().localize();
-      original_basis->restore(element, original_element_FE_data);
-      // - get the basis for the current element (has to be available after update_after_adapt())
-      const auto new_basis = this->basis().localize(element);
-      std::vector<typename GlobalBasisType::LocalizedType::RangeType> original_basis_values(original_basis->size());
-      DUNE_THROW_IF(original_element_DoF_data.size() != original_basis->size(),
+    } else if (this->locally_determined_finite_elements()) {
+      // This grid element is unchanged and so is its FE, the interpolation would be the identity.
+      const auto& original_element_DoF_data = persistent_data[element].second;
+      DUNE_THROW_IF(original_element_DoF_data.size() == 0,
                     Exceptions::space_error,
-                    "element: " << print(element) << "\nelement.level() = " << element.level()
-                                << "\noriginal_element_DoF_data.size() = " << original_element_DoF_data.size()
-                                << "\noriginal_basis->size() = " << original_basis->size());
-      // - interpolate the data from the father to the element (no need to map the coordinate, same geometry)
-      new_basis->interpolate(
-          [&](const auto& xx) {
-            original_basis->evaluate(xx, original_basis_values);
-            std::remove_reference_t<decltype(original_basis_values[0])> result(0.);
-            for (size_t ii = 0; ii < original_basis->size(); ++ii)
-              result += original_basis_values[ii] * original_element_DoF_data[ii];
-            return result;
-          },
-          original_basis->order(),
-          element_dof_data);
+                    "element: " << print(element) << "\nelement.level() = " << element.level());
+      if (element_dof_data.size() != original_element_DoF_data.size())
+        element_dof_data.resize(original_element_DoF_data.size());
+      element_dof_data = original_element_DoF_data;
+    } else {
+      this->interpolate_onto_unchanged(element, persistent_data, element_dof_data);
     }
   } // ... prolong_onto(...)
 
@@ -319,6 +466,68 @@ public:
     return element_data;
   }
 
+  /**
+   * \brief The prolongation onto an unchanged element used by prolong_onto() if the FE may have changed (if the FE
+   *        depends on global information): interpolates the data of the original FE, restored from persistent_data.
+   */
+  void interpolate_onto_unchanged(
+      const ElementType& element,
+      const PersistentContainer<G, std::pair<DynamicVector<R>, DynamicVector<R>>>& persistent_data,
+      DynamicVector<R>& element_dof_data) const
+  {
+    // This grid element is unchanged, but the FE may have changed, so we cannot simply copy the old data, but rather
+    // interpolate it anew.
+    // - restore the original FE
+    const auto& original_element_data = persistent_data[element];
+    const auto& original_element_FE_data = original_element_data.first;
+    const auto& original_element_DoF_data = original_element_data.second;
+    auto original_basis = this->basis().localize();
+    original_basis->restore(element, original_element_FE_data);
+    // - get the basis for the current element (has to be available after update_after_adapt())
+    const auto new_basis = this->basis().localize(element);
+    std::vector<typename GlobalBasisType::LocalizedType::RangeType> original_basis_values(original_basis->size());
+    DUNE_THROW_IF(original_element_DoF_data.size() != original_basis->size(),
+                  Exceptions::space_error,
+                  "element: " << print(element) << "\nelement.level() = " << element.level()
+                              << "\noriginal_element_DoF_data.size() = " << original_element_DoF_data.size()
+                              << "\noriginal_basis->size() = " << original_basis->size());
+    // - interpolate the original data (no need to map the coordinate, same geometry)
+    new_basis->interpolate(
+        [&](const auto& xx) {
+          original_basis->evaluate(xx, original_basis_values);
+          std::remove_reference_t<decltype(original_basis_values[0])> result(0.);
+          for (size_t ii = 0; ii < original_basis->size(); ++ii)
+            result += original_basis_values[ii] * original_element_DoF_data[ii];
+          return result;
+        },
+        original_basis->order(),
+        element_dof_data);
+  } // ... interpolate_onto_unchanged(...)
+
+  /// \brief The local restriction and prolongation matrices cached by restrict_to() and prolong_onto().
+  internal::TransferMatrixCache<R>& transfer_matrices() const
+  {
+    return *transfer_matrices_;
+  }
+
+  /**
+   * \brief Whether restrict_to() and prolong_onto() use the cached matrices of transfer_matrices() on affine elements.
+   *
+   * These matrices are computed on the reference elements, which is only correct if the global basis is the finite
+   * element basis composed with the reference map. This holds for Lagrangian spaces and spaces with locally determined
+   * finite elements, but not, e.g., for Raviart-Thomas spaces (Piola transformation, global orientation of the faces).
+   */
+  bool use_transfer_matrices() const
+  {
+    return transfer_matrices_enabled_ && (this->is_lagrangian() || this->locally_determined_finite_elements());
+  }
+
+  /// \brief Allows to disable the cached matrices, e.g. to compare with the non-cached restriction and prolongation.
+  void use_transfer_matrices(const bool value)
+  {
+    transfer_matrices_enabled_ = value;
+  }
+
   /// \}
   /// \name These methods are required for MPI communication, they are provided.
   /// \{
@@ -374,8 +583,89 @@ protected:
   }
 
 private:
+  using LocalizedBasisType = typename GlobalBasisType::LocalizedType;
+
+  /// The finite element part of the key, see internal::TransferMatrixKey.
+  static internal::TransferMatrixKey<R>
+  transfer_key(const bool restriction, const LocalizedBasisType& father_basis, const LocalizedBasisType& child_basis)
+  {
+    internal::TransferMatrixKey<R> key;
+    key.restriction = restriction;
+    for (const auto* basis : {&father_basis, &child_basis}) {
+      const auto geometry_type = basis->element().type();
+      key.finite_elements.insert(key.finite_elements.end(),
+                                 {geometry_type.dim(),
+                                  geometry_type.id(),
+                                  static_cast<unsigned int>(basis->size()),
+                                  static_cast<unsigned int>(basis->order())});
+      const auto fe_data = basis->backup();
+      key.fe_data.insert(key.fe_data.end(), fe_data.begin(), fe_data.end());
+      key.fe_data.push_back(fe_data.size()); // <- separates the FE data of father and child
+    }
+    return key;
+  } // ... transfer_key(...)
+
+  /**
+   * \brief Appends the sub-entity of the reference element of the father whose center is the given corner of the child
+   *        (in reference coordinates of the father) to the key, returns false if there is none.
+   */
+  template <class PointType>
+  static bool append_to_transfer_key(internal::TransferMatrixKey<R>& key,
+                                     const GeometryType& father_type,
+                                     const PointType& corner_in_father)
+  {
+    const auto& reference_element = ReferenceElements<D, d>::general(father_type);
+    for (int codim = d; codim >= 0; --codim)
+      for (int ii = 0; ii < reference_element.size(codim); ++ii)
+        if (XT::Common::FloatCmp::eq(reference_element.position(ii, codim), corner_in_father, 1e-10, 1e-10)) {
+          key.child_corners.emplace_back(codim, ii);
+          return true;
+        }
+    return false;
+  } // ... append_to_transfer_key(...)
+
+  /// Computes R = M^{-1} B, where M is the mass matrix of the father basis and B contains the products of the father
+  /// basis with the child basis, both on the reference element of the father (the determinant of the affine reference
+  /// map of the father cancels).
+  static DynamicMatrix<R> compute_restriction_matrix(const GeometryType& father_type,
+                                                     const LocalizedBasisType& father_basis,
+                                                     const ElementType& child_element,
+                                                     const LocalizedBasisType& child_basis)
+  {
+    const auto& child_in_father = child_element.geometryInFather();
+    std::vector<typename LocalizedBasisType::RangeType> father_values(father_basis.size());
+    std::vector<typename LocalizedBasisType::RangeType> child_values(child_basis.size());
+    DynamicMatrix<R> mass_matrix(father_basis.size(), father_basis.size(), 0.);
+    for (auto&& quadrature_point : QuadratureRules<D, d>::rule(father_type, 2 * father_basis.order())) {
+      father_basis.evaluate(quadrature_point.position(), father_values);
+      for (size_t ii = 0; ii < father_basis.size(); ++ii)
+        for (size_t jj = 0; jj < father_basis.size(); ++jj)
+          mass_matrix[ii][jj] += quadrature_point.weight() * (father_values[ii] * father_values[jj]);
+    }
+    DynamicMatrix<R> products(father_basis.size(), child_basis.size(), 0.);
+    for (auto&& quadrature_point :
+         QuadratureRules<D, d>::rule(child_element.type(), father_basis.order() + child_basis.order())) {
+      const auto& x = quadrature_point.position();
+      father_basis.evaluate(child_in_father.global(x), father_values);
+      child_basis.evaluate(x, child_values);
+      const auto factor = quadrature_point.weight() * child_in_father.integrationElement(x);
+      for (size_t ii = 0; ii < father_basis.size(); ++ii)
+        for (size_t jj = 0; jj < child_basis.size(); ++jj)
+          products[ii][jj] += factor * (father_values[ii] * child_values[jj]);
+    }
+    mass_matrix.invert();
+    DynamicMatrix<R> restriction_matrix(father_basis.size(), child_basis.size(), 0.);
+    for (size_t ii = 0; ii < father_basis.size(); ++ii)
+      for (size_t kk = 0; kk < father_basis.size(); ++kk)
+        for (size_t jj = 0; jj < child_basis.size(); ++jj)
+          restriction_matrix[ii][jj] += mass_matrix[ii][kk] * products[kk][jj];
+    return restriction_matrix;
+  } // ... compute_restriction_matrix(...)
+
   std::shared_ptr<DofCommunicatorType> dof_communicator_;
   bool adapted_;
+  std::shared_ptr<internal::TransferMatrixCache<R>> transfer_matrices_;
+  bool transfer_matrices_enabled_;
 }; // class SpaceInterface
 
 
@@ -160,6 +160,11 @@ public:
     return true;
   }
 
+  bool locally_determined_finite_elements() const override final
+  {
+    return true;
+  }
+
   void update_after_adapt() override final
   {
     // create/update mapper ...
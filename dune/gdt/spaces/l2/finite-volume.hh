@@ -137,6 +137,11 @@ public:
     return true;
   }
 
+  bool locally_determined_finite_elements() const override final
+  {
+    return true;
+  }
+
   /**
    * More efficient restriction than in SpaceInterface for FV.
    */
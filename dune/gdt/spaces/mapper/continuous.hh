@@ -179,6 +179,7 @@ public:
                   Exceptions::mapper_error,
                   "This must not happen, the finite elements report no DoFs attached to (sub)entities!");
     mapper_.update();
+    ++this->adaptation_count_;
   } // ... update_after_adapt(...)
 
 private:
@@ -122,6 +122,7 @@ public:
       size_ += local_sz;
       max_num_dofs_ = std::max(max_num_dofs_, local_sz);
     }
+    ++this->adaptation_count_;
   }
 
 private:
@@ -138,6 +138,7 @@ public:
         global_indices_of_intersections[local_index] = global_index;
       }
     }
+    ++this->adaptation_count_;
   } // ... update_after_adapt(...)
 
 private:
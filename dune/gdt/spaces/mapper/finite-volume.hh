@@ -110,6 +110,7 @@ public:
   void update_after_adapt() override final
   {
     mapper_.update();
+    ++this->adaptation_count_;
   }
 
 private:
@@ -65,7 +65,18 @@ public:
     DUNE_THROW(Exceptions::mapper_error, "This mapper does not support adaptation!");
   }
 
+  /**
+   * \brief Counts the calls to update_after_adapt(), allows to detect outdated data which was derived from this mapper.
+   */
+  size_t adaptation_count() const
+  {
+    return adaptation_count_;
+  }
+
   /// \}
+
+protected:
+  size_t adaptation_count_ = 0;
 }; // class MapperInterface
 
 
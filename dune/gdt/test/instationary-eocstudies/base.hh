@@ -456,6 +456,8 @@ XT::LA::ListVectorArray<V> solve_instationary_system_implicit_euler(const Discre
   // some preparations
   auto id = make_identity_operator(spatial_op);
   V zero(spatial_op.range_space().mapper().size(), 0.);
+  // the jacobian of the newton inversion is kept for all time steps
+  typename OperatorInterface<M, GV, m>::NewtonJacobianCache jacobian_cache;
   auto logger = XT::Common::TimedLogger().get("gdt.test.solve_instationary_system_implicit_euler");
   // initial values
   XT::LA::ListVectorArray<V> solution(
@@ -473,7 +475,8 @@ XT::LA::ListVectorArray<V> solve_instationary_system_implicit_euler(const Discre
                               u_n_plus_one,
                               DXTC_CONFIG.has_sub("solve_instationary_system_implicit_euler.apply_inverse")
                                   ? DXTC_CONFIG.sub("solve_instationary_system_implicit_euler.apply_inverse")
-                                  : residual_op.invert_options(residual_op.invert_options().at(0)));
+                                  : residual_op.invert_options(residual_op.invert_options().at(0)),
+                              jacobian_cache);
     solution.append(std::move(u_n_plus_one), {"_t", time});
   }
   return solution;
@@ -83,6 +83,9 @@ public:
                                                             advection_dg_artificial_viscosity_default_alpha_1()))
     , dg_artificial_viscosity_component_(DXTC_TEST_CONFIG_GET("setup.dg_artificial_viscosity_component",
                                                               advection_dg_artificial_viscosity_default_component()))
+    , dg_fuse_inverse_mass_application_(DXTC_TEST_CONFIG_GET("setup.dg_fuse_inverse_mass_application", false))
+    , fv_face_batch_size_(DXTC_TEST_CONFIG_GET("setup.fv_face_batch_size", 0))
+    , fv_cache_face_data_(DXTC_TEST_CONFIG_GET("setup.fv_cache_face_data", false))
   {}
 
 protected:
@@ -120,7 +123,14 @@ protected:
       return nullptr;
     }
     if (space_type_ == "fv")
-      return std::make_unique<AdvectionFvOperator<M, GV, m>>(space.grid_view(), *numerical_flux, space, space);
+      return std::make_unique<AdvectionFvOperator<M, GV, m>>(space.grid_view(),
+                                                             *numerical_flux,
+                                                             space,
+                                                             space,
+                                                             /*use_tbb=*/false,
+                                                             XT::Grid::ApplyOn::NoIntersections<GV>(),
+                                                             fv_face_batch_size_,
+                                                             fv_cache_face_data_);
     else
       return std::make_unique<AdvectionDgOperator<M, GV, m>>(
           space.grid_view(),
@@ -130,7 +140,8 @@ protected:
           /*periodicity_exception=*/XT::Grid::ApplyOn::NoIntersections<GV>(),
           dg_artificial_viscosity_nu_1_,
           dg_artificial_viscosity_alpha_1_,
-          dg_artificial_viscosity_component_);
+          dg_artificial_viscosity_component_,
+          dg_fuse_inverse_mass_application_);
   } // ... make_lhs_operator(...)
 
   virtual double estimate_fixed_explicit_fv_dt(
@@ -209,6 +220,9 @@ protected:
   double dg_artificial_viscosity_nu_1_;
   double dg_artificial_viscosity_alpha_1_;
   size_t dg_artificial_viscosity_component_;
+  bool dg_fuse_inverse_mass_application_;
+  size_t fv_face_batch_size_;
+  bool fv_cache_face_data_;
 }; // struct InstationaryNonconformingHyperbolicEocStudy
 
 
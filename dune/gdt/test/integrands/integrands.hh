@@ -10,7 +10,9 @@
 #ifndef DUNE_GDT_TEST_INTEGRANDS_INTEGRANDS_HH
 #define DUNE_GDT_TEST_INTEGRANDS_INTEGRANDS_HH
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/geometry/type.hh>
@@ -26,6 +28,7 @@
 #include <dune/xt/functions/generic/function.hh>
 #include <dune/xt/functions/generic/grid-function.hh>
 
+#include <dune/gdt/local/integrands/interfaces.hh>
 #include <dune/gdt/operators/matrix-based.hh>
 #include <dune/gdt/spaces/h1/continuous-lagrange.hh>
 #include <dune/gdt/tools/sparsity-pattern.hh>
@@ -141,6 +144,33 @@ struct IntegrandTest : public ::testing::Test
   } // ... SetUp(...)
 
   virtual void is_constructable() = 0;
+
+  /**
+   * Compares the (overridden) evaluate_all(...) of integrand with the default implementation of
+   * LocalBinaryElementIntegrandInterface, which loops over the quadrature points and calls evaluate(...), on each
+   * element of the grid.
+   */
+  template <size_t t_r, size_t t_rC, class TR, class F, size_t a_r, size_t a_rC, class AR, class TB, class AB>
+  void check_evaluate_all_against_pointwise_loop(
+      LocalBinaryElementIntegrandInterface<E, t_r, t_rC, TR, F, a_r, a_rC, AR>& integrand,
+      const TB& test_basis,
+      const AB& ansatz_basis)
+  {
+    using InterfaceType = LocalBinaryElementIntegrandInterface<E, t_r, t_rC, TR, F, a_r, a_rC, AR>;
+    DynamicMatrix<F> result;
+    DynamicMatrix<F> expected_result;
+    for (auto&& element : elements(grid_provider_->leaf_view())) {
+      integrand.bind(element);
+      const auto& quadrature =
+          QuadratureRules<D, d>::rule(element.type(), integrand.order(test_basis, ansatz_basis));
+      integrand.evaluate_all(test_basis, ansatz_basis, quadrature, result);
+      integrand.InterfaceType::evaluate_all(test_basis, ansatz_basis, quadrature, expected_result);
+      for (size_t ii = 0; ii < test_basis.size(); ++ii)
+        for (size_t jj = 0; jj < ansatz_basis.size(); ++jj)
+          EXPECT_NEAR(expected_result[ii][jj], result[ii][jj], 1e-13 * std::max(1., std::abs(expected_result[ii][jj])))
+              << "ii = " << ii << ", jj = " << jj;
+    }
+  } // ... check_evaluate_all_against_pointwise_loop(...)
 }; // struct IntegrandTest
 
 
@@ -112,6 +112,17 @@ struct LaplaceIntegrandTest : public IntegrandTest<G>
     }
   }
 
+  virtual void evaluate_all_coincides_with_pointwise_loop()
+  {
+    ScalarIntegrandType scalar_integrand(*diffusion_tensor_);
+    this->check_evaluate_all_against_pointwise_loop(scalar_integrand, *scalar_test_, *scalar_ansatz_);
+    VectorIntegrandType vector_integrand(*diffusion_tensor_);
+    this->check_evaluate_all_against_pointwise_loop(vector_integrand, *vector_test_, *vector_ansatz_);
+    // the sum forwards to the evaluate_all(...) of both summands
+    auto sum_integrand = scalar_integrand + ScalarIntegrandType(2.);
+    this->check_evaluate_all_against_pointwise_loop(sum_integrand, *scalar_test_, *scalar_ansatz_);
+  }
+
   virtual void is_integrated_correctly()
   {
     ScalarIntegrandType integrand(1.);
@@ -167,6 +178,11 @@ TYPED_TEST(LaplaceIntegrandTest, evaluates_correctly_for_vector_bases)
   this->evaluates_correctly_for_vector_bases();
 }
 
+TYPED_TEST(LaplaceIntegrandTest, evaluate_all_coincides_with_pointwise_loop)
+{
+  this->evaluate_all_coincides_with_pointwise_loop();
+}
+
 TYPED_TEST(LaplaceIntegrandTest, is_integrated_correctly)
 {
   this->is_integrated_correctly();
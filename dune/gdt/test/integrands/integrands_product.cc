@@ -104,6 +104,22 @@ struct ProductIntegrandTest : public IntegrandTest<G>
     }
   }
 
+  void evaluate_all_coincides_with_pointwise_loop()
+  {
+    const XT::Functions::GenericGridFunction<E, 1> scalar_inducing_function(
+        2, [](const E&) {}, [](const DomainType& x, const XT::Common::Parameter&) { return x[0] * x[1]; });
+    ScalarIntegrandType scalar_integrand(scalar_inducing_function);
+    this->check_evaluate_all_against_pointwise_loop(scalar_integrand, *scalar_test_, *scalar_ansatz_);
+    const XT::Functions::GenericGridFunction<E, 2, 2> inducing_function(
+        1,
+        [](const E&) {},
+        [](const DomainType& x, const XT::Common::Parameter&) {
+          return VectorJacobianType{{x[0], x[1]}, {1., 2.}};
+        });
+    VectorIntegrandType vector_integrand(inducing_function);
+    this->check_evaluate_all_against_pointwise_loop(vector_integrand, *vector_test_, *vector_ansatz_);
+  }
+
   void is_integrated_correctly()
   {
     ScalarIntegrandType integrand(1.);
@@ -158,6 +174,11 @@ TYPED_TEST(ProductIntegrandTest, evaluates_correctly_for_vector_bases)
   this->evaluates_correctly_for_vector_bases();
 }
 
+TYPED_TEST(ProductIntegrandTest, evaluate_all_coincides_with_pointwise_loop)
+{
+  this->evaluate_all_coincides_with_pointwise_loop();
+}
+
 TYPED_TEST(ProductIntegrandTest, is_integrated_correctly)
 {
   this->is_integrated_correctly();
@@ -0,0 +1,120 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/interpolations.hh>
+#include <dune/gdt/local/numerical-fluxes/engquist-osher.hh>
+#include <dune/gdt/operators/advection-dg.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_1D_EQUIDISTANT_OFFSET;
+using GV = typename G::LeafGridView;
+using I = XT::Grid::extract_intersection_t<GV>;
+using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+using V = XT::LA::IstlDenseVector<double>;
+using OperatorType = AdvectionDgOperator<M, GV>;
+
+
+struct AdvectionDgOperatorFusedInverseMassTest : public ::testing::Test
+{
+  AdvectionDgOperatorFusedInverseMassTest()
+    : grid(XT::Grid::make_cube_grid<G>(0., 1., 32u))
+    , grid_view(grid.leaf_view())
+    , flux(
+          2,
+          [](const auto& u, const auto& /*param*/) { return 0.5 * u * u; },
+          "burgers",
+          {},
+          [](const auto& u, const auto& /*param*/) { return u; })
+    , numerical_flux(flux)
+  {}
+
+  OperatorType make_operator(const SpaceInterface<GV>& space, const bool fuse_inverse_mass_application) const
+  {
+    // a large nu_1, so that the artificial viscosity is active at the discontinuity of the source
+    return OperatorType(grid_view,
+                        numerical_flux,
+                        space,
+                        space,
+                        XT::Grid::ApplyOn::NoIntersections<GV>(),
+                        /*artificial_viscosity_nu_1=*/1.,
+                        advection_dg_artificial_viscosity_default_alpha_1(),
+                        advection_dg_artificial_viscosity_default_component(),
+                        fuse_inverse_mass_application);
+  }
+
+  template <class AppendBoundaryTreatmentType>
+  void fused_and_unfused_apply_coincide(const AppendBoundaryTreatmentType& append_boundary_treatment) const
+  {
+    for (int order : {1, 2, 3}) {
+      const auto space = make_discontinuous_lagrange_space(grid_view, order);
+      // a discontinuous source, to trigger the shock capturing
+      const auto source = default_interpolation<V>(
+          order, [](const auto& xx, const auto& /*mu*/) { return xx[0] < 0.5 ? 1. : 0.; }, space);
+      auto op = make_operator(space, /*fuse_inverse_mass_application=*/false);
+      append_boundary_treatment(op);
+      auto fused_op = make_operator(space, /*fuse_inverse_mass_application=*/true);
+      append_boundary_treatment(fused_op);
+      V range(space.mapper().size(), 0.);
+      op.apply(source.dofs().vector(), range);
+      V fused_range(space.mapper().size(), 0.);
+      fused_op.apply(source.dofs().vector(), fused_range);
+      EXPECT_LT((range - fused_range).sup_norm(), 1e-12 * std::max(1., range.sup_norm())) << "order = " << order;
+    }
+  } // ... fused_and_unfused_apply_coincide(...)
+
+  XT::Grid::GridProvider<G> grid;
+  const GV grid_view;
+  const XT::Functions::GenericFunction<1, 1, 1> flux;
+  const NumericalEngquistOsherFlux<I, 1, 1> numerical_flux;
+}; // struct AdvectionDgOperatorFusedInverseMassTest
+
+
+TEST_F(AdvectionDgOperatorFusedInverseMassTest, boundary_treatment_by_extrapolation)
+{
+  this->fused_and_unfused_apply_coincide([](OperatorType& op) {
+    op.append(OperatorType::BoundaryTreatmentByCustomExtrapolationOperatorType::LambdaType(
+        [](const auto& /*intersection*/,
+           const auto& /*xx_in_reference_intersection_coordinates*/,
+           const auto& /*flux*/,
+           const auto& u,
+           const auto& /*param*/) { return u; }));
+  });
+}
+
+
+TEST_F(AdvectionDgOperatorFusedInverseMassTest, boundary_treatment_by_custom_numerical_flux)
+{
+  // inflow of the left state, outflow otherwise
+  this->fused_and_unfused_apply_coincide([](OperatorType& op) {
+    op.append(OperatorType::BoundaryTreatmentByCustomNumericalFluxOperatorType::LambdaType(
+                  [](const auto& u, const auto& n, const auto& /*param*/) {
+                    auto ret = u;
+                    if (n[0] < 0)
+                      ret[0] = -0.5;
+                    else
+                      ret[0] = 0.5 * u[0] * u[0];
+                    return ret;
+                  }),
+              /*numerical_boundary_treatment_flux_order=*/2);
+  });
+}
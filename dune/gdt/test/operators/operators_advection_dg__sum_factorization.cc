@@ -0,0 +1,96 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/common/fvector.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/la/container/common.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/local/numerical-fluxes/upwind.hh>
+#include <dune/gdt/local/operators/advection-dg.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+template <class G>
+struct LocalAdvectionDgVolumeOperatorTest : public ::testing::Test
+{
+  using GV = typename G::LeafGridView;
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using V = XT::LA::CommonDenseVector<double>;
+  static constexpr size_t d = G::dimension;
+
+  void sum_factorized_and_generic_volume_integrals_coincide()
+  {
+    // a non-linear flux, to have a non-trivial integrand order
+    const XT::Common::FieldVector<double, d> direction(1.);
+    const XT::Functions::GenericFunction<1, d, 1> flux(
+        2,
+        [&](const auto& u, const auto& /*param*/) {
+          auto ret = direction;
+          ret *= 0.5 * u[0] * u[0];
+          return ret;
+        },
+        "burgers",
+        {},
+        [&](const auto& u, const auto& /*param*/) {
+          auto ret = direction;
+          ret *= u[0];
+          return ret;
+        });
+    const NumericalUpwindFlux<I, d, 1> numerical_flux(flux);
+    auto grid = XT::Grid::make_cube_grid<G>(-1., 1., 3u);
+    const auto grid_view = grid.leaf_view();
+    for (int order : {1, 2, 3}) {
+      const auto space = make_discontinuous_lagrange_space(grid_view, order);
+      DiscreteFunction<V, GV> source(space);
+      for (size_t ii = 0; ii < source.dofs().vector().size(); ++ii)
+        source.dofs().vector()[ii] = std::sin(double(ii));
+      const size_t num_elements = grid_view.indexSet().size(0);
+      const auto apply = [&](const bool use_sum_factorization) {
+        DiscreteFunction<V, GV> range(space);
+        LocalAdvectionDgVolumeOperator<V, GV> local_operator(source, numerical_flux.flux());
+        local_operator.use_sum_factorization(use_sum_factorization);
+        auto local_range = range.local_discrete_function();
+        for (auto&& element : elements(grid_view)) {
+          local_range->bind(element);
+          local_operator.bind(element);
+          local_operator.apply(*local_range);
+        }
+        // make sure that the respective path was actually taken on each element
+        EXPECT_EQ(local_operator.num_sum_factorized_applications(), use_sum_factorization ? num_elements : 0)
+            << "order = " << order;
+        return range.dofs().vector();
+      };
+      const auto generic_result = apply(false);
+      const auto sum_factorized_result = apply(true);
+      EXPECT_LT((generic_result - sum_factorized_result).sup_norm(), 1e-12 * std::max(1., generic_result.sup_norm()))
+          << "order = " << order;
+    }
+  } // ... sum_factorized_and_generic_volume_integrals_coincide(...)
+}; // struct LocalAdvectionDgVolumeOperatorTest
+
+
+using CubicGrids = ::testing::Types<YASP_2D_EQUIDISTANT_OFFSET, YASP_3D_EQUIDISTANT_OFFSET>;
+
+TYPED_TEST_SUITE(LocalAdvectionDgVolumeOperatorTest, CubicGrids);
+TYPED_TEST(LocalAdvectionDgVolumeOperatorTest, sum_factorized_and_generic_volume_integrals_coincide)
+{
+  this->sum_factorized_and_generic_volume_integrals_coincide();
+}
@@ -0,0 +1,260 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/view/periodic.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/interpolations.hh>
+#include <dune/gdt/local/numerical-fluxes/engquist-osher.hh>
+#include <dune/gdt/local/numerical-fluxes/lax-friedrichs.hh>
+#include <dune/gdt/local/numerical-fluxes/upwind.hh>
+#include <dune/gdt/local/numerical-fluxes/vijayasundaram.hh>
+#include <dune/gdt/operators/advection-fv.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Compares the face-batched mode of AdvectionFvOperator (sequential, with TBB and on a decomposition into element
+ * ranges) with the grid walk over local coupling operators, for each numerical flux providing apply_batch.
+ */
+template <class G>
+struct AdvectionFvOperatorFaceBatchesTest : public ::testing::Test
+{
+  static constexpr size_t d = G::dimension;
+  using GV = decltype(XT::Grid::make_periodic_grid_view(std::declval<typename G::LeafGridView>()));
+  using E = XT::Grid::extract_entity_t<GV>;
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+  using OperatorType = AdvectionFvOperator<M, GV>;
+
+  AdvectionFvOperatorFaceBatchesTest()
+    : grid(XT::Grid::make_cube_grid<G>(0., 1., 8u))
+    , grid_view(XT::Grid::make_periodic_grid_view(grid.leaf_view()))
+    , space(make_finite_volume_space(grid_view))
+    , direction(1.)
+    , flux(
+          2,
+          [&](const auto& u, const auto& /*param*/) {
+            auto ret = direction;
+            ret *= 0.5 * u[0] * u[0];
+            return ret;
+          },
+          "burgers",
+          {},
+          [&](const auto& u, const auto& /*param*/) {
+            auto ret = direction;
+            ret *= u[0];
+            return ret;
+          })
+    , source(default_interpolation<V>(
+          0,
+          [](const auto& xx, const auto& /*mu*/) {
+            // changes sign, so that the upwind direction differs between the faces
+            return std::sin(2. * M_PI * xx[0]) + 0.5 * std::cos(2. * M_PI * xx[d - 1]);
+          },
+          space))
+  {}
+
+  void batched_and_unbatched_apply_coincide(const NumericalFluxInterface<I, d, 1>& numerical_flux) const
+  {
+    const auto& source_vector = source.dofs().vector();
+    const OperatorType op(grid_view, numerical_flux, space, space);
+    V expected(space.mapper().size(), 0.);
+    op.apply(source_vector, expected);
+    const double tolerance = 1e-12 * std::max(1., expected.sup_norm());
+    for (const bool use_tbb : {false, true}) {
+      // a batch size which does not divide the number of faces
+      const OperatorType batched_op(
+          grid_view, numerical_flux, space, space, use_tbb, XT::Grid::ApplyOn::NoIntersections<GV>(), 7);
+      V range(space.mapper().size(), 1.);
+      batched_op.apply(source_vector, range);
+      EXPECT_LT((range - expected).sup_norm(), tolerance) << "use_tbb = " << use_tbb;
+      // on a decomposition into two element ranges, as in split-phase communication
+      std::vector<E> first_half, second_half;
+      for (auto&& element : elements(grid_view))
+        (grid_view.indexSet().index(element) % 2 == 0 ? first_half : second_half).push_back(element);
+      range.set_all(1.);
+      batched_op.apply_range(source, range, {}, first_half, /*clear_range=*/true);
+      batched_op.apply_range(source, range, {}, second_half, /*clear_range=*/false);
+      EXPECT_LT((range - expected).sup_norm(), tolerance) << "apply_range, use_tbb = " << use_tbb;
+    }
+  } // ... batched_and_unbatched_apply_coincide(...)
+
+  XT::Grid::GridProvider<G> grid;
+  const GV grid_view;
+  const FiniteVolumeSpace<GV> space;
+  const XT::Common::FieldVector<double, d> direction;
+  const XT::Functions::GenericFunction<1, d, 1> flux;
+  const DiscreteFunction<V, GV> source;
+}; // struct AdvectionFvOperatorFaceBatchesTest
+
+
+using Grids = ::testing::Types<YASP_1D_EQUIDISTANT_OFFSET, YASP_2D_EQUIDISTANT_OFFSET>;
+
+TYPED_TEST_SUITE(AdvectionFvOperatorFaceBatchesTest, Grids);
+TYPED_TEST(AdvectionFvOperatorFaceBatchesTest, upwind)
+{
+  using I = typename TestFixture::I;
+  this->batched_and_unbatched_apply_coincide(NumericalUpwindFlux<I, TestFixture::d, 1>(this->flux));
+}
+TYPED_TEST(AdvectionFvOperatorFaceBatchesTest, lax_friedrichs)
+{
+  using I = typename TestFixture::I;
+  this->batched_and_unbatched_apply_coincide(NumericalLaxFriedrichsFlux<I, TestFixture::d, 1>(this->flux));
+}
+TYPED_TEST(AdvectionFvOperatorFaceBatchesTest, engquist_osher)
+{
+  using I = typename TestFixture::I;
+  this->batched_and_unbatched_apply_coincide(NumericalEngquistOsherFlux<I, TestFixture::d, 1>(this->flux));
+}
+TYPED_TEST(AdvectionFvOperatorFaceBatchesTest, vijayasundaram)
+{
+  using I = typename TestFixture::I;
+  this->batched_and_unbatched_apply_coincide(NumericalVijayasundaramFlux<I, TestFixture::d, 1>(this->flux));
+}
+
+
+/**
+ * Compares the face data cache of AdvectionFvOperator with the grid walk over local coupling operators on a
+ * non-periodic grid, where the first intersection of the grid view is a boundary intersection.
+ */
+GTEST_TEST(AdvectionFvOperatorFaceData, cached_and_unbatched_apply_coincide_on_nonperiodic_grid)
+{
+  using G = YASP_2D_EQUIDISTANT_OFFSET;
+  using GV = typename G::LeafGridView;
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+  using OperatorType = AdvectionFvOperator<M, GV>;
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 8u);
+  const auto grid_view = grid.leaf_view();
+  const auto space = make_finite_volume_space(grid_view);
+  const XT::Common::FieldVector<double, 2> direction(1.);
+  const XT::Functions::GenericFunction<1, 2, 1> flux(
+      2,
+      [&](const auto& u, const auto& /*param*/) {
+        auto ret = direction;
+        ret *= 0.5 * u[0] * u[0];
+        return ret;
+      },
+      "burgers",
+      {},
+      [&](const auto& u, const auto& /*param*/) {
+        auto ret = direction;
+        ret *= u[0];
+        return ret;
+      });
+  const NumericalEngquistOsherFlux<I, 2, 1> numerical_flux(flux);
+  const auto source = default_interpolation<V>(
+      0, [](const auto& xx, const auto& /*mu*/) { return std::sin(2. * M_PI * xx[0]) * xx[1]; }, space);
+  const auto extrapolation = [](const auto& /*intersection*/,
+                                const auto& /*xx_in_reference_intersection_coordinates*/,
+                                const auto& /*flux*/,
+                                const auto& u,
+                                auto& v,
+                                const auto& /*param*/) { v = u; };
+  OperatorType op(grid_view, numerical_flux, space, space);
+  op.append(typename OperatorType::BoundaryTreatmentByCustomExtrapolationOperatorType::LambdaType(extrapolation));
+  V expected(space.mapper().size(), 0.);
+  op.apply(source.dofs().vector(), expected);
+  OperatorType cached_op(grid_view,
+                         numerical_flux,
+                         space,
+                         space,
+                         /*use_tbb=*/false,
+                         XT::Grid::ApplyOn::NoIntersections<GV>(),
+                         /*face_batch_size=*/7,
+                         /*cache_face_data=*/true);
+  cached_op.append(
+      typename OperatorType::BoundaryTreatmentByCustomExtrapolationOperatorType::LambdaType(extrapolation));
+  V range(space.mapper().size(), 1.);
+  cached_op.apply(source.dofs().vector(), range);
+  EXPECT_LT((range - expected).sup_norm(), 1e-12 * std::max(1., expected.sup_norm()));
+} // GTEST_TEST(AdvectionFvOperatorFaceData, cached_and_unbatched_apply_coincide_on_nonperiodic_grid)
+
+
+/**
+ * Applies an AdvectionFvOperator with face data cache (and use_tbb) concurrently from several threads, each with its
+ * own range, and compares with the grid walk over local coupling operators.
+ */
+GTEST_TEST(AdvectionFvOperatorFaceData, concurrent_cached_apply_coincides_with_unbatched_apply)
+{
+  using G = YASP_2D_EQUIDISTANT_OFFSET;
+  using GV = decltype(XT::Grid::make_periodic_grid_view(std::declval<typename G::LeafGridView>()));
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+  using OperatorType = AdvectionFvOperator<M, GV>;
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 16u);
+  const auto grid_view = XT::Grid::make_periodic_grid_view(grid.leaf_view());
+  const auto space = make_finite_volume_space(grid_view);
+  const XT::Common::FieldVector<double, 2> direction(1.);
+  const XT::Functions::GenericFunction<1, 2, 1> flux(
+      2,
+      [&](const auto& u, const auto& /*param*/) {
+        auto ret = direction;
+        ret *= 0.5 * u[0] * u[0];
+        return ret;
+      },
+      "burgers",
+      {},
+      [&](const auto& u, const auto& /*param*/) {
+        auto ret = direction;
+        ret *= u[0];
+        return ret;
+      });
+  const NumericalEngquistOsherFlux<I, 2, 1> numerical_flux(flux);
+  const auto source = default_interpolation<V>(
+      0, [](const auto& xx, const auto& /*mu*/) { return std::sin(2. * M_PI * xx[0]) * xx[1]; }, space);
+  const OperatorType op(grid_view, numerical_flux, space, space);
+  V expected(space.mapper().size(), 0.);
+  op.apply(source.dofs().vector(), expected);
+  const double tolerance = 1e-12 * std::max(1., expected.sup_norm());
+  for (const bool use_tbb : {false, true}) {
+    const OperatorType cached_op(grid_view,
+                                 numerical_flux,
+                                 space,
+                                 space,
+                                 use_tbb,
+                                 XT::Grid::ApplyOn::NoIntersections<GV>(),
+                                 /*face_batch_size=*/7,
+                                 /*cache_face_data=*/true);
+    const size_t num_threads = 4;
+    // separately constructed, so that the ranges do not share their data
+    std::vector<V> ranges;
+    for (size_t ii = 0; ii < num_threads; ++ii)
+      ranges.emplace_back(space.mapper().size(), 1.);
+    std::vector<std::thread> threads;
+    for (size_t ii = 0; ii < num_threads; ++ii)
+      threads.emplace_back([&, ii]() {
+        for (size_t rr = 0; rr < 10; ++rr)
+          cached_op.apply(source.dofs().vector(), ranges[ii]);
+      });
+    for (auto& thread : threads)
+      thread.join();
+    for (size_t ii = 0; ii < num_threads; ++ii)
+      EXPECT_LT((ranges[ii] - expected).sup_norm(), tolerance) << "use_tbb = " << use_tbb << ", thread " << ii;
+  }
+} // GTEST_TEST(AdvectionFvOperatorFaceData, concurrent_cached_apply_coincides_with_unbatched_apply)
@@ -0,0 +1,123 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/view/periodic.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/interpolations.hh>
+#include <dune/gdt/local/numerical-fluxes/engquist-osher.hh>
+#include <dune/gdt/operators/advection-fv.hh>
+#include <dune/gdt/operators/advection-fv-flat.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Compares AdvectionFvFlatOperator (sequential and with TBB) with AdvectionFvOperator, on a periodic grid view and on
+ * a grid view with boundary (and a boundary treatment by extrapolation).
+ */
+template <class G>
+struct AdvectionFvFlatOperatorTest : public ::testing::Test
+{
+  static constexpr size_t d = G::dimension;
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+
+  AdvectionFvFlatOperatorTest()
+    : grid(XT::Grid::make_cube_grid<G>(0., 1., 8u))
+    , direction(1.)
+    , flux(
+          2,
+          [&](const auto& u, const auto& /*param*/) {
+            auto ret = direction;
+            ret *= 0.5 * u[0] * u[0];
+            return ret;
+          },
+          "burgers",
+          {},
+          [&](const auto& u, const auto& /*param*/) {
+            auto ret = direction;
+            ret *= u[0];
+            return ret;
+          })
+  {}
+
+  template <class GV>
+  void flat_and_reference_apply_coincide(const GV& grid_view, const bool with_boundary_treatment) const
+  {
+    using I = XT::Grid::extract_intersection_t<GV>;
+    using ReferenceOperatorType = AdvectionFvOperator<M, GV>;
+    using FlatOperatorType = AdvectionFvFlatOperator<M, GV>;
+    using ExtrapolationType = typename FlatOperatorType::BoundaryTreatmentByCustomExtrapolationOperatorType::LambdaType;
+    const auto space = make_finite_volume_space(grid_view);
+    const NumericalEngquistOsherFlux<I, d, 1> numerical_flux(flux);
+    const auto source = default_interpolation<V>(
+        0,
+        [](const auto& xx, const auto& /*mu*/) {
+          return std::sin(2. * M_PI * xx[0]) + 0.5 * std::cos(2. * M_PI * xx[d - 1]);
+        },
+        space);
+    const auto extrapolation = [](const auto& /*intersection*/,
+                                  const auto& /*xx_in_reference_intersection_coordinates*/,
+                                  const auto& /*flux*/,
+                                  const auto& u,
+                                  auto& v,
+                                  const auto& /*param*/) { v = u; };
+    ReferenceOperatorType reference_op(grid_view, numerical_flux, space, space);
+    if (with_boundary_treatment)
+      reference_op.append(ExtrapolationType(extrapolation));
+    V expected(space.mapper().size(), 0.);
+    reference_op.apply(source.dofs().vector(), expected);
+    for (const bool use_tbb : {false, true}) {
+      // a batch size which does not divide the number of faces
+      FlatOperatorType flat_op(grid_view, numerical_flux, space, space, use_tbb, /*face_batch_size=*/7);
+      if (with_boundary_treatment)
+        flat_op.append(ExtrapolationType(extrapolation));
+      V range(space.mapper().size(), 1.);
+      // a copy sharing its data with range, which has to be left untouched
+      const auto range_copy = range;
+      flat_op.apply(source.dofs().vector(), range);
+      EXPECT_LT((range - expected).sup_norm(), 1e-12 * std::max(1., expected.sup_norm())) << "use_tbb = " << use_tbb;
+      EXPECT_EQ(range_copy.sup_norm(), 1.) << "use_tbb = " << use_tbb;
+    }
+  } // ... flat_and_reference_apply_coincide(...)
+
+  XT::Grid::GridProvider<G> grid;
+  const XT::Common::FieldVector<double, d> direction;
+  const XT::Functions::GenericFunction<1, d, 1> flux;
+}; // struct AdvectionFvFlatOperatorTest
+
+
+using Grids = ::testing::Types<YASP_1D_EQUIDISTANT_OFFSET, YASP_2D_EQUIDISTANT_OFFSET>;
+
+TYPED_TEST_SUITE(AdvectionFvFlatOperatorTest, Grids);
+TYPED_TEST(AdvectionFvFlatOperatorTest, periodic)
+{
+  this->flat_and_reference_apply_coincide(XT::Grid::make_periodic_grid_view(this->grid.leaf_view()),
+                                          /*with_boundary_treatment=*/false);
+}
+TYPED_TEST(AdvectionFvFlatOperatorTest, boundary_without_treatment)
+{
+  this->flat_and_reference_apply_coincide(this->grid.leaf_view(), /*with_boundary_treatment=*/false);
+}
+TYPED_TEST(AdvectionFvFlatOperatorTest, boundary_with_extrapolation)
+{
+  this->flat_and_reference_apply_coincide(this->grid.leaf_view(), /*with_boundary_treatment=*/true);
+}
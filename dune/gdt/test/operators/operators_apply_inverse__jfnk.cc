@@ -0,0 +1,80 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/view/periodic.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/interpolations.hh>
+#include <dune/gdt/local/numerical-fluxes/engquist-osher.hh>
+#include <dune/gdt/operators/advection-fv.hh>
+#include <dune/gdt/operators/identity.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_1D_EQUIDISTANT_OFFSET;
+using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+using V = XT::LA::IstlDenseVector<double>;
+
+
+/**
+ * One implicit Euler step of a finite volume discretization of Burgers' equation, solved with the "jfnk" and the
+ * "newton" inversion of OperatorInterface::apply_inverse.
+ */
+GTEST_TEST(OperatorApplyInverse, jfnk_coincides_with_newton_for_implicit_fv_step)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 64u);
+  auto grid_view = XT::Grid::make_periodic_grid_view(grid.leaf_view());
+  using GV = decltype(grid_view);
+  using I = XT::Grid::extract_intersection_t<GV>;
+  const auto space = make_finite_volume_space(grid_view);
+  const XT::Functions::GenericFunction<1, 1, 1> flux(
+      2,
+      [](const auto& u, const auto& /*param*/) { return 0.5 * u * u; },
+      "burgers",
+      {},
+      [](const auto& u, const auto& /*param*/) { return u; });
+  const NumericalEngquistOsherFlux<I, 1, 1> numerical_flux(flux);
+  auto spatial_op = make_advection_fv_operator<M>(grid_view, numerical_flux, space, space);
+  const auto u_n = default_interpolation<V>(
+      0, [](const auto& xx, const auto& /*param*/) { return 1. + 0.5 * std::sin(2. * M_PI * xx[0]); }, space);
+  // a time step well beyond the explicit CFL restriction
+  const double dt = 10. / 64.;
+  auto id = make_identity_operator(spatial_op);
+  V zero(space.mapper().size(), 0.);
+  auto residual_op = (id - u_n.dofs().vector()) / dt + spatial_op;
+  const auto solve = [&](const XT::Common::Configuration& opts) {
+    auto u_n_plus_one = u_n.dofs().vector().copy();
+    residual_op.apply_inverse(zero, u_n_plus_one, opts);
+    return u_n_plus_one;
+  };
+  auto newton_opts = residual_op.invert_options("newton");
+  newton_opts["precision"] = "1e-10";
+  const auto newton_solution = solve(newton_opts);
+  for (const std::string preconditioner : {"none", "jacobian"}) {
+    auto jfnk_opts = residual_op.invert_options("jfnk");
+    jfnk_opts["precision"] = "1e-10";
+    jfnk_opts["preconditioner"] = preconditioner;
+    const auto jfnk_solution = solve(jfnk_opts);
+    // both solutions have a residual below 1e-10, the implicit Euler step is well conditioned
+    EXPECT_LT((jfnk_solution - newton_solution).sup_norm(), 1e-8 * std::max(1., newton_solution.sup_norm()))
+        << "preconditioner = " << preconditioner;
+  }
+} // GTEST_TEST(OperatorApplyInverse, jfnk_coincides_with_newton_for_implicit_fv_step)
@@ -0,0 +1,101 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/view/periodic.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/interpolations.hh>
+#include <dune/gdt/local/numerical-fluxes/engquist-osher.hh>
+#include <dune/gdt/operators/advection-fv.hh>
+#include <dune/gdt/operators/identity.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_1D_EQUIDISTANT_OFFSET;
+using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+using V = XT::LA::IstlDenseVector<double>;
+
+
+/**
+ * Two implicit Euler steps of a finite volume discretization of Burgers' equation, solved with the plain "newton"
+ * inversion of OperatorInterface::apply_inverse and with a lagged jacobian, a jacobian kept in a NewtonJacobianCache
+ * across both steps and the Eisenstat-Walker forcing.
+ */
+GTEST_TEST(OperatorApplyInverse, newton_variants_coincide_with_plain_newton_for_implicit_fv_steps)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 64u);
+  auto grid_view = XT::Grid::make_periodic_grid_view(grid.leaf_view());
+  using GV = decltype(grid_view);
+  using I = XT::Grid::extract_intersection_t<GV>;
+  const auto space = make_finite_volume_space(grid_view);
+  const XT::Functions::GenericFunction<1, 1, 1> flux(
+      2,
+      [](const auto& u, const auto& /*param*/) { return 0.5 * u * u; },
+      "burgers",
+      {},
+      [](const auto& u, const auto& /*param*/) { return u; });
+  const NumericalEngquistOsherFlux<I, 1, 1> numerical_flux(flux);
+  auto spatial_op = make_advection_fv_operator<M>(grid_view, numerical_flux, space, space);
+  const auto u_0 = default_interpolation<V>(
+      0, [](const auto& xx, const auto& /*param*/) { return 1. + 0.5 * std::sin(2. * M_PI * xx[0]); }, space);
+  // a time step well beyond the explicit CFL restriction
+  const double dt = 10. / 64.;
+  auto id = make_identity_operator(spatial_op);
+  V zero(space.mapper().size(), 0.);
+  using NewtonJacobianCache = typename decltype(spatial_op)::NewtonJacobianCache;
+  // computes u_2 from u_0, by two implicit Euler steps
+  const auto two_steps = [&](const XT::Common::Configuration& opts, NewtonJacobianCache* jacobian_cache) {
+    V u_n = u_0.dofs().vector().copy();
+    for (size_t step = 0; step < 2; ++step) {
+      auto residual_op = (id - u_n) / dt + spatial_op;
+      auto u_n_plus_one = u_n.copy();
+      if (jacobian_cache)
+        residual_op.apply_inverse(zero, u_n_plus_one, opts, *jacobian_cache);
+      else
+        residual_op.apply_inverse(zero, u_n_plus_one, opts);
+      u_n = u_n_plus_one;
+    }
+    return u_n;
+  };
+  auto newton_opts = spatial_op.invert_options("newton");
+  newton_opts["precision"] = "1e-10";
+  const auto expected = two_steps(newton_opts, nullptr);
+  const double tolerance = 1e-8 * std::max(1., expected.sup_norm());
+  {
+    auto opts = newton_opts;
+    opts["jacobian_lag"] = "3";
+    EXPECT_LT((two_steps(opts, nullptr) - expected).sup_norm(), tolerance) << "jacobian_lag = 3";
+  }
+  {
+    auto opts = newton_opts;
+    opts["jacobian_lag"] = "3";
+    NewtonJacobianCache jacobian_cache;
+    EXPECT_LT((two_steps(opts, &jacobian_cache) - expected).sup_norm(), tolerance) << "NewtonJacobianCache";
+    // the cache is kept for another solve
+    EXPECT_TRUE(jacobian_cache.matches(space, space));
+    EXPECT_LT((two_steps(opts, &jacobian_cache) - expected).sup_norm(), tolerance) << "reused NewtonJacobianCache";
+  }
+  {
+    auto opts = newton_opts;
+    opts["forcing"] = "eisenstat_walker";
+    EXPECT_LT((two_steps(opts, nullptr) - expected).sup_norm(), tolerance) << "forcing = eisenstat_walker";
+  }
+} // GTEST_TEST(OperatorApplyInverse, newton_variants_coincide_with_plain_newton_for_implicit_fv_steps)
@@ -0,0 +1,113 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/interpolations.hh>
+#include <dune/gdt/local/numerical-fluxes/engquist-osher.hh>
+#include <dune/gdt/operators/advection-dg.hh>
+#include <dune/gdt/operators/matrix-based.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Compares the "colored-finite-differences" jacobian of a nonlinear LocalizableOperator with its (uncolored)
+ * "finite-differences" jacobian.
+ */
+template <class G>
+struct LocalizableOperatorColoredFiniteDifferencesTest : public ::testing::Test
+{
+  static constexpr size_t d = G::dimension;
+  using GV = typename G::LeafGridView;
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+  using OperatorType = AdvectionDgOperator<M, GV>;
+
+  LocalizableOperatorColoredFiniteDifferencesTest()
+    : grid(XT::Grid::make_cube_grid<G>(0., 1., 4u))
+    , grid_view(grid.leaf_view())
+    , direction(1.)
+    , flux(
+          2,
+          [&](const auto& u, const auto& /*param*/) {
+            auto ret = direction;
+            ret *= 0.5 * u[0] * u[0];
+            return ret;
+          },
+          "burgers",
+          {},
+          [&](const auto& u, const auto& /*param*/) {
+            auto ret = direction;
+            ret *= u[0];
+            return ret;
+          })
+    , numerical_flux(flux)
+  {}
+
+  void colored_and_uncolored_jacobian_coincide() const
+  {
+    for (int order : {0, 1, 2}) {
+      const auto space = make_discontinuous_lagrange_space(grid_view, order);
+      // no artificial viscosity, which is not differentiable
+      OperatorType op(
+          grid_view, numerical_flux, space, space, XT::Grid::ApplyOn::NoIntersections<GV>(), /*nu_1=*/0.);
+      op.append(typename OperatorType::BoundaryTreatmentByCustomExtrapolationOperatorType::LambdaType(
+          [](const auto& /*intersection*/,
+             const auto& /*xx_in_reference_intersection_coordinates*/,
+             const auto& /*flux*/,
+             const auto& u,
+             const auto& /*param*/) { return u; }));
+      const auto source = default_interpolation<V>(
+          std::max(order, 1),
+          [](const auto& xx, const auto& /*mu*/) { return 1. + std::sin(2. * M_PI * xx[0]) * xx[d - 1]; },
+          space);
+      auto jacobian_op = make_matrix_operator<M>(grid_view, space, Stencil::element_and_intersection);
+      op.jacobian(source.dofs().vector(), jacobian_op, {{"type", "finite-differences"}});
+      jacobian_op.walk();
+      auto colored_jacobian_op = make_matrix_operator<M>(grid_view, space, Stencil::element_and_intersection);
+      // twice, the second call reuses the coloring
+      for (size_t ii = 0; ii < 2; ++ii) {
+        colored_jacobian_op.matrix() *= 0.;
+        op.jacobian(source.dofs().vector(), colored_jacobian_op, {{"type", "colored-finite-differences"}});
+        auto difference = colored_jacobian_op.matrix();
+        difference.axpy(-1., jacobian_op.matrix());
+        EXPECT_LT(difference.sup_norm(), 1e-5 * std::max(1., jacobian_op.matrix().sup_norm()))
+            << "order = " << order << ", call " << ii;
+      }
+    }
+  } // ... colored_and_uncolored_jacobian_coincide(...)
+
+  XT::Grid::GridProvider<G> grid;
+  const GV grid_view;
+  const XT::Common::FieldVector<double, d> direction;
+  const XT::Functions::GenericFunction<1, d, 1> flux;
+  const NumericalEngquistOsherFlux<I, d, 1> numerical_flux;
+}; // struct LocalizableOperatorColoredFiniteDifferencesTest
+
+
+using Grids = ::testing::Types<YASP_1D_EQUIDISTANT_OFFSET, YASP_2D_EQUIDISTANT_OFFSET>;
+
+TYPED_TEST_SUITE(LocalizableOperatorColoredFiniteDifferencesTest, Grids);
+TYPED_TEST(LocalizableOperatorColoredFiniteDifferencesTest, colored_and_uncolored_jacobian_coincide)
+{
+  this->colored_and_uncolored_jacobian_coincide();
+}
@@ -0,0 +1,111 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/filters/intersection.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/la/container/istl.hh>
+
+#include <dune/gdt/local/bilinear-forms/integrals.hh>
+#include <dune/gdt/local/integrands/ipdg.hh>
+#include <dune/gdt/local/integrands/laplace.hh>
+#include <dune/gdt/local/integrands/product.hh>
+#include <dune/gdt/operators/matrix-based.hh>
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_2D_EQUIDISTANT_OFFSET;
+using GV = typename G::LeafGridView;
+using E = XT::Grid::extract_entity_t<GV>;
+using I = XT::Grid::extract_intersection_t<GV>;
+using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+
+
+template <class OperatorType>
+void expect_cached_assembly_equals_uncached_assembly(OperatorType& cached_op,
+                                                     OperatorType& uncached_op,
+                                                     const size_t num_assemblies = 2)
+{
+  cached_op.cache_matrix_positions();
+  for (size_t ii = 0; ii < num_assemblies; ++ii) {
+    // the first assembly builds the cache, all further ones use it
+    EXPECT_NO_THROW(cached_op.assemble(/*use_tbb=*/true));
+    uncached_op.assemble(/*use_tbb=*/true);
+  }
+  const auto& cached_matrix = cached_op.matrix();
+  const auto& uncached_matrix = uncached_op.matrix();
+  ASSERT_EQ(cached_matrix.rows(), uncached_matrix.rows());
+  ASSERT_EQ(cached_matrix.cols(), uncached_matrix.cols());
+  for (size_t ii = 0; ii < cached_matrix.rows(); ++ii)
+    for (size_t jj = 0; jj < cached_matrix.cols(); ++jj)
+      EXPECT_DOUBLE_EQ(cached_matrix.get_entry(ii, jj), uncached_matrix.get_entry(ii, jj))
+          << "ii = " << ii << ", jj = " << jj;
+} // ... expect_cached_assembly_equals_uncached_assembly(...)
+
+
+GTEST_TEST(MatrixOperatorPositionCache, element_stencil_cg_laplace)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4u);
+  const auto space = make_continuous_lagrange_space(grid.leaf_view(), 2);
+  auto cached_op = make_matrix_operator<M>(space, Stencil::element);
+  auto uncached_op = make_matrix_operator<M>(space, Stencil::element);
+  for (auto op : {&cached_op, &uncached_op}) {
+    op->append(LocalElementIntegralBilinearForm<E>(LocalLaplaceIntegrand<E>()));
+    op->append(LocalElementIntegralBilinearForm<E>(LocalProductIntegrand<E>()));
+  }
+  expect_cached_assembly_equals_uncached_assembly(cached_op, uncached_op);
+}
+
+
+GTEST_TEST(MatrixOperatorPositionCache, element_stencil_dg_mass)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4u);
+  const auto space = make_discontinuous_lagrange_space(grid.leaf_view(), 1);
+  auto cached_op = make_matrix_operator<M>(space, Stencil::element);
+  auto uncached_op = make_matrix_operator<M>(space, Stencil::element);
+  for (auto op : {&cached_op, &uncached_op})
+    op->append(LocalElementIntegralBilinearForm<E>(LocalProductIntegrand<E>()));
+  expect_cached_assembly_equals_uncached_assembly(cached_op, uncached_op);
+}
+
+
+GTEST_TEST(MatrixOperatorPositionCache, intersection_stencil)
+{
+  // the pattern does not contain the element blocks, which must thus not be cached
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4u);
+  const auto space = make_discontinuous_lagrange_space(grid.leaf_view(), 1);
+  auto cached_op = make_matrix_operator<M>(space, Stencil::intersection);
+  auto uncached_op = make_matrix_operator<M>(space, Stencil::intersection);
+  expect_cached_assembly_equals_uncached_assembly(cached_op, uncached_op);
+}
+
+
+GTEST_TEST(MatrixOperatorPositionCache, element_and_intersection_stencil_dg_ipdg)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4u);
+  const auto space = make_discontinuous_lagrange_space(grid.leaf_view(), 2);
+  auto cached_op = make_matrix_operator<M>(space, Stencil::element_and_intersection);
+  auto uncached_op = make_matrix_operator<M>(space, Stencil::element_and_intersection);
+  for (auto op : {&cached_op, &uncached_op}) {
+    op->append(LocalElementIntegralBilinearForm<E>(LocalLaplaceIntegrand<E>()));
+    op->append(LocalCouplingIntersectionIntegralBilinearForm<I>(LocalIPDGIntegrands::InnerPenalty<I>(16.)),
+               {},
+               XT::Grid::ApplyOn::InnerIntersectionsOnce<GV>());
+    op->append(LocalIntersectionIntegralBilinearForm<I>(LocalIPDGIntegrands::BoundaryPenalty<I>(16.)),
+               {},
+               XT::Grid::ApplyOn::BoundaryIntersections<GV>());
+  }
+  expect_cached_assembly_equals_uncached_assembly(cached_op, uncached_op);
+}
@@ -0,0 +1,105 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/grid/filters/intersection.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/la/container/istl.hh>
+
+#include <dune/gdt/local/bilinear-forms/integrals.hh>
+#include <dune/gdt/local/integrands/ipdg.hh>
+#include <dune/gdt/local/integrands/laplace.hh>
+#include <dune/gdt/local/integrands/laplace-ipdg.hh>
+#include <dune/gdt/operators/matrix-based.hh>
+#include <dune/gdt/operators/matrix-free.hh>
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_2D_EQUIDISTANT_OFFSET;
+using GV = typename G::LeafGridView;
+using E = XT::Grid::extract_entity_t<GV>;
+using I = XT::Grid::extract_intersection_t<GV>;
+using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+using V = XT::LA::IstlDenseVector<double>;
+
+
+template <class SpaceType, class AppendType>
+void expect_matrix_free_apply_equals_matrix_based_apply(const SpaceType& space,
+                                                        const Stencil stencil,
+                                                        const AppendType& append_local_bilinear_forms)
+{
+  V source(space.mapper().size(), 0.);
+  for (size_t ii = 0; ii < source.size(); ++ii)
+    source[ii] = std::sin(double(ii));
+  auto matrix_op = make_matrix_operator<M>(space, stencil);
+  append_local_bilinear_forms(matrix_op);
+  matrix_op.assemble();
+  V expected_range(space.mapper().size(), 0.);
+  matrix_op.apply(source, expected_range);
+  for (const bool use_tbb : {false, true}) {
+    auto matrix_free_op = make_matrix_free_operator<M>(space, use_tbb);
+    append_local_bilinear_forms(matrix_free_op);
+    // the range is expected to be overwritten
+    V range(space.mapper().size(), 1.);
+    matrix_free_op.apply(source, range);
+    EXPECT_LT((range - expected_range).sup_norm(), 1e-12 * std::max(1., expected_range.sup_norm()))
+        << "use_tbb = " << use_tbb;
+  }
+} // ... expect_matrix_free_apply_equals_matrix_based_apply(...)
+
+
+GTEST_TEST(MatrixFreeOperator, cg_laplace)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4u);
+  const auto space = make_continuous_lagrange_space(grid.leaf_view(), 2);
+  expect_matrix_free_apply_equals_matrix_based_apply(space, Stencil::element, [](auto& op) {
+    op.append(LocalElementIntegralBilinearForm<E>(LocalLaplaceIntegrand<E>()));
+  });
+}
+
+
+GTEST_TEST(MatrixFreeOperator, cg_laplace_with_boundary_penalty)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4u);
+  const auto space = make_continuous_lagrange_space(grid.leaf_view(), 2);
+  expect_matrix_free_apply_equals_matrix_based_apply(space, Stencil::element, [](auto& op) {
+    op.append(LocalElementIntegralBilinearForm<E>(LocalLaplaceIntegrand<E>()));
+    op.append(LocalIntersectionIntegralBilinearForm<I>(LocalIPDGIntegrands::BoundaryPenalty<I>(16.)),
+              {},
+              XT::Grid::ApplyOn::BoundaryIntersections<GV>());
+  });
+}
+
+
+GTEST_TEST(MatrixFreeOperator, dg_sipdg_laplace)
+{
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4u);
+  const auto space = make_discontinuous_lagrange_space(grid.leaf_view(), 2);
+  expect_matrix_free_apply_equals_matrix_based_apply(space, Stencil::element_and_intersection, [](auto& op) {
+    op.append(LocalElementIntegralBilinearForm<E>(LocalLaplaceIntegrand<E>()));
+    op.append(LocalCouplingIntersectionIntegralBilinearForm<I>(LocalLaplaceIPDGIntegrands::InnerCoupling<I>(1., 1.)),
+              {},
+              XT::Grid::ApplyOn::InnerIntersectionsOnce<GV>());
+    op.append(LocalCouplingIntersectionIntegralBilinearForm<I>(LocalIPDGIntegrands::InnerPenalty<I>(16.)),
+              {},
+              XT::Grid::ApplyOn::InnerIntersectionsOnce<GV>());
+    op.append(LocalIntersectionIntegralBilinearForm<I>(LocalIPDGIntegrands::BoundaryPenalty<I>(16.)),
+              {},
+              XT::Grid::ApplyOn::BoundaryIntersections<GV>());
+  });
+}
@@ -0,0 +1,121 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/xt/common/string.hh>
+#include <dune/xt/grid/boundaryinfo/normalbased.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/la/container/istl.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/operators/oswald-interpolation.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Applies the OswaldInterpolationOperator to a discontinuous piecewise linear function, given once in the range space
+ * (the source DoFs are read directly) and once in a discontinuous Lagrange space of second order (the source is
+ * evaluated in the Lagrange points), each sequentially and with use_tbb = true. All results have to coincide.
+ */
+template <class G>
+struct OswaldInterpolationOperatorFastPathTest : public ::testing::Test
+{
+  static constexpr size_t d = G::dimension;
+  using GV = typename G::LeafGridView;
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+
+  OswaldInterpolationOperatorFastPathTest()
+    : grid_provider(XT::Grid::make_cube_grid<G>(0., 1., 4u))
+  {
+    boundary_info.register_new_normal(XT::Common::from_string<FieldVector<double, d>>("[-1 0 0 0]"),
+                                      new XT::Grid::DirichletBoundary());
+  }
+
+  /// Linear on each element, with a jump depending on the element.
+  template <class SpaceType>
+  static DiscreteFunction<V, GV> interpolate_discontinuous_function(const SpaceType& space, const int order)
+  {
+    DiscreteFunction<V, GV> discrete_function(space);
+    auto local_function = discrete_function.local_discrete_function();
+    for (auto&& element : elements(space.grid_view())) {
+      local_function->bind(element);
+      const auto jump = std::floor(4. * element.geometry().center()[0]);
+      local_function->dofs().assign_from(
+          space.finite_elements().get(element.type(), order).interpolation().interpolate(
+              [&](const auto& x_local) {
+                const auto x = element.geometry().global(x_local);
+                return 1. + x[0] - 0.5 * x[d - 1] + jump;
+              },
+              order));
+    }
+    return discrete_function;
+  } // ... interpolate_discontinuous_function(...)
+
+  void fast_path_evaluation_and_tbb_coincide()
+  {
+    const auto grid_view = grid_provider.leaf_view();
+    const auto space = make_discontinuous_lagrange_space(grid_view, 1);
+    const auto other_space = make_discontinuous_lagrange_space(grid_view, 1);
+    const auto second_order_space = make_discontinuous_lagrange_space(grid_view, 2);
+    const auto source = interpolate_discontinuous_function(space, 1);
+    const auto second_order_source = interpolate_discontinuous_function(second_order_space, 2);
+    const auto apply = [&](const auto& source_space, const V& source_vector, const bool use_tbb) {
+      OswaldInterpolationOperator<M, GV> oswald_interpolation(grid_view, source_space, space, boundary_info);
+      oswald_interpolation.assemble(use_tbb);
+      V range(space.mapper().size(), 0.);
+      oswald_interpolation.apply(source_vector, range);
+      return range;
+    };
+    const auto expected = apply(space, source.dofs().vector(), /*use_tbb=*/false);
+    const double tolerance = 1e-13 * std::max(1., expected.sup_norm());
+    for (const bool use_tbb : {false, true}) {
+      // the source DoFs are the range DoFs, read directly (the numbering of other_space is checked elementwise)
+      for (const auto* source_space : {&space, &other_space}) {
+        const auto range = apply(*source_space, source.dofs().vector(), use_tbb);
+        for (size_t ii = 0; ii < expected.size(); ++ii)
+          EXPECT_EQ(expected[ii], range[ii]) << "use_tbb = " << use_tbb << ", same space object = "
+                                             << (source_space == &space) << ", ii = " << ii;
+      }
+      // the source is evaluated in the Lagrange points
+      const auto range = apply(second_order_space, second_order_source.dofs().vector(), use_tbb);
+      EXPECT_LT((range - expected).sup_norm(), tolerance) << "evaluation, use_tbb = " << use_tbb;
+    }
+  } // ... fast_path_evaluation_and_tbb_coincide(...)
+
+  XT::Grid::GridProvider<G> grid_provider;
+  XT::Grid::NormalBasedBoundaryInfo<I> boundary_info;
+}; // struct OswaldInterpolationOperatorFastPathTest
+
+
+using Grids = ::testing::Types<YASP_1D_EQUIDISTANT_OFFSET,
+                               YASP_2D_EQUIDISTANT_OFFSET
+#if HAVE_DUNE_ALUGRID
+                               ,
+                               ALU_2D_SIMPLEX_CONFORMING
+#endif
+                               >;
+
+TYPED_TEST_SUITE(OswaldInterpolationOperatorFastPathTest, Grids);
+TYPED_TEST(OswaldInterpolationOperatorFastPathTest, fast_path_evaluation_and_tbb_coincide)
+{
+  this->fast_path_evaluation_and_tbb_coincide();
+}
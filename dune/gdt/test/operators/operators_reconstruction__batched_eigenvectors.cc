@@ -0,0 +1,101 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/functions/generic/function.hh>
+#include <dune/xt/functions/interfaces/flux-function.hh>
+
+#include <dune/gdt/operators/reconstruction/internal.hh>
+#include <dune/gdt/tools/euler.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Compares the characteristic slopes (as in the linear reconstruction with a minmod limiter) obtained with
+ * internal::BatchedEigenvectorWrapper and internal::EigenvectorWrapper for the 1d Euler equations. The eigenvectors of
+ * the two wrappers may differ in scaling and order, the slopes do not (the eigenvalues are distinct).
+ */
+GTEST_TEST(BatchedEigenvectorWrapper, coincides_with_eigenvector_wrapper_for_euler_1d)
+{
+  using G = YASP_1D_EQUIDISTANT_OFFSET;
+  using GV = typename G::LeafGridView;
+  using E = XT::Grid::extract_entity_t<GV>;
+  static constexpr size_t d = 1;
+  static constexpr size_t m = d + 2;
+  using AnalyticalFluxType = XT::Functions::StateFunctionAsFluxFunctionWrapper<E, m, d, m>;
+  using VectorType = FieldVector<double, m>;
+  using ReferenceWrapperType =
+      internal::EigenvectorWrapper<AnalyticalFluxType, FieldMatrix<double, m, m>, FieldVector<double, m>>;
+  // a batch size which does not divide the number of cells
+  using BatchedWrapperType = internal::BatchedEigenvectorWrapper<AnalyticalFluxType, 7>;
+  const size_t num_cells = 50;
+  auto grid = XT::Grid::make_cube_grid<G>(0., 1., num_cells);
+  const auto grid_view = grid.leaf_view();
+  const EulerTools<d> euler_tools(1.4);
+  const XT::Functions::GenericFunction<m, d, m> flux(
+      euler_tools.flux_order(),
+      [&](const auto& u, const auto& /*param*/) { return euler_tools.flux(u); },
+      "euler_flux",
+      {},
+      [&](const auto& u, const auto& /*param*/) { return euler_tools.flux_jacobian(u); });
+  const AnalyticalFluxType analytical_flux(flux);
+  // a smooth, subsonic flow with a few repeated states
+  std::vector<VectorType> cell_states(num_cells);
+  for (size_t kk = 0; kk < num_cells; ++kk) {
+    const double xx = (kk - kk % 3) / double(num_cells);
+    cell_states[kk] = euler_tools.conservative(/*density=*/1. + 0.5 * std::sin(2. * M_PI * xx),
+                                               /*velocity=*/0.3 * std::cos(2. * M_PI * xx),
+                                               /*pressure=*/1. + 0.2 * xx);
+  }
+  const FieldVector<double, d> x_local(0.5);
+  const auto minmod = [](const double& a, const double& b) {
+    return (a * b > 0.) ? ((a > 0.) ? std::min(a, b) : std::max(a, b)) : 0.;
+  };
+  const auto characteristic_slope = [&](const auto& wrapper, const size_t kk) {
+    VectorType left_difference = cell_states[kk] - cell_states[kk - 1];
+    VectorType right_difference = cell_states[kk + 1] - cell_states[kk];
+    VectorType left_characteristic, right_characteristic, slope;
+    wrapper.apply_inverse_eigenvectors(0, left_difference, left_characteristic);
+    wrapper.apply_inverse_eigenvectors(0, right_difference, right_characteristic);
+    for (size_t ii = 0; ii < m; ++ii)
+      left_characteristic[ii] = minmod(left_characteristic[ii], right_characteristic[ii]);
+    wrapper.apply_eigenvectors(0, left_characteristic, slope);
+    return slope;
+  };
+  ReferenceWrapperType reference_wrapper(analytical_flux, /*flux_is_affine=*/false);
+  BatchedWrapperType batched_wrapper(analytical_flux, /*flux_is_affine=*/false);
+  std::vector<E> elements_by_index(num_cells, *grid_view.template begin<0>());
+  for (auto&& element : elements(grid_view))
+    elements_by_index[grid_view.indexSet().index(element)] = element;
+  // in index order, as in the grid walk, and once more backwards, which does not hit the current batch
+  std::vector<size_t> cell_order;
+  for (size_t kk = 1; kk + 1 < num_cells; ++kk)
+    cell_order.push_back(kk);
+  for (size_t kk = num_cells - 2; kk > 0; --kk)
+    cell_order.push_back(kk);
+  for (const size_t kk : cell_order) {
+    const auto& element = elements_by_index[kk];
+    reference_wrapper.compute_eigenvectors_of_cell(kk, element, x_local, cell_states, {});
+    batched_wrapper.compute_eigenvectors_of_cell(kk, element, x_local, cell_states, {});
+    const auto expected_slope = characteristic_slope(reference_wrapper, kk);
+    const auto slope = characteristic_slope(batched_wrapper, kk);
+    EXPECT_LT((slope - expected_slope).infinity_norm(), 1e-10 * std::max(1., expected_slope.infinity_norm()))
+        << "cell " << kk;
+  }
+} // GTEST_TEST(BatchedEigenvectorWrapper, coincides_with_eigenvector_wrapper_for_euler_1d)
@@ -0,0 +1,157 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/xt/common/fvector.hh>
+
+#include <dune/gdt/operators/reconstruction/flux-eigen-decompositions.hh>
+#include <dune/gdt/tools/euler.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Checks that T * T_inv is the identity and that T_inv * A * T is diagonal, with the given eigenvalues on the
+ * diagonal.
+ */
+template <size_t m>
+void check_eigen_decomposition(const FieldMatrix<double, m, m>& A,
+                               const FieldMatrix<double, m, m>& T,
+                               const FieldMatrix<double, m, m>& T_inv,
+                               const FieldVector<double, m>& expected_eigenvalues,
+                               const std::string& msg)
+{
+  // the entries of T and T_inv scale with the velocity and the energy, so the error is relative to their norms
+  const double scale = std::max(1., T.infinity_norm() * T_inv.infinity_norm());
+  const double eigenvalue_scale = scale * std::max(1., A.infinity_norm());
+  FieldMatrix<double, m, m> T_T_inv(0.);
+  FieldMatrix<double, m, m> T_inv_A_T(0.);
+  for (size_t ii = 0; ii < m; ++ii)
+    for (size_t jj = 0; jj < m; ++jj)
+      for (size_t kk = 0; kk < m; ++kk) {
+        T_T_inv[ii][jj] += T[ii][kk] * T_inv[kk][jj];
+        for (size_t ll = 0; ll < m; ++ll)
+          T_inv_A_T[ii][jj] += T_inv[ii][kk] * A[kk][ll] * T[ll][jj];
+      }
+  for (size_t ii = 0; ii < m; ++ii)
+    for (size_t jj = 0; jj < m; ++jj) {
+      EXPECT_NEAR(ii == jj ? 1. : 0., T_T_inv[ii][jj], 1e-12 * scale)
+          << msg << ", T * T_inv, ii = " << ii << ", jj = " << jj;
+      EXPECT_NEAR(ii == jj ? expected_eigenvalues[ii] : 0., T_inv_A_T[ii][jj], 1e-12 * eigenvalue_scale)
+          << msg << ", T_inv * A * T, ii = " << ii << ", jj = " << jj;
+    }
+} // ... check_eigen_decomposition(...)
+
+
+template <size_t d>
+void check_euler_flux_eigen_decomposition()
+{
+  static constexpr size_t m = d + 2;
+  const EulerTools<d, double> euler_tools(1.4);
+  const auto eigen_decomposition = make_euler_flux_eigen_decomposition(euler_tools);
+  // (rho, v, p), at rest, subsonic and supersonic
+  const std::vector<std::tuple<double, XT::Common::FieldVector<double, d>, double>> primitive_states{
+      {1., XT::Common::FieldVector<double, d>(0.), 1.},
+      {0.125, XT::Common::FieldVector<double, d>(0.3), 0.1},
+      {2., XT::Common::FieldVector<double, d>(-1.5), 5.},
+      {0.5, XT::Common::FieldVector<double, d>(4.), 0.2}};
+  for (size_t ss = 0; ss < primitive_states.size(); ++ss) {
+    auto v = std::get<1>(primitive_states[ss]);
+    if (d > 1)
+      v[d - 1] *= -0.5;
+    const auto w = euler_tools.conservative(FieldVector<double, 1>(std::get<0>(primitive_states[ss])),
+                                            v,
+                                            FieldVector<double, 1>(std::get<2>(primitive_states[ss])));
+    const auto jacobians = euler_tools.flux_jacobian(w);
+    for (size_t dd = 0; dd < d; ++dd) {
+      FieldMatrix<double, m, m> T, T_inv;
+      eigen_decomposition(w, dd, T, T_inv, {});
+      FieldVector<double, d> n(0.);
+      n[dd] = 1.;
+      check_eigen_decomposition<m>(jacobians[dd],
+                                   T,
+                                   T_inv,
+                                   euler_tools.eigenvalues_flux_jacobian(w, n),
+                                   "state " + std::to_string(ss) + ", dd = " + std::to_string(dd));
+    }
+  }
+} // ... check_euler_flux_eigen_decomposition(...)
+
+
+template <size_t d>
+void check_shallow_water_flux_eigen_decomposition()
+{
+  static constexpr size_t m = d + 1;
+  const double g = 9.81;
+  const auto eigen_decomposition = make_shallow_water_flux_eigen_decomposition<d>(g);
+  // (h, v), at rest, sub- and supercritical
+  const std::vector<std::pair<double, double>> primitive_states{{1., 0.}, {0.2, 0.5}, {3., -2.}, {0.1, 5.}};
+  for (size_t ss = 0; ss < primitive_states.size(); ++ss) {
+    const double h = primitive_states[ss].first;
+    FieldVector<double, d> v(primitive_states[ss].second);
+    if (d > 1)
+      v[d - 1] *= -0.5;
+    FieldVector<double, m> u;
+    u[0] = h;
+    for (size_t kk = 0; kk < d; ++kk)
+      u[kk + 1] = h * v[kk];
+    const double c = std::sqrt(g * h);
+    for (size_t dd = 0; dd < d; ++dd) {
+      // the jacobian of f_dd(u) = (h v_dd, h v_dd v + 0.5 g h^2 e_dd)
+      FieldMatrix<double, m, m> A(0.);
+      A[0][dd + 1] = 1.;
+      for (size_t kk = 0; kk < d; ++kk) {
+        A[kk + 1][0] = -v[kk] * v[dd] + (kk == dd ? g * h : 0.);
+        A[kk + 1][kk + 1] += v[dd];
+        A[kk + 1][dd + 1] += v[kk];
+      }
+      FieldVector<double, m> expected_eigenvalues(v[dd]);
+      expected_eigenvalues[0] = v[dd] - c;
+      expected_eigenvalues[m - 1] = v[dd] + c;
+      FieldMatrix<double, m, m> T, T_inv;
+      eigen_decomposition(u, dd, T, T_inv, {});
+      check_eigen_decomposition<m>(
+          A, T, T_inv, expected_eigenvalues, "state " + std::to_string(ss) + ", dd = " + std::to_string(dd));
+    }
+  }
+} // ... check_shallow_water_flux_eigen_decomposition(...)
+
+
+GTEST_TEST(FluxEigenDecompositions, euler_1d)
+{
+  check_euler_flux_eigen_decomposition<1>();
+}
+GTEST_TEST(FluxEigenDecompositions, euler_2d)
+{
+  check_euler_flux_eigen_decomposition<2>();
+}
+GTEST_TEST(FluxEigenDecompositions, shallow_water_1d)
+{
+  check_shallow_water_flux_eigen_decomposition<1>();
+}
+GTEST_TEST(FluxEigenDecompositions, shallow_water_2d)
+{
+  check_shallow_water_flux_eigen_decomposition<2>();
+}
+GTEST_TEST(FluxEigenDecompositions, shallow_water_3d)
+{
+  check_shallow_water_flux_eigen_decomposition<3>();
+}
@@ -0,0 +1,108 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <vector>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/type_traits.hh>
+
+#include <dune/gdt/spaces/basis/default.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+template <class G>
+struct DefaultGlobalBasisTabulationTest : public ::testing::Test
+{
+  using GV = typename G::LeafGridView;
+  using D = typename GV::ctype;
+  static constexpr size_t d = G::dimension;
+  using BasisType = DefaultGlobalBasis<GV, 1, 1, double>;
+  using LocalizedBasisType = typename BasisType::LocalizedType;
+  using DomainType = typename LocalizedBasisType::DomainType;
+  using RangeType = typename LocalizedBasisType::RangeType;
+  using DerivativeRangeType = typename LocalizedBasisType::DerivativeRangeType;
+
+  void tabulated_values_and_jacobians_coincide_with_direct_evaluation()
+  {
+    auto grid = XT::Grid::make_cube_grid<G>(-1., 1., 4u);
+    const auto grid_view = grid.leaf_view();
+    for (int order : {0, 1, 2, 3}) {
+      const auto space = make_discontinuous_lagrange_space(grid_view, order);
+      const auto& basis = dynamic_cast<const BasisType&>(space.basis());
+      {
+        auto localized_basis = basis.localize();
+        std::vector<RangeType> values;
+        std::vector<RangeType> expected_values;
+        std::vector<DerivativeRangeType> jacobians;
+        std::vector<DerivativeRangeType> expected_jacobians;
+        std::vector<DomainType> points;
+        // in the first sweep, the points are tabulated, in the second one they are looked up
+        for (size_t sweep = 0; sweep < 2; ++sweep) {
+          for (auto&& element : elements(grid_view)) {
+            localized_basis->bind(element);
+            const auto& reference_basis = localized_basis->finite_element().basis();
+            const auto geometry = element.geometry();
+            // the points of two quadratures and the center of the element, which is visited out of order
+            points.clear();
+            for (auto&& quadrature_point : QuadratureRules<D, d>::rule(element.type(), 2 * order + 1))
+              points.emplace_back(quadrature_point.position());
+            points.emplace_back(ReferenceElements<D, d>::general(element.type()).position(0, 0));
+            for (auto&& quadrature_point : QuadratureRules<D, d>::rule(element.type(), order))
+              points.emplace_back(quadrature_point.position());
+            for (const auto& point : points) {
+              localized_basis->evaluate(point, values);
+              reference_basis.evaluate(point, expected_values);
+              ASSERT_EQ(values.size(), expected_values.size());
+              for (size_t ii = 0; ii < values.size(); ++ii)
+                EXPECT_EQ(expected_values[ii], values[ii]) << "order = " << order << ", point = " << point;
+              localized_basis->jacobians(point, jacobians);
+              reference_basis.jacobian(point, expected_jacobians);
+              ASSERT_EQ(jacobians.size(), expected_jacobians.size());
+              const auto J_inv_T = geometry.jacobianInverseTransposed(point);
+              for (size_t ii = 0; ii < jacobians.size(); ++ii) {
+                auto expected_gradient = expected_jacobians[ii][0];
+                J_inv_T.mv(expected_jacobians[ii][0], expected_gradient);
+                for (size_t jj = 0; jj < d; ++jj)
+                  EXPECT_DOUBLE_EQ(expected_gradient[jj], jacobians[ii][0][jj])
+                      << "order = " << order << ", point = " << point;
+              }
+            }
+          }
+        }
+      }
+      // the statistics are reported once the localized basis is destroyed
+      EXPECT_GT(basis.reference_tabulation_hits(), basis.reference_tabulation_misses()) << "order = " << order;
+    }
+  } // ... tabulated_values_and_jacobians_coincide_with_direct_evaluation(...)
+}; // struct DefaultGlobalBasisTabulationTest
+
+
+using Grids = ::testing::Types<YASP_2D_EQUIDISTANT_OFFSET,
+                               YASP_3D_EQUIDISTANT_OFFSET
+#if HAVE_DUNE_ALUGRID
+                               ,
+                               ALU_2D_SIMPLEX_CONFORMING,
+                               ALU_3D_SIMPLEX_CONFORMING
+#endif
+                               >;
+
+TYPED_TEST_SUITE(DefaultGlobalBasisTabulationTest, Grids);
+TYPED_TEST(DefaultGlobalBasisTabulationTest, tabulated_values_and_jacobians_coincide_with_direct_evaluation)
+{
+  this->tabulated_values_and_jacobians_coincide_with_direct_evaluation();
+}
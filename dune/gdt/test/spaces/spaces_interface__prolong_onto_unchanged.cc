@@ -0,0 +1,120 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <dune/common/dynvector.hh>
+
+#include <dune/grid/common/rangegenerators.hh>
+#include <dune/grid/utility/persistentcontainer.hh>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/la/container/common/vector/dense.hh>
+#include <dune/xt/la/container/conversion.hh>
+
+#include <dune/gdt/interpolations/default.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Stores the local data of a discrete function as the AdaptationHelper does, refines part of the grid and compares the
+ * copied DoF data of the unchanged elements in SpaceInterface::prolong_onto (and in the prolongation of the
+ * FiniteVolumeSpace) with the generic interpolation of SpaceInterface::interpolate_onto_unchanged.
+ */
+template <class G>
+struct SpaceProlongOntoUnchangedTest : public ::testing::Test
+{
+  static constexpr size_t d = G::dimension;
+  using GV = typename G::LeafGridView;
+  using V = XT::LA::CommonDenseVector<double>;
+  using DataType = std::pair<DynamicVector<double>, DynamicVector<double>>;
+
+  template <class SpaceFactory>
+  static void copy_and_interpolation_coincide(const SpaceFactory& make_space)
+  {
+    auto grid_provider = XT::Grid::make_cube_grid<G>(0., 1., 4u);
+    auto& grid = grid_provider.grid();
+    auto grid_view = grid.leafGridView();
+    auto space = make_space(grid_view);
+    ASSERT_TRUE(space.locally_determined_finite_elements());
+    const auto discrete_function = default_interpolation<V>(
+        3,
+        [](const auto& xx, const auto& /*mu*/) { return std::sin(M_PI * xx[0]) * std::exp(xx[d - 1]); },
+        space);
+    PersistentContainer<G, DataType> persistent_data(grid, 0);
+    persistent_data.resize();
+    auto basis = space.basis().localize();
+    auto local_function = discrete_function.local_discrete_function();
+    for (auto&& element : elements(grid_view)) {
+      basis->bind(element);
+      local_function->bind(element);
+      persistent_data[element] =
+          std::make_pair(basis->backup(), XT::LA::convert_to<DynamicVector<double>>(local_function->dofs()));
+    }
+    // refine the left half, the elements of the right half are unchanged
+    for (auto&& element : elements(grid_view))
+      if (element.geometry().center()[0] < 0.5)
+        grid.mark(1, element);
+    grid.preAdapt();
+    grid.adapt();
+    persistent_data.resize();
+    space.adapt();
+    size_t num_unchanged_elements = 0;
+    for (auto&& element : elements(grid_view)) {
+      if (element.isNew())
+        continue;
+      ++num_unchanged_elements;
+      DynamicVector<double> expected;
+      space.interpolate_onto_unchanged(element, persistent_data, expected);
+      const double tolerance = 1e-12 * std::max(1., expected.infinity_norm());
+      for (const bool use_base_prolongation : {false, true}) {
+        DynamicVector<double> actual;
+        if (use_base_prolongation)
+          space.SpaceInterface<GV>::prolong_onto(element, persistent_data, actual);
+        else
+          space.prolong_onto(element, persistent_data, actual);
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t ii = 0; ii < expected.size(); ++ii)
+          EXPECT_NEAR(expected[ii], actual[ii], tolerance)
+              << "use_base_prolongation = " << use_base_prolongation << ", ii = " << ii;
+      }
+    }
+    EXPECT_GT(num_unchanged_elements, 0u);
+    grid.postAdapt();
+  } // ... copy_and_interpolation_coincide(...)
+}; // struct SpaceProlongOntoUnchangedTest
+
+
+using AdaptiveGrids = ::testing::Types<ONED_1D
+#if HAVE_DUNE_ALUGRID
+                                       ,
+                                       ALU_2D_SIMPLEX_CONFORMING
+#endif
+                                       >;
+
+TYPED_TEST_SUITE(SpaceProlongOntoUnchangedTest, AdaptiveGrids);
+TYPED_TEST(SpaceProlongOntoUnchangedTest, finite_volume)
+{
+  this->copy_and_interpolation_coincide([](const auto& grid_view) { return make_finite_volume_space(grid_view); });
+}
+TYPED_TEST(SpaceProlongOntoUnchangedTest, discontinuous_lagrange)
+{
+  for (int order : {0, 1, 2})
+    this->copy_and_interpolation_coincide(
+        [&](const auto& grid_view) { return make_discontinuous_lagrange_space(grid_view, order); });
+}
@@ -0,0 +1,106 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/la/container/common/vector/dense.hh>
+
+#include <dune/gdt/interpolations/default.hh>
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/tools/adaptation-helper.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Refines and then coarsens two identical grids in the same way, once with a sequential and once with a parallel
+ * AdaptationHelper, and compares the restricted and prolonged DoFs.
+ */
+template <class G>
+struct AdaptationHelperTest : public ::testing::Test
+{
+  static constexpr size_t d = G::dimension;
+  using GV = typename G::LeafGridView;
+  using V = XT::LA::CommonDenseVector<double>;
+
+  template <class SpaceFactory>
+  static std::vector<V> adapt(const bool use_tbb, const SpaceFactory& make_space)
+  {
+    auto grid_provider = XT::Grid::make_cube_grid<G>(0., 1., 4u);
+    auto& grid = grid_provider.grid();
+    auto grid_view = grid.leafGridView();
+    auto space = make_space(grid_view);
+    auto discrete_function = default_interpolation<V>(
+        3,
+        [](const auto& xx, const auto& /*mu*/) { return std::sin(M_PI * xx[0]) * std::exp(xx[d - 1]); },
+        space);
+    AdaptationHelper<V, GV> helper(grid, /*logging_prefix=*/"", use_tbb);
+    helper.append(space, discrete_function);
+    std::vector<V> results;
+    // refine the left half (twice), then coarsen the leftmost quarter
+    for (const int marker : {1, 1, -1}) {
+      for (auto&& element : elements(grid_view)) {
+        const auto center = element.geometry().center();
+        if ((marker > 0 && center[0] < 0.5) || (marker < 0 && center[0] < 0.25))
+          grid.mark(marker, element);
+      }
+      helper.pre_adapt();
+      helper.adapt();
+      helper.post_adapt();
+      results.push_back(discrete_function.dofs().vector());
+    }
+    return results;
+  } // ... adapt(...)
+
+  template <class SpaceFactory>
+  static void sequential_and_parallel_adaptation_coincide(const SpaceFactory& make_space)
+  {
+    const auto expected_results = adapt(/*use_tbb=*/false, make_space);
+    const auto results = adapt(/*use_tbb=*/true, make_space);
+    ASSERT_EQ(results.size(), expected_results.size());
+    for (size_t ii = 0; ii < results.size(); ++ii) {
+      ASSERT_EQ(results[ii].size(), expected_results[ii].size()) << "step " << ii;
+      EXPECT_LT((results[ii] - expected_results[ii]).sup_norm(),
+                1e-12 * std::max(1., expected_results[ii].sup_norm()))
+          << "step " << ii;
+    }
+  } // ... sequential_and_parallel_adaptation_coincide(...)
+}; // struct AdaptationHelperTest
+
+
+using AdaptiveGrids = ::testing::Types<ONED_1D
+#if HAVE_DUNE_ALUGRID
+                                       ,
+                                       ALU_2D_SIMPLEX_CONFORMING
+#endif
+                                       >;
+
+TYPED_TEST_SUITE(AdaptationHelperTest, AdaptiveGrids);
+TYPED_TEST(AdaptationHelperTest, discontinuous_lagrange)
+{
+  for (int order : {0, 1, 2})
+    this->sequential_and_parallel_adaptation_coincide(
+        [&](const auto& grid_view) { return make_discontinuous_lagrange_space(grid_view, order); });
+}
+TYPED_TEST(AdaptationHelperTest, continuous_lagrange)
+{
+  for (int order : {1, 2})
+    this->sequential_and_parallel_adaptation_coincide(
+        [&](const auto& grid_view) { return make_continuous_lagrange_space(grid_view, order); });
+}
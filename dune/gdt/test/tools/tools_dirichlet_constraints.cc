@@ -0,0 +1,120 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <memory>
+#include <vector>
+
+#include <dune/xt/common/string.hh>
+#include <dune/xt/grid/boundaryinfo/alldirichlet.hh>
+#include <dune/xt/grid/boundaryinfo/normalbased.hh>
+#include <dune/xt/grid/filters/intersection.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/walker.hh>
+#include <dune/xt/la/container/istl.hh>
+
+#include <dune/gdt/local/bilinear-forms/integrals.hh>
+#include <dune/gdt/local/integrands/laplace.hh>
+#include <dune/gdt/operators/matrix-based.hh>
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/tools/dirichlet-constraints.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Compares the DoFs and the elimination of an assembled matrix of SortedDirichletConstraints (walked on boundary and
+ * process boundary intersections only, as in OswaldInterpolationOperator) with DirichletConstraints.
+ */
+template <class G>
+struct SortedDirichletConstraintsTest : public ::testing::Test
+{
+  static constexpr size_t d = G::dimension;
+  using GV = typename G::LeafGridView;
+  using E = XT::Grid::extract_entity_t<GV>;
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+
+  SortedDirichletConstraintsTest()
+    : grid(XT::Grid::make_cube_grid<G>(0., 1., 4u))
+    , grid_view(grid.leaf_view())
+  {}
+
+  void sorted_and_unsorted_constraints_coincide(const XT::Grid::BoundaryInfo<I>& boundary_info) const
+  {
+    for (int order : {1, 2, 3}) {
+      const auto space = make_continuous_lagrange_space(grid_view, order);
+      for (const bool use_tbb : {false, true}) {
+        auto constraints = make_dirichlet_constraints(space, boundary_info);
+        auto sorted_constraints = make_sorted_dirichlet_constraints(space, boundary_info);
+        auto walker = XT::Grid::make_walker(grid_view);
+        walker.append(constraints);
+        walker.append(sorted_constraints,
+                      XT::Grid::ApplyOn::GenericFilteredIntersections<GV>(
+                          [](const GV& /*grid_view*/, const I& intersection) {
+                            return intersection.boundary() || !intersection.neighbor();
+                          }));
+        walker.walk(use_tbb);
+        const std::vector<size_t> expected_DoFs(constraints.dirichlet_DoFs().begin(),
+                                                constraints.dirichlet_DoFs().end());
+        EXPECT_EQ(sorted_constraints.dirichlet_DoFs(), expected_DoFs)
+            << "order = " << order << ", use_tbb = " << use_tbb;
+        for (size_t ii = 0; ii < space.mapper().size(); ++ii)
+          EXPECT_EQ(sorted_constraints.is_dirichlet_DoF(ii), constraints.dirichlet_DoFs().count(ii) > 0)
+              << "order = " << order << ", ii = " << ii;
+        // the elimination of the Dirichlet rows and columns
+        auto laplace_op = make_matrix_operator<M>(space, Stencil::element);
+        laplace_op.append(LocalElementIntegralBilinearForm<E>(LocalLaplaceIntegrand<E>()));
+        laplace_op.assemble(use_tbb);
+        for (const bool only_clear : {false, true}) {
+          for (const bool ensure_symmetry : {false, true}) {
+            auto expected_matrix = laplace_op.matrix().copy();
+            constraints.apply(expected_matrix, only_clear, ensure_symmetry);
+            auto matrix = laplace_op.matrix().copy();
+            sorted_constraints.apply(matrix, only_clear, ensure_symmetry);
+            for (size_t ii = 0; ii < matrix.rows(); ++ii)
+              for (size_t jj = 0; jj < matrix.cols(); ++jj)
+                EXPECT_EQ(matrix.get_entry(ii, jj), expected_matrix.get_entry(ii, jj))
+                    << "order = " << order << ", only_clear = " << only_clear
+                    << ", ensure_symmetry = " << ensure_symmetry << ", ii = " << ii << ", jj = " << jj;
+          }
+        }
+      }
+    }
+  } // ... sorted_and_unsorted_constraints_coincide(...)
+
+  XT::Grid::GridProvider<G> grid;
+  const GV grid_view;
+}; // struct SortedDirichletConstraintsTest
+
+
+using Grids = ::testing::Types<YASP_2D_EQUIDISTANT_OFFSET
+#if HAVE_DUNE_ALUGRID
+                               ,
+                               ALU_2D_SIMPLEX_CONFORMING
+#endif
+                               >;
+
+TYPED_TEST_SUITE(SortedDirichletConstraintsTest, Grids);
+TYPED_TEST(SortedDirichletConstraintsTest, all_dirichlet)
+{
+  const XT::Grid::AllDirichletBoundaryInfo<typename TestFixture::I> boundary_info;
+  this->sorted_and_unsorted_constraints_coincide(boundary_info);
+}
+TYPED_TEST(SortedDirichletConstraintsTest, mixed_boundary)
+{
+  // Dirichlet on the left, which shares its corners with the rest of the boundary
+  XT::Grid::NormalBasedBoundaryInfo<typename TestFixture::I> boundary_info;
+  boundary_info.register_new_normal(XT::Common::from_string<FieldVector<double, TestFixture::d>>("[-1 0 0 0]"),
+                                    new XT::Grid::DirichletBoundary());
+  this->sorted_and_unsorted_constraints_coincide(boundary_info);
+}
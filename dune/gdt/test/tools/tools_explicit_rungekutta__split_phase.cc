@@ -0,0 +1,112 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <cmath>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/interpolations.hh>
+#include <dune/gdt/local/numerical-fluxes/engquist-osher.hh>
+#include <dune/gdt/operators/advection-fv.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+#include <dune/gdt/tools/timestepper/explicit-rungekutta.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Compares the explicit Runge Kutta time stepper with split-phase communication (applying the operator on the
+ * interior and the halo elements separately) with the blocking exchange of the stages, for an FV discretization of
+ * Burgers' equation. On a single rank, both have to yield identical DoFs.
+ */
+template <class G>
+struct ExplicitRungeKuttaSplitPhaseTest : public ::testing::Test
+{
+  static constexpr size_t d = G::dimension;
+  using GV = typename G::LeafGridView;
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+  using OperatorType = AdvectionFvOperator<M, GV>;
+  using DiscreteFunctionType = DiscreteFunction<V, GV>;
+  using TimeStepperType = ExplicitRungeKuttaTimeStepper<OperatorType,
+                                                        DiscreteFunctionType,
+                                                        TimeStepperMethods::explicit_rungekutta_second_order_ssp>;
+
+  ExplicitRungeKuttaSplitPhaseTest()
+    : grid(XT::Grid::make_cube_grid<G>(0., 1., 8u))
+    , direction(1.)
+    , flux(
+          2,
+          [&](const auto& u, const auto& /*param*/) {
+            auto ret = direction;
+            ret *= 0.5 * u[0] * u[0];
+            return ret;
+          },
+          "burgers",
+          {},
+          [&](const auto& u, const auto& /*param*/) {
+            auto ret = direction;
+            ret *= u[0];
+            return ret;
+          })
+  {}
+
+  void split_phase_and_blocking_communication_coincide() const
+  {
+    ASSERT_EQ(grid.leaf_view().comm().size(), 1);
+    const auto grid_view = grid.leaf_view();
+    const auto space = make_finite_volume_space(grid_view);
+    const NumericalEngquistOsherFlux<I, d, 1> numerical_flux(flux);
+    OperatorType op(grid_view, numerical_flux, space, space);
+    op.declare_face_neighbor_stencil();
+    const auto initial_values = default_interpolation<V>(
+        0,
+        [](const auto& xx, const auto& /*mu*/) {
+          return std::sin(2. * M_PI * xx[0]) + 0.5 * std::cos(2. * M_PI * xx[d - 1]);
+        },
+        space);
+    const double dt = 0.25 / 8.;
+    auto blocking_solution = initial_values.copy_as_discrete_function();
+    TimeStepperType blocking_stepper(op, *blocking_solution, -1.);
+    auto split_phase_solution = initial_values.copy_as_discrete_function();
+    TimeStepperType split_phase_stepper(op, *split_phase_solution, -1.);
+    split_phase_stepper.use_split_phase_communication(true);
+    // the decomposition of the grid view is computed in the first step and reused in the following ones
+    for (size_t ii = 0; ii < 5; ++ii) {
+      blocking_stepper.step(dt, dt);
+      split_phase_stepper.step(dt, dt);
+      const auto& expected = blocking_stepper.current_solution().dofs().vector();
+      const auto& actual = split_phase_stepper.current_solution().dofs().vector();
+      ASSERT_EQ(expected.size(), actual.size());
+      for (size_t jj = 0; jj < expected.size(); ++jj)
+        EXPECT_EQ(expected[jj], actual[jj]) << "step " << ii << ", DoF " << jj;
+    }
+  } // ... split_phase_and_blocking_communication_coincide(...)
+
+  XT::Grid::GridProvider<G> grid;
+  const XT::Common::FieldVector<double, d> direction;
+  const XT::Functions::GenericFunction<1, d, 1> flux;
+}; // struct ExplicitRungeKuttaSplitPhaseTest
+
+
+using Grids = ::testing::Types<YASP_1D_EQUIDISTANT_OFFSET, YASP_2D_EQUIDISTANT_OFFSET>;
+
+TYPED_TEST_SUITE(ExplicitRungeKuttaSplitPhaseTest, Grids);
+TYPED_TEST(ExplicitRungeKuttaSplitPhaseTest, split_phase_and_blocking_communication_coincide)
+{
+  this->split_phase_and_blocking_communication_coincide();
+}
@@ -0,0 +1,123 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <cmath>
+
+#include <dune/xt/la/container/common.hh>
+
+#include <dune/gdt/tools/fgmres.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Solves a small nonsymmetric (convection dominated, tridiagonal) system with a known solution.
+ */
+struct FgmresTest : public ::testing::Test
+{
+  using M = XT::LA::CommonDenseMatrix<double>;
+  using V = XT::LA::CommonDenseVector<double>;
+  static constexpr size_t size = 50;
+
+  FgmresTest()
+    : A(size, size, 0.)
+    , x_exact(size, 0.)
+    , b(size, 0.)
+  {
+    for (size_t ii = 0; ii < size; ++ii) {
+      A.set_entry(ii, ii, 4.);
+      if (ii > 0)
+        A.set_entry(ii, ii - 1, -3.);
+      if (ii + 1 < size)
+        A.set_entry(ii, ii + 1, -0.5);
+      x_exact[ii] = std::sin(double(ii));
+    }
+    A.mv(x_exact, b);
+  }
+
+  template <class ApplyPType>
+  void solves(const ApplyPType& apply_P, const size_t restart) const
+  {
+    const auto apply_A = [&](const V& v, V& w) { A.mv(v, w); };
+    V x(size, 0.);
+    double residual_norm = 0.;
+    const auto iterations = internal::fgmres(apply_A, apply_P, b, x, 1e-12, 1000, restart, residual_norm);
+    EXPECT_LE(iterations, 1000u);
+    EXPECT_LE(residual_norm, 1e-12 * b.l2_norm());
+    V residual(size, 0.);
+    A.mv(x, residual);
+    residual -= b;
+    EXPECT_LE(residual.l2_norm(), 1e-12 * b.l2_norm());
+    EXPECT_LT((x - x_exact).sup_norm(), 1e-9);
+  } // ... solves(...)
+
+  M A;
+  V x_exact;
+  V b;
+}; // struct FgmresTest
+
+
+TEST_F(FgmresTest, solves_without_preconditioner)
+{
+  this->solves([](const V& v, V& z) { z = v; }, /*restart=*/size);
+}
+
+TEST_F(FgmresTest, solves_with_restarts)
+{
+  this->solves([](const V& v, V& z) { z = v; }, /*restart=*/5);
+}
+
+TEST_F(FgmresTest, solves_with_jacobi_preconditioner)
+{
+  this->solves(
+      [](const V& v, V& z) {
+        z = v;
+        z *= 0.25;
+      },
+      /*restart=*/10);
+}
+
+TEST_F(FgmresTest, solves_with_changing_preconditioner)
+{
+  // alternating between a few Gauss-Seidel sweeps and a Jacobi preconditioner, only flexible GMRES allows this
+  size_t calls = 0;
+  const M& A_ref = this->A;
+  this->solves(
+      [&](const V& v, V& z) {
+        z = v;
+        if (calls++ % 2 == 0) {
+          // a few Gauss-Seidel sweeps as inexact inner solve
+          for (size_t sweep = 0; sweep < 3; ++sweep)
+            for (size_t ii = 0; ii < size; ++ii) {
+              double value = v[ii];
+              for (size_t jj = 0; jj < size; ++jj)
+                if (jj != ii)
+                  value -= A_ref.get_entry(ii, jj) * z[jj];
+              z[ii] = value / A_ref.get_entry(ii, ii);
+            }
+        } else
+          z *= 0.25;
+      },
+      /*restart=*/10);
+  EXPECT_GT(calls, 1u);
+}
+
+TEST_F(FgmresTest, returns_immediately_for_exact_initial_guess)
+{
+  const auto apply_A = [&](const V& v, V& w) { A.mv(v, w); };
+  V x = x_exact;
+  double residual_norm = 1.;
+  const auto iterations = internal::fgmres(
+      apply_A, [](const V& v, V& z) { z = v; }, b, x, 1e-10, 100, 10, residual_norm);
+  EXPECT_EQ(iterations, 0u);
+  EXPECT_LT((x - x_exact).sup_norm(), 1e-15);
+}
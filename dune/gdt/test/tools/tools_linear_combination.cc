@@ -0,0 +1,134 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <dune/xt/la/container/common.hh>
+#include <dune/xt/la/container/istl.hh>
+
+#include <dune/gdt/tools/timestepper/linear-combination.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Compares internal::linear_combination with the vector expressions (creating temporaries) the Runge Kutta time
+ * steppers used before, for the stages, the update and the revert of the adaptive Runge Kutta time stepper.
+ */
+template <class V>
+struct LinearCombinationTest : public ::testing::Test
+{
+  static constexpr size_t size = 1000;
+  static constexpr size_t num_stages = 4;
+
+  LinearCombinationTest()
+    : u_n(size, 0.)
+    , stages_k(num_stages, V(size, 0.))
+    , b(num_stages)
+  {
+    for (size_t ii = 0; ii < size; ++ii) {
+      u_n[ii] = std::sin(double(ii));
+      for (size_t jj = 0; jj < num_stages; ++jj)
+        stages_k[jj][ii] = std::cos(double((jj + 1) * ii));
+    }
+    // one vanishing coefficient, as in many Butcher tableaus
+    b = {1. / 6., 0., 2. / 3., 1. / 6.};
+  }
+
+  std::vector<std::pair<double, const V*>> update_summands(const V& u) const
+  {
+    std::vector<std::pair<double, const V*>> summands{{1., &u}};
+    for (size_t ii = 0; ii < num_stages; ++ii)
+      if (b[ii] != 0.)
+        summands.emplace_back(dt * b[ii], &stages_k[ii]);
+    return summands;
+  }
+
+  void stage_equals_temporary_vector_version() const
+  {
+    for (const bool use_tbb : {false, true}) {
+      for (size_t ii = 0; ii < num_stages; ++ii) {
+        V expected = u_n;
+        for (size_t jj = 0; jj < ii; ++jj)
+          expected += stages_k[jj] * (dt * 0.5 * (jj + 1));
+        std::vector<std::pair<double, const V*>> summands{{1., &u_n}};
+        for (size_t jj = 0; jj < ii; ++jj)
+          summands.emplace_back(dt * 0.5 * (jj + 1), &stages_k[jj]);
+        V u_i(size, 0.);
+        internal::linear_combination(summands, u_i, use_tbb);
+        EXPECT_LT((u_i - expected).sup_norm(), 1e-14) << "stage " << ii << ", use_tbb = " << use_tbb;
+      }
+    }
+  } // ... stage_equals_temporary_vector_version(...)
+
+  void update_and_revert_equal_temporary_vector_version() const
+  {
+    for (const bool use_tbb : {false, true}) {
+      V expected = u_n;
+      for (size_t ii = 0; ii < num_stages; ++ii)
+        expected += stages_k[ii] * (dt * b[ii]);
+      // the result is one of the summands here
+      V u = u_n;
+      auto summands = update_summands(u);
+      internal::linear_combination(summands, u, use_tbb);
+      EXPECT_LT((u - expected).sup_norm(), 1e-14) << "use_tbb = " << use_tbb;
+      // going back from u at timestep n+1 to timestep n, as in the adaptive Runge Kutta time stepper
+      for (size_t ii = 0; ii < num_stages; ++ii)
+        expected += stages_k[ii] * (-1. * dt * b[ii]);
+      for (auto& summand : summands)
+        if (summand.second != &u)
+          summand.first *= -1.;
+      internal::linear_combination(summands, u, use_tbb);
+      EXPECT_LT((u - expected).sup_norm(), 1e-14) << "use_tbb = " << use_tbb;
+      EXPECT_LT((u - u_n).sup_norm(), 1e-14) << "use_tbb = " << use_tbb;
+    }
+  } // ... update_and_revert_equal_temporary_vector_version(...)
+
+  void does_not_write_to_copies() const
+  {
+    for (const bool use_tbb : {false, true}) {
+      // result shares its data with u_n (copy on write) before linear_combination writes to it
+      V u = u_n;
+      internal::linear_combination(update_summands(u), u, use_tbb);
+      V expected = u_n;
+      for (size_t ii = 0; ii < num_stages; ++ii)
+        expected += stages_k[ii] * (dt * b[ii]);
+      EXPECT_LT((u - expected).sup_norm(), 1e-14) << "use_tbb = " << use_tbb;
+      for (size_t ii = 0; ii < size; ++ii)
+        ASSERT_EQ(u_n[ii], std::sin(double(ii))) << "ii = " << ii << ", use_tbb = " << use_tbb;
+    }
+  } // ... does_not_write_to_copies(...)
+
+  const double dt = 0.1;
+  V u_n;
+  std::vector<V> stages_k;
+  std::vector<double> b;
+}; // struct LinearCombinationTest
+
+
+using VectorTypes = ::testing::Types<XT::LA::CommonDenseVector<double>, XT::LA::IstlDenseVector<double>>;
+
+TYPED_TEST_SUITE(LinearCombinationTest, VectorTypes);
+TYPED_TEST(LinearCombinationTest, stage_equals_temporary_vector_version)
+{
+  this->stage_equals_temporary_vector_version();
+}
+TYPED_TEST(LinearCombinationTest, update_and_revert_equal_temporary_vector_version)
+{
+  this->update_and_revert_equal_temporary_vector_version();
+}
+TYPED_TEST(LinearCombinationTest, does_not_write_to_copies)
+{
+  this->does_not_write_to_copies();
+}
@@ -0,0 +1,136 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/common/dynvector.hh>
+
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/grid/walker.hh>
+#include <dune/xt/la/container/common.hh>
+#include <dune/xt/la/container/conversion.hh>
+#include <dune/xt/la/matrix-inverter.hh>
+
+#include <dune/gdt/local/bilinear-forms/integrals.hh>
+#include <dune/gdt/local/integrands/product.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+#include <dune/gdt/tools/local-mass-matrix.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Compares LocalMassMatrixProvider (the Cholesky factors, the scaled reference blocks of affine elements and the dense
+ * matrices) with the inverse of the directly assembled local mass matrix, on a scaled grid (with local refinement, if
+ * the grid supports it) so that the elements sharing a reference block have different integration elements.
+ */
+template <class G>
+struct LocalMassMatrixProviderTest : public ::testing::Test
+{
+  static constexpr size_t d = G::dimension;
+  using GV = typename G::LeafGridView;
+  using E = XT::Grid::extract_entity_t<GV>;
+  using M = XT::LA::CommonDenseMatrix<double>;
+
+  LocalMassMatrixProviderTest()
+    : grid_provider(XT::Grid::make_cube_grid<G>(0., 3., 4u))
+  {
+    // refine the left part, a no-op for grids without local refinement
+    auto& grid = grid_provider.grid();
+    for (auto&& element : elements(grid.leafGridView()))
+      if (element.geometry().center()[0] < 1.)
+        grid.mark(1, element);
+    grid.preAdapt();
+    grid.adapt();
+    grid.postAdapt();
+  }
+
+  template <class SpaceType>
+  void provider_coincides_with_assembled_inverse(const SpaceType& space) const
+  {
+    const auto grid_view = grid_provider.leaf_view();
+    for (const bool use_tbb : {false, true}) {
+      LocalMassMatrixProvider<GV> provider(grid_view, space, /*provide_dense_matrices=*/true);
+      auto walker = XT::Grid::make_walker(grid_view);
+      walker.append(provider);
+      walker.walk(use_tbb);
+      auto basis = space.basis().localize();
+      const LocalElementIntegralBilinearForm<E> l2_bilinear_form(LocalProductIntegrand<E>(1.));
+      for (auto&& element : elements(grid_view)) {
+        basis->bind(element);
+        const auto expected_matrix = XT::LA::convert_to<M>(l2_bilinear_form.apply2(*basis, *basis));
+        const auto expected_inverse = XT::LA::invert_matrix(expected_matrix);
+        const size_t n = basis->size();
+        const double tolerance = 1e-12 * std::max(1., expected_inverse.sup_norm());
+        // the dense matrices
+        const auto& matrix = provider.local_mass_matrix(element);
+        const auto& inverse = provider.local_mass_matrix_inverse(element);
+        ASSERT_EQ(n, matrix.rows());
+        ASSERT_EQ(n, inverse.rows());
+        EXPECT_LT((matrix - expected_matrix).sup_norm(), 1e-12 * std::max(1., expected_matrix.sup_norm()))
+            << "use_tbb = " << use_tbb;
+        EXPECT_LT((inverse - expected_inverse).sup_norm(), tolerance) << "use_tbb = " << use_tbb;
+        // in place application of the inverse
+        DynamicVector<double> vector(n, 0.);
+        for (size_t ii = 0; ii < n; ++ii)
+          vector[ii] = std::sin(double(ii + 1));
+        DynamicVector<double> expected(n, 0.);
+        for (size_t ii = 0; ii < n; ++ii)
+          for (size_t jj = 0; jj < n; ++jj)
+            expected[ii] += expected_inverse.get_entry(ii, jj) * vector[jj];
+        provider.apply_inverse(element, vector);
+        for (size_t ii = 0; ii < n; ++ii)
+          EXPECT_NEAR(expected[ii], vector[ii], tolerance) << "use_tbb = " << use_tbb << ", ii = " << ii;
+      }
+    }
+  } // ... provider_coincides_with_assembled_inverse(...)
+
+  XT::Grid::GridProvider<G> grid_provider;
+}; // struct LocalMassMatrixProviderTest
+
+
+using Grids = ::testing::Types<ONED_1D,
+                               YASP_2D_EQUIDISTANT_OFFSET
+#if HAVE_DUNE_ALUGRID
+                               ,
+                               ALU_2D_SIMPLEX_CONFORMING
+#endif
+                               >;
+
+TYPED_TEST_SUITE(LocalMassMatrixProviderTest, Grids);
+TYPED_TEST(LocalMassMatrixProviderTest, finite_volume)
+{
+  this->provider_coincides_with_assembled_inverse(make_finite_volume_space(this->grid_provider.leaf_view()));
+}
+TYPED_TEST(LocalMassMatrixProviderTest, discontinuous_lagrange)
+{
+  for (int order : {1, 2, 3})
+    this->provider_coincides_with_assembled_inverse(
+        make_discontinuous_lagrange_space(this->grid_provider.leaf_view(), order));
+}
+TYPED_TEST(LocalMassMatrixProviderTest, dense_matrices_are_opt_in)
+{
+  const auto grid_view = this->grid_provider.leaf_view();
+  const auto space = make_finite_volume_space(grid_view);
+  LocalMassMatrixProvider<typename TestFixture::GV> provider(grid_view, space);
+  auto walker = XT::Grid::make_walker(grid_view);
+  walker.append(provider);
+  walker.walk();
+  const auto element = *elements(grid_view).begin();
+  EXPECT_THROW(provider.local_mass_matrix(element), XT::Common::Exceptions::you_are_using_this_wrong);
+}
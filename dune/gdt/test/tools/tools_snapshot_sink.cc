@@ -0,0 +1,98 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/la/container/istl.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+#include <dune/gdt/tools/timestepper/snapshot-sink.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+struct AsyncSnapshotWriterTest : public ::testing::Test
+{
+  using G = YASP_2D_EQUIDISTANT_OFFSET;
+  using GV = typename G::LeafGridView;
+  using V = XT::LA::IstlDenseVector<double>;
+  using DiscreteFunctionType = DiscreteFunction<V, GV>;
+  using WriterType = AsyncSnapshotWriter<DiscreteFunctionType>;
+
+  AsyncSnapshotWriterTest()
+    : grid(XT::Grid::make_cube_grid<G>(0., 1., 4u))
+    , space(make_finite_volume_space(grid.leaf_view()))
+  {}
+
+  static void fill(V& vector, const size_t step)
+  {
+    for (size_t ii = 0; ii < vector.size(); ++ii)
+      vector[ii] = std::sin(double(ii + 1) * double(step + 1));
+  }
+
+  XT::Grid::GridProvider<G> grid;
+  const FiniteVolumeSpace<GV> space;
+}; // struct AsyncSnapshotWriterTest
+
+
+TEST_F(AsyncSnapshotWriterTest, write_dofs_and_read_dofs_round_trip)
+{
+  const std::string filename = WriterType::dofs_filename("tools_snapshot_sink__round_trip", 0, 7);
+  V dofs(space.mapper().size(), 0.);
+  fill(dofs, 7);
+  const double t = 1. / 3.;
+  WriterType::write_dofs(filename, t, dofs);
+  V read(space.mapper().size(), 0.);
+  EXPECT_EQ(t, WriterType::read_dofs(filename, read));
+  for (size_t ii = 0; ii < dofs.size(); ++ii)
+    EXPECT_EQ(dofs[ii], read[ii]) << "ii = " << ii;
+  V wrong_size(space.mapper().size() + 1, 0.);
+  EXPECT_THROW(WriterType::read_dofs(filename, wrong_size), Exceptions::discrete_function_error);
+  std::remove(filename.c_str());
+}
+
+TEST_F(AsyncSnapshotWriterTest, drains_the_queue)
+{
+  const std::string prefix = "tools_snapshot_sink__drain";
+  const size_t num_snapshots = 10;
+  V dofs(space.mapper().size(), 0.);
+  auto solution = make_discrete_function(space, dofs);
+  V read(space.mapper().size(), 0.);
+  V expected(space.mapper().size(), 0.);
+  // more snapshots than buffers, the solution is altered right after each push; first drained by flush(), then by the
+  // destructor
+  for (const bool use_flush : {true, false}) {
+    {
+      WriterType writer(prefix, /*visualize=*/false, /*spill_dofs=*/true, /*max_queued_snapshots=*/2);
+      for (size_t step = 0; step < num_snapshots; ++step) {
+        fill(dofs, step);
+        writer.push(0.5 * step, step, solution);
+        dofs.set_all(-1.);
+      }
+      if (use_flush)
+        writer.flush();
+    }
+    for (size_t step = 0; step < num_snapshots; ++step) {
+      const std::string filename = WriterType::dofs_filename(prefix, 0, step);
+      EXPECT_EQ(0.5 * step, WriterType::read_dofs(filename, read)) << "use_flush = " << use_flush;
+      fill(expected, step);
+      for (size_t ii = 0; ii < read.size(); ++ii)
+        EXPECT_EQ(expected[ii], read[ii]) << "use_flush = " << use_flush << ", step = " << step << ", ii = " << ii;
+      std::remove(filename.c_str());
+    }
+  }
+}
@@ -0,0 +1,58 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/tools/sparsity-pattern.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+template <class G>
+struct SparsityPatternTest : public ::testing::Test
+{
+  template <class SpaceType>
+  static void check_serial_and_parallel_patterns_coincide(const SpaceType& space)
+  {
+    for (auto&& stencil : {Stencil::element, Stencil::intersection, Stencil::element_and_intersection}) {
+      const auto serial_pattern = make_sparsity_pattern(space, space, space.grid_view(), stencil, /*use_tbb=*/false);
+      const auto parallel_pattern = make_sparsity_pattern(space, space, space.grid_view(), stencil, /*use_tbb=*/true);
+      EXPECT_TRUE(serial_pattern == parallel_pattern) << "stencil = " << stencil;
+      // the serial pattern has to be sorted and free of duplicates as well
+      for (size_t ii = 0; ii < serial_pattern.size(); ++ii) {
+        const auto& row = serial_pattern.inner(ii);
+        for (size_t jj = 1; jj < row.size(); ++jj)
+          EXPECT_LT(row[jj - 1], row[jj]) << "stencil = " << stencil << ", ii = " << ii;
+      }
+    }
+  } // ... check_serial_and_parallel_patterns_coincide(...)
+
+  void serial_and_parallel_patterns_coincide()
+  {
+    auto grid = XT::Grid::make_cube_grid<G>(0., 1., 4u);
+    const auto grid_view = grid.leaf_view();
+    check_serial_and_parallel_patterns_coincide(make_continuous_lagrange_space(grid_view, 2));
+    check_serial_and_parallel_patterns_coincide(make_discontinuous_lagrange_space(grid_view, 1));
+  }
+}; // struct SparsityPatternTest
+
+
+using Grids = ::testing::Types<YASP_1D_EQUIDISTANT_OFFSET, YASP_2D_EQUIDISTANT_OFFSET, YASP_3D_EQUIDISTANT_OFFSET>;
+
+TYPED_TEST_SUITE(SparsityPatternTest, Grids);
+TYPED_TEST(SparsityPatternTest, serial_and_parallel_patterns_coincide)
+{
+  this->serial_and_parallel_patterns_coincide();
+}
@@ -12,8 +12,10 @@
 #define DUNE_GDT_DISCRETEFUNCTION_ADAPTATION_HH
 
 #include <list>
+#include <vector>
 
 #include <dune/common/dynvector.hh>
+#include <dune/common/timer.hh>
 #include <dune/grid/common/rangegenerators.hh>
 #include <dune/grid/utility/persistentcontainer.hh>
 
@@ -24,12 +26,18 @@
 #include <dune/gdt/discretefunction/default.hh>
 #include <dune/gdt/exceptions.hh>
 #include <dune/gdt/spaces/interface.hh>
+#include <dune/gdt/tools/parallel-for.hh>
 
 namespace Dune {
 namespace GDT {
 
 
 /**
+ * If use_tbb is true, the element loops of pre_adapt() and adapt() are processed in parallel (see
+ * parallel_for_chunks): the leaf data is stored concurrently, restrictions are computed concurrently for all elements
+ * of a level (level by level) and prolongations are computed concurrently, if none of the spaces is continuous (which
+ * would lead to concurrent writes to shared DoFs). The walltime of each phase is logged.
+ *
  * \todo Only depend on the grid type, use type erasure to allow to add arbitrary discrete functions, possibly implement
  *       this by element functors which are used in a grid walker.
  */
@@ -43,15 +51,17 @@ public:
   using DiscreteFunctionType = DiscreteFunction<V, GV, r, rC, RF>;
   using SpaceType = SpaceInterface<GV, r, rC, RF>;
   using G = typename GV::Grid;
+  using ElementType = typename G::template Codim<0>::Entity;
   static_assert(!XT::Grid::is_yaspgrid<G>::value, "The PersistentContainer is known to segfault for YaspGrid!");
 
-  AdaptationHelper(G& grd, const std::string& logging_prefix = "")
+  AdaptationHelper(G& grd, const std::string& logging_prefix = "", const bool use_tbb = false)
     : Logger(logging_prefix.empty() ? "AdaptationHelper" : logging_prefix,
              /*logging_disabled=*/logging_prefix.empty())
     , grid_(grd)
+    , use_tbb_(use_tbb)
     , data_(new std::remove_reference_t<decltype(*data_)>)
   {
-    LOG_(info) << "AdaptationHelper(&grd=" << &grd << ")" << std::endl;
+    LOG_(info) << "AdaptationHelper(&grd=" << &grd << ", use_tbb=" << use_tbb << ")" << std::endl;
   }
 
   ThisType& append(SpaceType& space, DiscreteFunctionType& discrete_function)
@@ -68,12 +78,14 @@ public:
   void pre_adapt(const bool pre_adapt_grid = true)
   {
     LOG_(info) << "pre_adapt(pre_adapt_grid=" << pre_adapt_grid << ")" << std::endl;
+    Timer timer;
     auto grid_view = grid_.leafGridView();
     // * preadapt will mark elements which might vanish due to coarsening
     bool elements_may_be_coarsened = true;
     if (pre_adapt_grid) {
       LOG_(info) << "    pre-adapting grid ..." << std::endl;
       elements_may_be_coarsened = grid_.preAdapt();
+      LOG_(info) << "      took " << timer.elapsed() << "s" << std::endl;
     }
     LOG_(info) << "    pre-adapting " << data_->size() << " spaces ..." << std::endl;
     for (auto& data : *data_) {
@@ -81,44 +93,63 @@ public:
       space.pre_adapt();
     }
     LOG_(info) << "    storing persistent leaf data ..." << std::endl;
+    timer.reset();
     // * each discrete function is associated with persistent storage (see data_, keeps local DoF vectors, which can be
     //   converted to DynamicVector<RF>) to keep our data:
     //   - all kept leaf elements might change their indices and
     //   - all coarsened elements might vanish
+    //   [note: we ensure that each element has a slot, so that the concurrent writes below do not modify the
+    //    structure of the containers]
+    for (auto& data : *data_)
+      std::get<2>(data).resize();
     // * we also need a container to recall those elements where we need to restrict to
     //   [note: we would like to use `PersistentContainer<G, bool> restriction_required(grid_, 0, false);` here, but
     //    then `restriction_required[element.father()] = true` does not compile for some grids]
     PersistentContainer<G, int> restriction_required(grid_, 0, 0);
-    // * walk the current leaf of the grid ...
+    // * walk the current leaf of the grid to mark father elements ...
+    std::vector<ElementType> leaf_elements;
+    leaf_elements.reserve(grid_view.indexSet().size(0));
     for (auto&& element : elements(grid_view)) {
-      for (auto& data : *data_) {
-        //   ... to get the local FE data ...
-        auto local_FE_data = std::get<0>(data).access().basis().localize(element)->backup();
-        //   ... and the local DoF data ...
-        auto& local_function = std::get<3>(data);
-        local_function->bind(element);
-        auto local_DoF_data = XT::LA::convert_to<DynamicVector<RF>>(local_function->dofs());
-        //   ... and to store them ...
-        auto& persistent_data = std::get<2>(data);
-        persistent_data[element] = std::make_pair(std::move(local_FE_data), std::move(local_DoF_data));
-      }
-      //   ... and to mark father elements
+      leaf_elements.push_back(element);
       if (element.mightVanish())
         restriction_required[element.father()] = 1;
     }
+    // * ... and to store the local FE and DoF data (each element only writes to its own slots)
+    parallel_for_chunks(
+        0,
+        leaf_elements.size(),
+        [&](const size_t first, const size_t last) {
+          for (auto& data : *data_) {
+            auto basis = std::get<0>(data).access().basis().localize();
+            auto local_function = std::get<1>(data).access().local_discrete_function();
+            auto& persistent_data = std::get<2>(data);
+            for (size_t ii = first; ii < last; ++ii) {
+              const auto& element = leaf_elements[ii];
+              //   ... get the local FE data ...
+              basis->bind(element);
+              auto local_FE_data = basis->backup();
+              //   ... and the local DoF data ...
+              local_function->bind(element);
+              auto local_DoF_data = XT::LA::convert_to<DynamicVector<RF>>(local_function->dofs());
+              //   ... and store them
+              persistent_data[element] = std::make_pair(std::move(local_FE_data), std::move(local_DoF_data));
+            }
+          }
+        },
+        use_tbb_);
+    LOG_(info) << "      took " << timer.elapsed() << "s" << std::endl;
     LOG_(info) << "    computing restrictions ..." << std::endl;
+    timer.reset();
     // * now walk the grid up all coarser levels ...
     if (elements_may_be_coarsened) {
+      std::vector<ElementType> level_elements;
       for (int level = grid_.maxLevel() - 1; level >= 0; --level) {
         auto level_view = grid_.levelGridView(level);
+        level_elements.clear();
         for (auto&& element : elements(level_view)) {
-          // ... to compute restrictions ...
-          for (auto& data : *data_) {
-            const auto& space = std::get<0>(data).access();
-            auto& persistent_data = std::get<2>(data);
-            if (restriction_required[element])
-              space.restrict_to(element, persistent_data);
-          }
+          // ... to collect the elements to restrict to ...
+          if (restriction_required[element])
+            level_elements.push_back(element);
           // ... and to mark father elements
           if (element.mightVanish()) {
             DUNE_THROW_IF(
@@ -126,19 +157,36 @@ public:
             restriction_required[element.father()] = true;
           }
         }
+        // ... and to compute restrictions (each element only writes to its own slot and the ones of its descendants)
+        parallel_for_chunks(
+            0,
+            level_elements.size(),
+            [&](const size_t first, const size_t last) {
+              for (auto& data : *data_) {
+                const auto& space = std::get<0>(data).access();
+                auto& persistent_data = std::get<2>(data);
+                for (size_t ii = first; ii < last; ++ii)
+                  space.restrict_to(level_elements[ii], persistent_data);
+              }
+            },
+            use_tbb_);
       }
     }
+    LOG_(info) << "      took " << timer.elapsed() << "s" << std::endl;
   } // ... pre_adapt(...)
 
   void adapt(const bool adapt_grid = true)
   {
     LOG_(info) << "adapt(adapt_grid=" << adapt_grid << ")" << std::endl;
+    Timer timer;
     auto grid_view = grid_.leafGridView();
     if (adapt_grid) {
       LOG_(info) << "    adapting grid ..." << std::endl;
       grid_.adapt();
+      LOG_(info) << "      took " << timer.elapsed() << "s" << std::endl;
     }
     LOG_(info) << "    adapting persistent data ..." << std::endl;
+    timer.reset();
     // * clean up data structures
     for (auto& data : *data_) {
       auto& persistent_data = std::get<2>(data);
@@ -147,23 +195,38 @@ public:
     }
     LOG_(info) << "    adapting " << data_->size() << " spaces ..." << std::endl;
     // * update spaces and resize vectors
+    bool any_space_is_continuous = false;
     for (auto& data : *data_) {
       auto& space = std::get<0>(data).access();
       auto& discrete_function = std::get<1>(data).access();
       space.adapt();
       discrete_function.dofs().resize_after_adapt();
+      any_space_is_continuous = any_space_is_continuous || space.continuous(0);
     }
+    LOG_(info) << "      took " << timer.elapsed() << "s" << std::endl;
     LOG_(info) << "    computing prolongations ..." << std::endl;
+    timer.reset();
     // * get the data back to the discrete function
-    for (auto&& element : elements(grid_view)) {
-      for (auto& data : *data_) {
-        auto& space = std::get<0>(data).access();
-        const auto& persistent_data = std::get<2>(data);
-        auto& local_function = std::get<3>(data);
-        local_function->bind(element);
-        local_function->dofs().assign_from(space.prolong_onto(element, persistent_data));
-      }
-    }
+    std::vector<ElementType> leaf_elements;
+    leaf_elements.reserve(grid_view.indexSet().size(0));
+    for (auto&& element : elements(grid_view))
+      leaf_elements.push_back(element);
+    parallel_for_chunks(
+        0,
+        leaf_elements.size(),
+        [&](const size_t first, const size_t last) {
+          for (auto& data : *data_) {
+            const auto& space = std::get<0>(data).access();
+            const auto& persistent_data = std::get<2>(data);
+            auto local_function = std::get<1>(data).access().local_discrete_function();
+            for (size_t ii = first; ii < last; ++ii) {
+              local_function->bind(leaf_elements[ii]);
+              local_function->dofs().assign_from(space.prolong_onto(leaf_elements[ii], persistent_data));
+            }
+          }
+        },
+        use_tbb_ && !any_space_is_continuous);
+    LOG_(info) << "      took " << timer.elapsed() << "s" << std::endl;
   } // ... adapt(...)
 
   void post_adapt(const bool post_adapt_grid = true, const bool clear = false)
@@ -193,6 +256,7 @@ public:
 
 protected:
   G& grid_;
+  const bool use_tbb_;
   std::shared_ptr<std::list<std::tuple<XT::Common::StorageProvider<SpaceType>,
                                        XT::Common::StorageProvider<DiscreteFunctionType>,
                                        PersistentContainer<G, std::pair<DynamicVector<RF>, DynamicVector<RF>>>,
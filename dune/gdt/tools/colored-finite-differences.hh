@@ -0,0 +1,197 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#ifndef DUNE_GDT_TOOLS_COLORED_FINITE_DIFFERENCES_HH
+#define DUNE_GDT_TOOLS_COLORED_FINITE_DIFFERENCES_HH
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/float_cmp.hh>
+#include <dune/xt/common/parameter.hh>
+#include <dune/xt/la/container/pattern.hh>
+
+#include <dune/gdt/exceptions.hh>
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief A partition of the columns of a sparsity pattern into groups (colors) of structurally orthogonal columns,
+ *        i.e., no two columns of the same color have an entry in the same row.
+ *
+ * The columns are colored greedily in their natural order, each one with the smallest color not used by any column
+ * sharing a row with it. The number of colors is thus bounded by the maximum number of columns coupled via a row
+ * (for grid based patterns: roughly the number of DoFs in the stencil of an element).
+ */
+class ColumnColoring
+{
+public:
+  ColumnColoring(const XT::LA::SparsityPatternDefault& pattern, const size_t num_cols)
+    : num_cols_(num_cols)
+    , column_offsets_(num_cols + 1, 0)
+  {
+    // transpose the pattern (row -> columns) to obtain column -> rows, in compressed form
+    for (size_t ii = 0; ii < pattern.size(); ++ii)
+      for (const auto& jj : pattern.inner(ii)) {
+        DUNE_THROW_IF(jj >= num_cols,
+                      XT::Common::Exceptions::shapes_do_not_match,
+                      "pattern column " << jj << " in row " << ii << ", num_cols = " << num_cols);
+        ++column_offsets_[jj + 1];
+      }
+    for (size_t jj = 0; jj < num_cols; ++jj)
+      column_offsets_[jj + 1] += column_offsets_[jj];
+    column_rows_.resize(column_offsets_[num_cols]);
+    std::vector<size_t> fill(column_offsets_.begin(), column_offsets_.end() - 1);
+    for (size_t ii = 0; ii < pattern.size(); ++ii)
+      for (const auto& jj : pattern.inner(ii))
+        column_rows_[fill[jj]++] = ii;
+    // greedy coloring, marking the colors of all columns coupled to column jj with jj
+    std::vector<size_t> colors(num_cols, std::numeric_limits<size_t>::max());
+    std::vector<size_t> marker;
+    size_t num_colors = 0;
+    for (size_t jj = 0; jj < num_cols; ++jj) {
+      for (size_t kk = column_offsets_[jj]; kk < column_offsets_[jj + 1]; ++kk)
+        for (const auto& coupled_column : pattern.inner(column_rows_[kk]))
+          if (colors[coupled_column] != std::numeric_limits<size_t>::max())
+            marker[colors[coupled_column]] = jj;
+      size_t color = 0;
+      while (color < num_colors && marker[color] == jj)
+        ++color;
+      if (color == num_colors) {
+        ++num_colors;
+        marker.push_back(std::numeric_limits<size_t>::max());
+      }
+      colors[jj] = color;
+    }
+    // group the columns by color
+    color_offsets_.assign(num_colors + 1, 0);
+    for (size_t jj = 0; jj < num_cols; ++jj)
+      ++color_offsets_[colors[jj] + 1];
+    for (size_t cc = 0; cc < num_colors; ++cc)
+      color_offsets_[cc + 1] += color_offsets_[cc];
+    color_columns_.resize(num_cols);
+    fill.assign(color_offsets_.begin(), color_offsets_.end() - 1);
+    for (size_t jj = 0; jj < num_cols; ++jj)
+      color_columns_[fill[colors[jj]]++] = jj;
+  } // ColumnColoring(...)
+
+  size_t num_cols() const
+  {
+    return num_cols_;
+  }
+
+  size_t num_colors() const
+  {
+    return color_offsets_.size() - 1;
+  }
+
+  /// \brief The columns of the given color are color_columns()[color_begin(color)] to [color_end(color) - 1].
+  size_t color_begin(const size_t color) const
+  {
+    return color_offsets_[color];
+  }
+
+  size_t color_end(const size_t color) const
+  {
+    return color_offsets_[color + 1];
+  }
+
+  const std::vector<size_t>& color_columns() const
+  {
+    return color_columns_;
+  }
+
+  /// \brief The rows of column jj are column_rows()[column_begin(jj)] to [column_end(jj) - 1].
+  size_t column_begin(const size_t jj) const
+  {
+    return column_offsets_[jj];
+  }
+
+  size_t column_end(const size_t jj) const
+  {
+    return column_offsets_[jj + 1];
+  }
+
+  const std::vector<size_t>& column_rows() const
+  {
+    return column_rows_;
+  }
+
+private:
+  const size_t num_cols_;
+  std::vector<size_t> column_offsets_;
+  std::vector<size_t> column_rows_;
+  std::vector<size_t> color_offsets_;
+  std::vector<size_t> color_columns_;
+}; // class ColumnColoring
+
+
+/**
+ * \brief Adds scaling times a finite-difference approximation of the jacobian of op at source to matrix, perturbing
+ *        all (structurally orthogonal) source DoFs of a color at once [Curtis, Powell, Reid, 1974].
+ *
+ * This requires 1 + coloring.num_colors() applications of op (instead of one local application per DoF and element or
+ * intersection, as in LocalElementOperatorFiniteDifferenceJacobianAssembler), the DoF jj is perturbed by
+ * eps * (1 + |source[jj]|). The coloring has to be obtained from a pattern containing the actual one of the jacobian,
+ * usually the pattern of matrix.
+ *
+ * \note Only the entries of the pattern of the coloring are computed (and added to matrix).
+ */
+template <class OperatorType, class VectorType, class MatrixType, class F>
+void colored_finite_difference_jacobian(const OperatorType& op,
+                                        const VectorType& source,
+                                        MatrixType& matrix,
+                                        const ColumnColoring& coloring,
+                                        const F& scaling = 1.,
+                                        const double eps = 1e-7,
+                                        const XT::Common::Parameter& param = {})
+{
+  DUNE_THROW_IF(source.size() != coloring.num_cols(),
+                XT::Common::Exceptions::shapes_do_not_match,
+                "source.size() = " << source.size() << "\n   coloring.num_cols() = " << coloring.num_cols());
+  VectorType unperturbed_range(op.range_space().mapper().size(), 0.);
+  op.apply(source, unperturbed_range, param);
+  VectorType perturbed_source = source;
+  VectorType perturbed_range(op.range_space().mapper().size(), 0.);
+  const auto& color_columns = coloring.color_columns();
+  const auto& column_rows = coloring.column_rows();
+  for (size_t cc = 0; cc < coloring.num_colors(); ++cc) {
+    // perturb all source DoFs of this color at once
+    for (size_t kk = coloring.color_begin(cc); kk < coloring.color_end(cc); ++kk) {
+      const size_t jj = color_columns[kk];
+      perturbed_source.set_entry(jj, source.get_entry(jj) + eps * (1. + std::abs(source.get_entry(jj))));
+    }
+    op.apply(perturbed_source, perturbed_range, param);
+    // the rows of the columns of this color are disjoint, so each range DoF observes one perturbation only
+    for (size_t kk = coloring.color_begin(cc); kk < coloring.color_end(cc); ++kk) {
+      const size_t jj = color_columns[kk];
+      // the actual perturbation (after rounding)
+      const auto eps_jj = perturbed_source.get_entry(jj) - source.get_entry(jj);
+      for (size_t ll = coloring.column_begin(jj); ll < coloring.column_end(jj); ++ll) {
+        const size_t ii = column_rows[ll];
+        auto derivative = (perturbed_range.get_entry(ii) - unperturbed_range.get_entry(ii)) / eps_jj;
+        if (XT::Common::FloatCmp::eq(derivative, eps_jj))
+          derivative = 0;
+        matrix.add_to_entry(ii, jj, scaling * derivative);
+      }
+      // restore source
+      perturbed_source.set_entry(jj, source.get_entry(jj));
+    }
+  }
+} // ... colored_finite_difference_jacobian(...)
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TOOLS_COLORED_FINITE_DIFFERENCES_HH
@@ -13,8 +13,13 @@
 #ifndef DUNE_GDT_SPACES_TOOLS_DIRICHLET_CONSTRAINTS_HH
 #define DUNE_GDT_SPACES_TOOLS_DIRICHLET_CONSTRAINTS_HH
 
+#include <algorithm>
 #include <set>
+#include <vector>
 
+#include <dune/common/dynvector.hh>
+
+#include <dune/xt/common/exceptions.hh>
 #include <dune/xt/common/numeric_cast.hh>
 #include <dune/xt/common/parallel/threadstorage.hh>
 #include <dune/xt/grid/boundaryinfo.hh>
@@ -41,6 +46,18 @@ struct setUnion
 };
 
 
+template <typename T>
+struct vectorConcatenation
+{
+  std::vector<T> operator()(const std::vector<T>& a, const std::vector<T>& b)
+  {
+    std::vector<T> result = a;
+    result.insert(result.end(), b.begin(), b.end());
+    return result;
+  }
+};
+
+
 } // namespace internal
 
 
@@ -211,6 +228,200 @@ private:
 }; // class DirichletConstraints
 
 
+/**
+ * \brief Determines the same DoFs as DirichletConstraints, stored as a sorted vector and a bitmask.
+ *
+ * In contrast to DirichletConstraints, this is an intersection functor which returns early for inner intersections, so
+ * the basis is only bound on elements at the (Dirichlet or process) boundary. The global DoFs are gathered in a vector
+ * per thread (possibly with duplicates), which are concatenated and sorted once upon finalize().
+ *
+ * In addition to dirichlet_DoFs(), the bitmask dirichlet_DoF_mask() allows to eliminate the Dirichlet columns of an
+ * assembled matrix in a single pass over its pattern (instead of one clear_col() per DoF), see apply().
+ *
+ * \sa DirichletConstraints
+ */
+template <class IntersectionType, class SpaceType>
+class SortedDirichletConstraints
+  : public Dune::XT::Grid::IntersectionFunctor<typename SpaceType::GridViewType>
+  , public XT::Common::ThreadResultPropagator<SortedDirichletConstraints<IntersectionType, SpaceType>,
+                                              std::vector<size_t>,
+                                              internal::vectorConcatenation<size_t>>
+{
+  using ThisType = SortedDirichletConstraints;
+  using BaseType = XT::Grid::IntersectionFunctor<typename SpaceType::GridViewType>;
+  using Propagator =
+      XT::Common::ThreadResultPropagator<ThisType, std::vector<size_t>, internal::vectorConcatenation<size_t>>;
+  friend Propagator;
+
+public:
+  using BoundaryInfoType = XT::Grid::BoundaryInfo<IntersectionType>;
+  using ElementType = typename BaseType::ElementType;
+  using GridView = typename SpaceType::GridViewType;
+  static constexpr size_t d = SpaceType::d;
+  static constexpr size_t r = SpaceType::r;
+  static constexpr size_t rC = SpaceType::rC;
+  using R = typename SpaceType::R;
+  using SpaceInterfaceType = SpaceInterface<GridView, r, rC, R>;
+
+  SortedDirichletConstraints(const BoundaryInfoType& bnd_info, const SpaceType& space)
+    : BaseType()
+    , Propagator(this)
+    , boundary_info_(bnd_info)
+    , space_(space.copy())
+    , basis_(space_->basis().localize())
+    , global_indices_(space_->mapper().max_local_size())
+  {}
+
+  SortedDirichletConstraints(const ThisType& other)
+    : BaseType(other)
+    , Propagator(this)
+    , boundary_info_(other.boundary_info_)
+    , space_(other.space_->copy())
+    , basis_(space_->basis().localize())
+    , global_indices_(space_->mapper().max_local_size())
+  {}
+
+  void apply_local(const IntersectionType& intersection,
+                   const ElementType& inside_element,
+                   const ElementType& /*outside_element*/) override final
+  {
+    if (intersection.neighbor() && !intersection.boundary())
+      return;
+    // actual dirichlet intersections + process boundaries for parallel runs
+    if (boundary_info_.type(intersection) != XT::Grid::DirichletBoundary()
+        && (intersection.neighbor() || intersection.boundary()))
+      return;
+    basis_->bind(inside_element);
+    space_->mapper().global_indices(inside_element, global_indices_);
+    const auto& reference_element = ReferenceElements<double, d>::general(inside_element.type());
+    const auto local_key_indices = basis_->finite_element().coefficients().local_key_indices();
+    const auto intersection_index = intersection.indexInInside();
+    for (const auto& local_DoF : local_key_indices[1][intersection_index])
+      dirichlet_DoFs_.push_back(global_indices_[local_DoF]);
+    for (int cc = 2; cc <= XT::Common::numeric_cast<int>(d); ++cc) {
+      for (int ii = 0; ii < reference_element.size(intersection_index, 1, cc); ++ii) {
+        const auto subentity_id = reference_element.subEntity(intersection_index, 1, ii, cc);
+        for (const auto& local_DoF : local_key_indices[cc][subentity_id])
+          dirichlet_DoFs_.push_back(global_indices_[local_DoF]);
+      }
+    }
+  } // ... apply_local(...)
+
+  const BoundaryInfoType& boundary_info() const
+  {
+    return boundary_info_;
+  }
+
+  /**
+   * \note Sorted and unique, only valid after finalize() (i.e., after the grid walk).
+   */
+  const std::vector<size_t>& dirichlet_DoFs() const
+  {
+    return dirichlet_DoFs_;
+  }
+
+  /**
+   * \brief dirichlet_DoF_mask()[ii] is true iff ii is a Dirichlet DoF, only valid after finalize().
+   */
+  const std::vector<bool>& dirichlet_DoF_mask() const
+  {
+    return dirichlet_DoF_mask_;
+  }
+
+  bool is_dirichlet_DoF(const size_t ii) const
+  {
+    return ii < dirichlet_DoF_mask_.size() && dirichlet_DoF_mask_[ii];
+  }
+
+  /**
+   * If ensure_symmetry is true, the Dirichlet columns are cleared in a single pass over the pattern of the matrix.
+   */
+  template <class M>
+  void apply(XT::LA::MatrixInterface<M>& matrix, const bool only_clear = false, const bool ensure_symmetry = true) const
+  {
+    if (only_clear)
+      for (const auto& DoF : dirichlet_DoFs_)
+        matrix.clear_row(DoF);
+    else
+      for (const auto& DoF : dirichlet_DoFs_)
+        matrix.unit_row(DoF);
+    if (ensure_symmetry)
+      clear_dirichlet_cols(matrix);
+  } // ... apply(...)
+
+  template <class V>
+  void apply(XT::LA::VectorInterface<V>& vector) const
+  {
+    for (const auto& DoF : dirichlet_DoFs_)
+      vector[DoF] = 0.0;
+  }
+
+  template <class M, class V>
+  void apply(XT::LA::MatrixInterface<M>& matrix,
+             XT::LA::VectorInterface<V>& vector,
+             const bool only_clear = false,
+             const bool ensure_symmetry = true) const
+  {
+    apply(matrix, only_clear, ensure_symmetry);
+    apply(vector);
+  }
+
+  /**
+   * \brief Sets all entries of the Dirichlet columns in the non-Dirichlet rows of the matrix to zero.
+   */
+  template <class M>
+  void clear_dirichlet_cols(XT::LA::MatrixInterface<M>& matrix) const
+  {
+    DUNE_THROW_IF(matrix.cols() != dirichlet_DoF_mask_.size(),
+                  XT::Common::Exceptions::shapes_do_not_match,
+                  "matrix.cols() = " << matrix.cols() << "\n   space.mapper().size() = " << dirichlet_DoF_mask_.size());
+    if (dirichlet_DoFs_.empty())
+      return;
+    const auto pattern = matrix.pattern();
+    for (size_t ii = 0; ii < matrix.rows(); ++ii) {
+      if (is_dirichlet_DoF(ii))
+        continue;
+      for (const auto& jj : pattern.inner(ii))
+        if (dirichlet_DoF_mask_[jj])
+          matrix.set_entry(ii, jj, 0.);
+    }
+  } // ... clear_dirichlet_cols(...)
+
+  void finalize() override final
+  {
+    Propagator::finalize_imp();
+    std::sort(dirichlet_DoFs_.begin(), dirichlet_DoFs_.end());
+    dirichlet_DoFs_.erase(std::unique(dirichlet_DoFs_.begin(), dirichlet_DoFs_.end()), dirichlet_DoFs_.end());
+    dirichlet_DoF_mask_.assign(space_->mapper().size(), false);
+    for (const auto& DoF : dirichlet_DoFs_)
+      dirichlet_DoF_mask_[DoF] = true;
+  } // ... finalize(...)
+
+  BaseType* copy() override final
+  {
+    return Propagator::copy_imp();
+  }
+
+  std::vector<size_t> result() const
+  {
+    return dirichlet_DoFs_;
+  }
+
+  void set_result(std::vector<size_t> res)
+  {
+    dirichlet_DoFs_ = std::move(res);
+  }
+
+private:
+  const BoundaryInfoType& boundary_info_;
+  std::unique_ptr<const SpaceInterfaceType> space_;
+  mutable std::unique_ptr<typename SpaceInterfaceType::GlobalBasisType::LocalizedType> basis_;
+  DynamicVector<size_t> global_indices_;
+  std::vector<size_t> dirichlet_DoFs_;
+  std::vector<bool> dirichlet_DoF_mask_;
+}; // class SortedDirichletConstraints
+
+
 template <class GV, size_t r, size_t rC, class R>
 DirichletConstraints<XT::Grid::extract_intersection_t<GV>, SpaceInterface<GV, r, rC, R>>
 make_dirichlet_constraints(const SpaceInterface<GV, r, rC, R>& space,
@@ -220,6 +431,16 @@ make_dirichlet_constraints(const SpaceInterface<GV, r, rC, R>& space,
 }
 
 
+template <class GV, size_t r, size_t rC, class R>
+SortedDirichletConstraints<XT::Grid::extract_intersection_t<GV>, SpaceInterface<GV, r, rC, R>>
+make_sorted_dirichlet_constraints(const SpaceInterface<GV, r, rC, R>& space,
+                                  const XT::Grid::BoundaryInfo<XT::Grid::extract_intersection_t<GV>>& boundary_info)
+{
+  return SortedDirichletConstraints<XT::Grid::extract_intersection_t<GV>, SpaceInterface<GV, r, rC, R>>(boundary_info,
+                                                                                                         space);
+}
+
+
 } // namespace GDT
 } // namespace Dune
 
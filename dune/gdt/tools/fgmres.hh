@@ -0,0 +1,126 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#ifndef DUNE_GDT_TOOLS_FGMRES_HH
+#define DUNE_GDT_TOOLS_FGMRES_HH
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <dune/xt/common/exceptions.hh>
+
+namespace Dune {
+namespace GDT {
+namespace internal {
+
+
+/**
+ * \brief Approximately solves A x = b by restarted, right-preconditioned flexible GMRES [Saad, 1993], where A and
+ *        the preconditioner P are only given by their application.
+ *
+ * Since the preconditioned directions are stored (in addition to the Krylov basis), P may change from one iteration
+ * to the next (e.g., an inexact inner solve). The given x is used as initial guess.
+ *
+ * \param apply_A    apply_A(v, w) computes w = A v
+ * \param apply_P    apply_P(v, z) computes z ~= A^{-1} v
+ * \param rel_tol    the iteration stops once |b - A x|_2 <= rel_tol * |b|_2
+ * \param max_iter   maximum number of applications of A (in total)
+ * \param restart    maximum dimension of the Krylov space before restarting
+ * \return the number of applications of A, the final residual norm is stored in residual_norm
+ */
+template <class VectorType, class ApplyAType, class ApplyPType>
+size_t fgmres(const ApplyAType& apply_A,
+              const ApplyPType& apply_P,
+              const VectorType& b,
+              VectorType& x,
+              const double rel_tol,
+              const size_t max_iter,
+              const size_t restart,
+              double& residual_norm)
+{
+  DUNE_THROW_IF(restart == 0, XT::Common::Exceptions::wrong_input_given, "restart = 0");
+  DUNE_THROW_IF(b.size() != x.size(),
+                XT::Common::Exceptions::shapes_do_not_match,
+                "b.size() = " << b.size() << "\n   x.size() = " << x.size());
+  const double target = rel_tol * b.l2_norm();
+  std::vector<VectorType> V(restart + 1, b);
+  std::vector<VectorType> Z(restart, b);
+  std::vector<std::vector<double>> H(restart + 1, std::vector<double>(restart, 0.));
+  std::vector<double> cs(restart, 0.), sn(restart, 0.), g(restart + 1, 0.), y(restart, 0.);
+  VectorType w = b;
+  // r = b - A x
+  apply_A(x, w);
+  VectorType r = b - w;
+  residual_norm = r.l2_norm();
+  size_t iterations = 0;
+  while (residual_norm > target && iterations < max_iter) {
+    V[0] = r;
+    V[0] *= 1. / residual_norm;
+    std::fill(g.begin(), g.end(), 0.);
+    g[0] = residual_norm;
+    size_t kk = 0;
+    for (size_t jj = 0; jj < restart && iterations < max_iter; ++jj) {
+      apply_P(V[jj], Z[jj]);
+      apply_A(Z[jj], w);
+      ++iterations;
+      // modified Gram-Schmidt
+      for (size_t ii = 0; ii <= jj; ++ii) {
+        H[ii][jj] = w.dot(V[ii]);
+        w.axpy(-H[ii][jj], V[ii]);
+      }
+      H[jj + 1][jj] = w.l2_norm();
+      const bool breakdown = !(H[jj + 1][jj] > 0.);
+      if (!breakdown) {
+        V[jj + 1] = w;
+        V[jj + 1] *= 1. / H[jj + 1][jj];
+      }
+      // apply the previous Givens rotations to the new column of H and compute the next one
+      for (size_t ii = 0; ii < jj; ++ii) {
+        const double tmp = cs[ii] * H[ii][jj] + sn[ii] * H[ii + 1][jj];
+        H[ii + 1][jj] = -sn[ii] * H[ii][jj] + cs[ii] * H[ii + 1][jj];
+        H[ii][jj] = tmp;
+      }
+      const double denominator = std::sqrt(H[jj][jj] * H[jj][jj] + H[jj + 1][jj] * H[jj + 1][jj]);
+      cs[jj] = (denominator > 0.) ? H[jj][jj] / denominator : 1.;
+      sn[jj] = (denominator > 0.) ? H[jj + 1][jj] / denominator : 0.;
+      H[jj][jj] = denominator;
+      H[jj + 1][jj] = 0.;
+      g[jj + 1] = -sn[jj] * g[jj];
+      g[jj] = cs[jj] * g[jj];
+      kk = jj + 1;
+      if (std::abs(g[jj + 1]) <= target || breakdown)
+        break;
+    }
+    // solve the upper triangular least squares system and update x with the preconditioned directions
+    for (size_t ii = kk; ii-- > 0;) {
+      double value = g[ii];
+      for (size_t ll = ii + 1; ll < kk; ++ll)
+        value -= H[ii][ll] * y[ll];
+      y[ii] = (H[ii][ii] != 0.) ? value / H[ii][ii] : 0.;
+    }
+    for (size_t ii = 0; ii < kk; ++ii)
+      x.axpy(y[ii], Z[ii]);
+    // compute the true residual (also for the restart)
+    apply_A(x, w);
+    r = b - w;
+    const double previous_residual_norm = residual_norm;
+    residual_norm = r.l2_norm();
+    if (!(residual_norm < previous_residual_norm))
+      break; // stagnation
+  }
+  return iterations;
+} // ... fgmres(...)
+
+
+} // namespace internal
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TOOLS_FGMRES_HH
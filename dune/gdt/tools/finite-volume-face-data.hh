@@ -0,0 +1,126 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+#ifndef DUNE_GDT_TOOLS_FINITE_VOLUME_FACE_DATA_HH
+#define DUNE_GDT_TOOLS_FINITE_VOLUME_FACE_DATA_HH
+
+#include <vector>
+
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/grid/filters.hh>
+#include <dune/xt/grid/type_traits.hh>
+
+#include <dune/gdt/spaces/mapper/finite-volume.hh>
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief The geometric data required by cell-centered finite volume schemes, stored in flat arrays.
+ *
+ * For each intersection (face) contained in the given filter, the (element) indices of the inside and outside cells,
+ * the unit outer normal (at the center) and the volume are stored, in the order of the grid traversal. The normals are
+ * stored in structure-of-arrays layout, i.e., the dd-th component of the normal of face ff is
+ * normals()[dd * num_faces() + ff], as expected by NumericalFluxInterface::apply_batch. In addition, the inverse
+ * volume of each cell is stored.
+ *
+ * The cell indices are the ones of FiniteVolumeMapper, so the DoFs of a cell kk in a finite volume space with m
+ * components are kk * m, ..., kk * m + m - 1.
+ *
+ * \note The data is only valid as long as the grid does not change.
+ * \note Only faces with an outside cell (inner and periodic ones) are supported.
+ */
+template <class GV>
+class FiniteVolumeFaceData
+{
+  static_assert(XT::Grid::is_view<GV>::value, "");
+
+public:
+  using GridViewType = GV;
+  using D = typename GV::ctype;
+  static constexpr size_t d = GV::dimension;
+
+  FiniteVolumeFaceData(const GridViewType& grid_view, const XT::Grid::IntersectionFilter<GV>& filter)
+  {
+    const FiniteVolumeMapper<GV> element_mapper(grid_view);
+    inverse_cell_volumes_.resize(element_mapper.size());
+    std::vector<std::vector<D>> normal_components(d);
+    for (auto&& element : elements(grid_view)) {
+      const size_t inside_cell = element_mapper.global_index(element, 0);
+      inverse_cell_volumes_[inside_cell] = 1. / element.geometry().volume();
+      for (auto&& intersection : intersections(grid_view, element)) {
+        if (!filter.contains(grid_view, intersection))
+          continue;
+        DUNE_THROW_IF(!intersection.neighbor(),
+                      XT::Common::Exceptions::wrong_input_given,
+                      "Only intersections with an outside element are supported!");
+        inside_cells_.push_back(inside_cell);
+        outside_cells_.push_back(element_mapper.global_index(intersection.outside(), 0));
+        face_volumes_.push_back(intersection.geometry().volume());
+        const auto normal = intersection.centerUnitOuterNormal();
+        for (size_t dd = 0; dd < d; ++dd)
+          normal_components[dd].push_back(normal[dd]);
+      }
+    }
+    normals_.reserve(d * face_volumes_.size());
+    for (size_t dd = 0; dd < d; ++dd)
+      normals_.insert(normals_.end(), normal_components[dd].begin(), normal_components[dd].end());
+  } // FiniteVolumeFaceData(...)
+
+  size_t num_cells() const
+  {
+    return inverse_cell_volumes_.size();
+  }
+
+  size_t num_faces() const
+  {
+    return face_volumes_.size();
+  }
+
+  const std::vector<size_t>& inside_cells() const
+  {
+    return inside_cells_;
+  }
+
+  const std::vector<size_t>& outside_cells() const
+  {
+    return outside_cells_;
+  }
+
+  const std::vector<D>& normals() const
+  {
+    return normals_;
+  }
+
+  const std::vector<D>& face_volumes() const
+  {
+    return face_volumes_;
+  }
+
+  const std::vector<D>& inverse_cell_volumes() const
+  {
+    return inverse_cell_volumes_;
+  }
+
+private:
+  std::vector<size_t> inside_cells_;
+  std::vector<size_t> outside_cells_;
+  std::vector<D> normals_;
+  std::vector<D> face_volumes_;
+  std::vector<D> inverse_cell_volumes_;
+}; // class FiniteVolumeFaceData
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TOOLS_FINITE_VOLUME_FACE_DATA_HH
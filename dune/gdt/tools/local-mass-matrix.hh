@@ -10,13 +10,17 @@
 #ifndef DUNE_GDT_TOOLS_local_mass_matrices_HH
 #define DUNE_GDT_TOOLS_local_mass_matrices_HH
 
+#include <cmath>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
-#include <dune/xt/common/parallel/threadstorage.hh>
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
 #include <dune/xt/la/container/common.hh>
-#include <dune/xt/la/container/conversion.hh>
-#include <dune/xt/la/matrix-inverter.hh>
 #include <dune/xt/grid/functors/interfaces.hh>
 #include <dune/xt/grid/type_traits.hh>
 
@@ -25,30 +29,37 @@
 #include <dune/gdt/local/integrands/product.hh>
 #include <dune/gdt/spaces/interface.hh>
 #include <dune/gdt/spaces/mapper/finite-volume.hh>
+#include <dune/gdt/type_traits.hh>
 
 namespace Dune {
 namespace GDT {
 
 
+/**
+ * \brief Provides the (inverse) local L2 mass matrices of a (discontinuous) space.
+ *
+ * The local mass matrices are stored as their Cholesky factors (packed lower triangular) in one contiguous array,
+ * addressed by the index of the element. For affine elements of Lagrangian or finite volume spaces, the local mass
+ * matrix is the mass matrix of the reference element scaled by the integration element, so only one such reference
+ * block is stored per geometry type, in addition to one scaling factor per element. Only non-affine elements have
+ * their own blocks.
+ *
+ * The storage is (re)allocated in prepare(), i.e. at the beginning of each grid walk (so the provider can be reused
+ * after grid adaptation by walking the grid again), and shared among all thread-local copies during the grid walk,
+ * where each block is computed by the first element requiring it.
+ *
+ * \note Use apply_inverse() to apply the inverse local mass matrix in place. The dense matrices returned by
+ *       local_mass_matrix() and local_mass_matrix_inverse() are only available if requested upon construction (by
+ *       provide_dense_matrices), in which case they are assembled from the factors for each element during the grid
+ *       walk (and thus cost additional memory and time).
+ */
 template <class GV, size_t r = 1, size_t rC = 1, class F = double, class AGV = GV>
-class LocalMassMatrixProvider
-  : public XT::Grid::ElementFunctor<GV>
-  , public XT::Common::ThreadResultPropagator<
-        LocalMassMatrixProvider<GV, r, rC, F>,
-        std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>>,
-        XT::Common::concatenate_container<
-            std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>>>>
+class LocalMassMatrixProvider : public XT::Grid::ElementFunctor<GV>
 {
   static_assert(XT::Grid::is_view<AGV>::value, "");
 
   using ThisType = LocalMassMatrixProvider;
   using BaseType = XT::Grid::ElementFunctor<GV>;
-  using Propagator = XT::Common::ThreadResultPropagator<
-      LocalMassMatrixProvider<GV, r, rC, F>,
-      std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>>,
-      XT::Common::concatenate_container<
-          std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>>>>;
-  friend Propagator;
 
 public:
   using AssemblyGridView = AGV;
@@ -56,87 +67,269 @@ public:
   using typename BaseType::E;
   using typename BaseType::ElementType;
 
-  LocalMassMatrixProvider(const AssemblyGridView& grid_view, const SpaceType& space)
+  LocalMassMatrixProvider(const AssemblyGridView& grid_view,
+                          const SpaceType& space,
+                          const bool provide_dense_matrices = false)
     : BaseType()
-    , Propagator(this)
     , grid_view_(grid_view)
     , space_(space.copy())
     , element_mapper_(grid_view_)
-    , instance_counter_(0)
     , local_basis_(space_->basis().localize())
+    , storage_(std::make_shared<Storage>())
+    , provide_dense_matrices_(provide_dense_matrices)
+    , is_copy_(false)
   {}
 
   LocalMassMatrixProvider(const ThisType& other)
     : BaseType(other)
-    , Propagator(this)
     , grid_view_(other.grid_view_)
     , space_(other.space_->copy())
     , element_mapper_(grid_view_)
-    , instance_counter_(other.instance_counter_ + 1)
     , local_basis_(space_->basis().localize())
+    , storage_(other.storage_)
+    , provide_dense_matrices_(other.provide_dense_matrices_)
+    , is_copy_(true)
   {}
 
+  /// \note Only the original provider (re)allocates the storage, which is shared with all its copies.
+  void prepare() override final
+  {
+    if (!is_copy_)
+      allocate();
+  }
+
   void apply_local(const ElementType& element) override
   {
-    local_basis_->bind(element);
+    auto& storage = *storage_;
     const size_t id = element_mapper_.global_index(element, 0);
-    const LocalElementIntegralBilinearForm<E, r, rC, F, F> local_l2_bilinear_form(
-        LocalProductIntegrand<E, r, F, F>(1.));
-    auto matrix =
-        XT::LA::convert_to<XT::LA::CommonDenseMatrix<F>>(local_l2_bilinear_form.apply2(*local_basis_, *local_basis_));
-    auto inverse = XT::LA::invert_matrix(matrix);
-    local_mass_matrices_.insert(std::make_pair(id, std::make_pair(std::move(matrix), std::move(inverse))));
+    const size_t block_id = storage.element_blocks[id];
+    // the elements sharing a reference block are scaled by the integration element of the first one
+    std::call_once(*storage.computed[block_id], [&]() { this->compute_block(element, block_id); });
+    // each element only writes its own entries, which were allocated in prepare()
+    if (provide_dense_matrices_) {
+      storage.dense_matrices[id] = assemble_local_mass_matrix(id);
+      storage.dense_inverses[id] = assemble_local_mass_matrix_inverse(element);
+    }
   } // ... apply_local(...)
 
   BaseType* copy() override final
   {
-    return Propagator::copy_imp();
+    return new ThisType(*this);
   }
 
-  void finalize() override final
+  /// \brief Computes A^{-1} vector in place, where A denotes the local mass matrix of the element.
+  template <class V>
+  void apply_inverse(const ElementType& element, V& vector) const
   {
-    this->finalize_imp();
-  }
+    const size_t id = element_mapper_.global_index(element, 0);
+    const auto& block = checked_block(id);
+    DUNE_THROW_IF(vector.size() != block.size,
+                  XT::Common::Exceptions::shapes_do_not_match,
+                  "vector.size() = " << vector.size() << "\n   block.size = " << block.size);
+    const auto* L = storage_->factors.data() + block.offset;
+    const size_t n = block.size;
+    // forward substitution, L y = vector
+    for (size_t ii = 0; ii < n; ++ii) {
+      const auto* row = L + packed_index(ii, 0);
+      F value = vector[ii];
+      for (size_t jj = 0; jj < ii; ++jj)
+        value -= row[jj] * vector[jj];
+      vector[ii] = value / row[ii];
+    }
+    // backward substitution, L^T x = y
+    for (size_t ii = n; ii-- > 0;) {
+      F value = vector[ii];
+      for (size_t jj = ii + 1; jj < n; ++jj)
+        value -= L[packed_index(jj, ii)] * vector[jj];
+      vector[ii] = value / L[packed_index(ii, ii)];
+    }
+    const F scale = storage_->element_scales[id];
+    if (scale != F(1))
+      for (size_t ii = 0; ii < n; ++ii)
+        vector[ii] /= scale;
+  } // ... apply_inverse(...)
 
-  /**
-   * \note This is only used to merge the thread-local results after the grid walk, you are probably interested in
-   *       local_mass_matrix() and local_mass_matrix_inverse().
-   */
-  std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>> result() const
+  /// \note Requires provide_dense_matrices to be set upon construction.
+  const XT::LA::CommonDenseMatrix<F>& local_mass_matrix(const ElementType& element) const
   {
-    return local_mass_matrices_;
+    const size_t id = element_mapper_.global_index(element, 0);
+    check_dense_matrices(id);
+    return storage_->dense_matrices[id];
   }
 
-  void set_result(std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>> res)
+  /// \note Requires provide_dense_matrices to be set upon construction.
+  const XT::LA::CommonDenseMatrix<F>& local_mass_matrix_inverse(const ElementType& element) const
   {
-    local_mass_matrices_ = res;
+    const size_t id = element_mapper_.global_index(element, 0);
+    check_dense_matrices(id);
+    return storage_->dense_inverses[id];
   }
 
-  const XT::LA::CommonDenseMatrix<F>& local_mass_matrix(const ElementType& element) const
+private:
+  struct Block
+  {
+    size_t offset;
+    size_t size;
+  };
+
+  struct Storage
+  {
+    std::vector<size_t> element_blocks;
+    std::vector<F> element_scales;
+    std::vector<Block> blocks;
+    std::vector<std::unique_ptr<std::once_flag>> computed;
+    std::vector<char> valid;
+    std::vector<F> factors;
+    // only filled if provide_dense_matrices is set, indexed by the element
+    std::vector<XT::LA::CommonDenseMatrix<F>> dense_matrices;
+    std::vector<XT::LA::CommonDenseMatrix<F>> dense_inverses;
+  };
+
+  XT::LA::CommonDenseMatrix<F> assemble_local_mass_matrix(const size_t id) const
+  {
+    const auto& block = checked_block(id);
+    const auto* L = storage_->factors.data() + block.offset;
+    const F scale = storage_->element_scales[id];
+    XT::LA::CommonDenseMatrix<F> matrix(block.size, block.size, 0.);
+    for (size_t ii = 0; ii < block.size; ++ii)
+      for (size_t jj = 0; jj <= ii; ++jj) {
+        F value = 0;
+        for (size_t kk = 0; kk <= jj; ++kk)
+          value += L[packed_index(ii, kk)] * L[packed_index(jj, kk)];
+        matrix.set_entry(ii, jj, scale * value);
+        matrix.set_entry(jj, ii, scale * value);
+      }
+    return matrix;
+  } // ... assemble_local_mass_matrix(...)
+
+  XT::LA::CommonDenseMatrix<F> assemble_local_mass_matrix_inverse(const ElementType& element) const
   {
     const size_t id = element_mapper_.global_index(element, 0);
-    DUNE_THROW_IF(local_mass_matrices_.count(id) == 0,
-                  XT::Common::Exceptions::this_should_not_happen,
-                  "Missing local mass matrix for id " << id << "!");
-    return local_mass_matrices_.at(id).first;
+    const size_t n = checked_block(id).size;
+    XT::LA::CommonDenseMatrix<F> inverse(n, n, 0.);
+    DynamicVector<F> column(n, 0.);
+    for (size_t jj = 0; jj < n; ++jj) {
+      column *= 0.;
+      column[jj] = 1.;
+      apply_inverse(element, column);
+      for (size_t ii = 0; ii < n; ++ii)
+        inverse.set_entry(ii, jj, column[ii]);
+    }
+    return inverse;
+  } // ... assemble_local_mass_matrix_inverse(...)
+
+  static size_t packed_index(const size_t ii, const size_t jj)
+  {
+    return (ii * (ii + 1)) / 2 + jj;
   }
 
-  const XT::LA::CommonDenseMatrix<F>& local_mass_matrix_inverse(const ElementType& element) const
+  bool uses_reference_blocks() const
   {
-    const size_t id = element_mapper_.global_index(element, 0);
-    DUNE_THROW_IF(local_mass_matrices_.count(id) == 0,
+    // the basis functions of these spaces are not transformed, so their mass matrix scales with the volume
+    return space_->is_lagrangian() || space_->type() == GDT::SpaceType::finite_volume;
+  }
+
+  void allocate()
+  {
+    auto& storage = *storage_;
+    const size_t num_elements = element_mapper_.size();
+    storage.element_blocks.assign(num_elements, std::numeric_limits<size_t>::max());
+    storage.element_scales.assign(num_elements, F(1));
+    storage.blocks.clear();
+    storage.dense_matrices.clear();
+    storage.dense_inverses.clear();
+    if (provide_dense_matrices_) {
+      storage.dense_matrices.resize(num_elements);
+      storage.dense_inverses.resize(num_elements);
+    }
+    const bool use_reference_blocks = uses_reference_blocks();
+    std::vector<std::pair<GeometryType, size_t>> reference_blocks;
+    size_t num_factors = 0;
+    auto add_block = [&](const size_t size) {
+      storage.blocks.push_back({num_factors, size});
+      num_factors += (size * (size + 1)) / 2;
+      return storage.blocks.size() - 1;
+    };
+    for (auto&& element : elements(grid_view_)) {
+      const size_t id = element_mapper_.global_index(element, 0);
+      const auto geometry = element.geometry();
+      local_basis_->bind(element);
+      if (use_reference_blocks && geometry.affine()) {
+        const auto gt = element.type();
+        size_t block_id = std::numeric_limits<size_t>::max();
+        for (const auto& reference_block : reference_blocks)
+          if (reference_block.first == gt)
+            block_id = reference_block.second;
+        if (block_id == std::numeric_limits<size_t>::max()) {
+          block_id = add_block(local_basis_->size());
+          reference_blocks.emplace_back(gt, block_id);
+        }
+        storage.element_blocks[id] = block_id;
+        storage.element_scales[id] = geometry.integrationElement(geometry.local(geometry.center()));
+      } else
+        storage.element_blocks[id] = add_block(local_basis_->size());
+    }
+    storage.computed.resize(storage.blocks.size());
+    for (auto& flag : storage.computed)
+      flag = std::make_unique<std::once_flag>();
+    storage.valid.assign(storage.blocks.size(), 0);
+    storage.factors.assign(num_factors, F(0));
+  } // ... allocate(...)
+
+  void compute_block(const ElementType& element, const size_t block_id)
+  {
+    auto& storage = *storage_;
+    const auto& block = storage.blocks[block_id];
+    local_basis_->bind(element);
+    DUNE_THROW_IF(local_basis_->size() != block.size,
+                  Exceptions::basis_error,
+                  "local_basis_->size() = " << local_basis_->size() << "\n   block.size = " << block.size);
+    const LocalElementIntegralBilinearForm<E, r, rC, F, F> local_l2_bilinear_form(
+        LocalProductIntegrand<E, r, F, F>(1.));
+    const auto matrix = local_l2_bilinear_form.apply2(*local_basis_, *local_basis_);
+    const F scale = storage.element_scales[element_mapper_.global_index(element, 0)];
+    // Cholesky factorization of matrix / scale
+    auto* L = storage.factors.data() + block.offset;
+    for (size_t ii = 0; ii < block.size; ++ii)
+      for (size_t jj = 0; jj <= ii; ++jj) {
+        F value = matrix[ii][jj] / scale;
+        for (size_t kk = 0; kk < jj; ++kk)
+          value -= L[packed_index(ii, kk)] * L[packed_index(jj, kk)];
+        if (ii == jj) {
+          DUNE_THROW_IF(!(value > 0),
+                        XT::Common::Exceptions::this_should_not_happen,
+                        "Local mass matrix is not positive definite (pivot " << ii << " is " << value << ")!");
+          L[packed_index(ii, ii)] = std::sqrt(value);
+        } else
+          L[packed_index(ii, jj)] = value / L[packed_index(jj, jj)];
+      }
+    storage.valid[block_id] = 1;
+  } // ... compute_block(...)
+
+  const Block& checked_block(const size_t id) const
+  {
+    const auto& storage = *storage_;
+    DUNE_THROW_IF(id >= storage.element_blocks.size() || !storage.valid[storage.element_blocks[id]],
                   XT::Common::Exceptions::this_should_not_happen,
                   "Missing local mass matrix for id " << id << "!");
-    return local_mass_matrices_.at(id).second;
+    return storage.blocks[storage.element_blocks[id]];
+  }
+
+  void check_dense_matrices(const size_t id) const
+  {
+    DUNE_THROW_IF(!provide_dense_matrices_,
+                  XT::Common::Exceptions::you_are_using_this_wrong,
+                  "The dense local mass matrices are only available if provide_dense_matrices is set!");
+    checked_block(id);
   }
 
-private:
   const AssemblyGridView grid_view_;
   std::unique_ptr<const SpaceType> space_;
   const FiniteVolumeMapper<GV> element_mapper_;
-  size_t instance_counter_;
   std::unique_ptr<typename SpaceType::GlobalBasisType::LocalizedType> local_basis_;
-  std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>> local_mass_matrices_;
+  std::shared_ptr<Storage> storage_;
+  const bool provide_dense_matrices_;
+  const bool is_copy_;
 }; // class LocalMassMatrixProvider
 
 
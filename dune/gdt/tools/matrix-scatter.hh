@@ -0,0 +1,442 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+#ifndef DUNE_GDT_TOOLS_MATRIX_SCATTER_HH
+#define DUNE_GDT_TOOLS_MATRIX_SCATTER_HH
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <dune/common/dynvector.hh>
+
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/la/container/matrix-interface.hh>
+#include <dune/xt/la/type_traits.hh>
+#include <dune/xt/grid/type_traits.hh>
+
+#include <dune/gdt/exceptions.hh>
+#include <dune/gdt/spaces/mapper/interfaces.hh>
+
+namespace Dune {
+namespace GDT {
+namespace internal {
+
+
+/**
+ * \brief Whether several threads may write into the same matrix, see XT::Common::threadManager().
+ *
+ * If so, all entries are added by add_to_entry() of the matrix, so that all writers share the locks of the matrix.
+ * Otherwise, the entries may be written directly (without locking), see LocalMatrixScatterHelper.
+ */
+inline bool concurrent_matrix_writes()
+{
+  return XT::Common::threadManager().max_threads() > 1;
+}
+
+
+/**
+ * \brief Adds a local matrix entry by entry, works for any matrix.
+ */
+template <class M>
+struct LocalMatrixScatterHelper
+{
+  static const constexpr bool has_positions = false;
+
+  template <class RowIndicesType, class ColumnIndicesType, class LocalMatrixType>
+  static void add(M& matrix,
+                  const RowIndicesType& global_rows,
+                  const size_t num_rows,
+                  const ColumnIndicesType& global_cols,
+                  const size_t num_cols,
+                  const LocalMatrixType& local_matrix,
+                  const typename M::ScalarType& scaling,
+                  std::vector<std::pair<size_t, size_t>>& /*sorted_columns*/)
+  {
+    for (size_t ii = 0; ii < num_rows; ++ii)
+      for (size_t jj = 0; jj < num_cols; ++jj)
+        matrix.add_to_entry(global_rows[ii], global_cols[jj], scaling * local_matrix[ii][jj]);
+  }
+
+  static void add_to_entry(M& matrix, const size_t ii, const size_t jj, const typename M::ScalarType& value)
+  {
+    matrix.add_to_entry(ii, jj, value);
+  }
+
+  /**
+   * \brief The positions of the entries are unknown, so no block can be cached.
+   */
+  template <class RowIndicesType, class ColumnIndicesType>
+  static bool append_positions(M& /*matrix*/,
+                               const RowIndicesType& /*global_rows*/,
+                               const size_t /*num_rows*/,
+                               const ColumnIndicesType& /*global_cols*/,
+                               const size_t /*num_cols*/,
+                               std::vector<std::pair<size_t, size_t>>& /*sorted_columns*/,
+                               std::vector<size_t>& /*positions*/)
+  {
+    return false;
+  }
+}; // struct LocalMatrixScatterHelper
+
+
+#if HAVE_DUNE_ISTL
+
+/**
+ * \brief Adds a local matrix row by row, resolving the positions of all columns of a row in one pass over the CSR row.
+ */
+template <class S>
+struct LocalMatrixScatterHelper<XT::LA::IstlRowMajorSparseMatrix<S>>
+{
+  using M = XT::LA::IstlRowMajorSparseMatrix<S>;
+
+  static const constexpr bool has_positions = true;
+
+  template <class RowIndicesType, class ColumnIndicesType, class LocalMatrixType>
+  static void add(M& matrix,
+                  const RowIndicesType& global_rows,
+                  const size_t num_rows,
+                  const ColumnIndicesType& global_cols,
+                  const size_t num_cols,
+                  const LocalMatrixType& local_matrix,
+                  const S& scaling,
+                  std::vector<std::pair<size_t, size_t>>& sorted_columns)
+  {
+    if (num_rows == 0 || num_cols == 0)
+      return;
+    if (concurrent_matrix_writes()) {
+      for (size_t ii = 0; ii < num_rows; ++ii)
+        for (size_t jj = 0; jj < num_cols; ++jj)
+          matrix.add_to_entry(global_rows[ii], global_cols[jj], scaling * local_matrix[ii][jj]);
+      return;
+    }
+    // sort the columns by their global index once, so that each row can be merged with the CSR row in one sweep
+    sorted_columns.resize(num_cols);
+    for (size_t jj = 0; jj < num_cols; ++jj)
+      sorted_columns[jj] = {global_cols[jj], jj};
+    std::sort(sorted_columns.begin(), sorted_columns.end());
+    auto& backend = matrix.backend();
+    for (size_t ii = 0; ii < num_rows; ++ii) {
+      const size_t global_ii = global_rows[ii];
+      auto& row = backend[global_ii];
+      const auto row_end = row.end();
+      const auto& local_row = local_matrix[ii];
+      auto it = row.find(sorted_columns[0].first);
+      for (const auto& global_and_local_jj : sorted_columns) {
+        while (it != row_end && it.index() < global_and_local_jj.first)
+          ++it;
+        DUNE_THROW_IF(it == row_end || it.index() != global_and_local_jj.first,
+                      Exceptions::assembler_error,
+                      "entry (" << global_ii << ", " << global_and_local_jj.first
+                                << ") is not contained in the sparsity pattern of the matrix!");
+        (*it)[0][0] += scaling * local_row[global_and_local_jj.second];
+      }
+    }
+  } // ... add(...)
+
+  /**
+   * \brief Appends the positions of all entries of the local block (row major) to positions, relative to the first
+   *        entry of the matrix.
+   *
+   * Returns false (and leaves positions untouched) if the block is not fully contained in the sparsity pattern.
+   */
+  template <class RowIndicesType, class ColumnIndicesType>
+  static bool append_positions(M& matrix,
+                               const RowIndicesType& global_rows,
+                               const size_t num_rows,
+                               const ColumnIndicesType& global_cols,
+                               const size_t num_cols,
+                               std::vector<std::pair<size_t, size_t>>& sorted_columns,
+                               std::vector<size_t>& positions)
+  {
+    const size_t offset = positions.size();
+    positions.resize(offset + num_rows * num_cols);
+    if (num_rows == 0 || num_cols == 0)
+      return true;
+    sorted_columns.resize(num_cols);
+    for (size_t jj = 0; jj < num_cols; ++jj)
+      sorted_columns[jj] = {global_cols[jj], jj};
+    std::sort(sorted_columns.begin(), sorted_columns.end());
+    auto& backend = matrix.backend();
+    const auto* first_entry = backend[0].getptr();
+    for (size_t ii = 0; ii < num_rows; ++ii) {
+      const size_t global_ii = global_rows[ii];
+      auto& row = backend[global_ii];
+      const auto row_end = row.end();
+      auto it = row.find(sorted_columns[0].first);
+      for (const auto& global_and_local_jj : sorted_columns) {
+        while (it != row_end && it.index() < global_and_local_jj.first)
+          ++it;
+        if (it == row_end || it.index() != global_and_local_jj.first) {
+          positions.resize(offset);
+          return false;
+        }
+        positions[offset + ii * num_cols + global_and_local_jj.second] = static_cast<size_t>(&(*it) - first_entry);
+      }
+    }
+    return true;
+  } // ... append_positions(...)
+
+  template <class LocalMatrixType>
+  static void add(M& matrix,
+                  const size_t num_rows,
+                  const size_t* positions,
+                  const size_t num_cols,
+                  const LocalMatrixType& local_matrix,
+                  const S& scaling)
+  {
+    if (num_rows == 0 || num_cols == 0)
+      return;
+    auto* first_entry = matrix.backend()[0].getptr();
+    for (size_t ii = 0; ii < num_rows; ++ii) {
+      const auto& local_row = local_matrix[ii];
+      const size_t* row_positions = positions + ii * num_cols;
+      for (size_t jj = 0; jj < num_cols; ++jj)
+        first_entry[row_positions[jj]][0][0] += scaling * local_row[jj];
+    }
+  } // ... add(...)
+
+  static void add_to_entry(M& matrix, const size_t ii, const size_t jj, const S& value)
+  {
+    if (concurrent_matrix_writes()) {
+      matrix.add_to_entry(ii, jj, value);
+      return;
+    }
+    auto& row = matrix.backend()[ii];
+    const auto it = row.find(jj);
+    DUNE_THROW_IF(it == row.end(),
+                  Exceptions::assembler_error,
+                  "entry (" << ii << ", " << jj << ") is not contained in the sparsity pattern of the matrix!");
+    (*it)[0][0] += value;
+  }
+}; // struct LocalMatrixScatterHelper<IstlRowMajorSparseMatrix>
+
+#endif // HAVE_DUNE_ISTL
+
+
+} // namespace internal
+
+
+/**
+ * \brief Adds (scaled) local matrices into a global matrix, given the global row and column indices.
+ *
+ * For matrices with a known CSR layout (currently XT::LA::IstlRowMajorSparseMatrix), all positions of a row of the
+ * local matrix are resolved in a single pass over the corresponding row of the global matrix, instead of one sparse
+ * lookup per entry. For all other matrices we fall back to add_to_entry().
+ *
+ * \note Holds a buffer, one instance per thread is required.
+ * \note The row-wise scatter writes into the matrix without locking and is thus only used if a single thread is
+ *       available (see XT::Common::threadManager()). Otherwise, all entries are added by add_to_entry() of the matrix,
+ *       so that concurrent scatters share the locks of the matrix with all other writers.
+ */
+template <class M>
+class LocalMatrixScatter
+{
+  static_assert(XT::LA::is_matrix<M>::value, "");
+
+public:
+  using MatrixType = M;
+  using FieldType = typename MatrixType::ScalarType;
+
+  LocalMatrixScatter(MatrixType& matrix)
+    : matrix_(matrix)
+  {}
+
+  LocalMatrixScatter(const LocalMatrixScatter& other)
+    : matrix_(other.matrix_)
+  {}
+
+  template <class RowIndicesType, class ColumnIndicesType, class LocalMatrixType>
+  void add(const RowIndicesType& global_rows,
+           const size_t num_rows,
+           const ColumnIndicesType& global_cols,
+           const size_t num_cols,
+           const LocalMatrixType& local_matrix,
+           const FieldType& scaling = 1.)
+  {
+    internal::LocalMatrixScatterHelper<M>::add(
+        matrix_, global_rows, num_rows, global_cols, num_cols, local_matrix, scaling, sorted_columns_);
+  }
+
+  /**
+   * \brief Adds value to the (existing) entry (ii, jj), using the same locks as add().
+   */
+  void add_to_entry(const size_t ii, const size_t jj, const FieldType& value)
+  {
+    internal::LocalMatrixScatterHelper<M>::add_to_entry(matrix_, ii, jj, value);
+  }
+
+  /**
+   * \brief Variant for positions obtained from a LocalMatrixPositionCache, which is only valid for a single thread.
+   */
+  template <class LocalMatrixType>
+  void add(const size_t num_rows,
+           const size_t* positions,
+           const size_t num_cols,
+           const LocalMatrixType& local_matrix,
+           const FieldType& scaling = 1.)
+  {
+    DUNE_THROW_IF(internal::concurrent_matrix_writes(),
+                  Exceptions::assembler_error,
+                  "Cached positions must not be used if several threads may write into the matrix!");
+    if constexpr (internal::LocalMatrixScatterHelper<M>::has_positions)
+      internal::LocalMatrixScatterHelper<M>::add(matrix_, num_rows, positions, num_cols, local_matrix, scaling);
+    else
+      DUNE_THROW(Exceptions::assembler_error, "This matrix does not support cached positions!");
+  }
+
+private:
+  MatrixType& matrix_;
+  std::vector<std::pair<size_t, size_t>> sorted_columns_;
+}; // class LocalMatrixScatter
+
+
+/**
+ * \brief Caches the positions of the local blocks of a matrix, for each element and each pair of neighboring elements.
+ *
+ * Only blocks which are fully contained in the sparsity pattern of the matrix are cached (e.g., only the element
+ * blocks for a pattern of Stencil::element), positions() returns nullptr for all others and the assemblers fall back
+ * to LocalMatrixScatter for these.
+ *
+ * Once built, repeated assemblies into the same matrix (with the same sparsity pattern) reduce to indexed adds, see
+ * LocalMatrixScatter. The cache is only valid as long as the mappers it was built with are not adapted, which we
+ * detect by their adaptation_count(). For matrices without a known CSR layout or if several threads may write into the
+ * matrix (the indexed adds do not lock), the cache is never valid.
+ *
+ * \note Rows are given by the test mapper, columns by the ansatz mapper, elements are taken from the grid view.
+ */
+template <class M, class GV, class TGV = GV, class AGV = GV>
+class LocalMatrixPositionCache
+{
+  static_assert(XT::LA::is_matrix<M>::value, "");
+  static_assert(XT::Grid::is_view<GV>::value, "");
+
+  using Helper = internal::LocalMatrixScatterHelper<M>;
+
+public:
+  using MatrixType = M;
+  using GridViewType = GV;
+  using ElementType = XT::Grid::extract_entity_t<GV>;
+  using TestMapperType = MapperInterface<TGV>;
+  using AnsatzMapperType = MapperInterface<AGV>;
+
+  LocalMatrixPositionCache(const GridViewType& grid_view)
+    : grid_view_(grid_view)
+    , test_mapper_(nullptr)
+    , ansatz_mapper_(nullptr)
+    , test_adaptation_count_(0)
+    , ansatz_adaptation_count_(0)
+  {}
+
+  bool valid() const
+  {
+    return Helper::has_positions && !internal::concurrent_matrix_writes() && test_mapper_ && ansatz_mapper_
+           && test_mapper_->adaptation_count() == test_adaptation_count_
+           && ansatz_mapper_->adaptation_count() == ansatz_adaptation_count_;
+  }
+
+  void invalidate()
+  {
+    test_mapper_ = nullptr;
+    ansatz_mapper_ = nullptr;
+  }
+
+  /**
+   * \brief (Re)builds the cache, if required.
+   */
+  void update(MatrixType& matrix, const TestMapperType& test_mapper, const AnsatzMapperType& ansatz_mapper)
+  {
+    if (!Helper::has_positions || internal::concurrent_matrix_writes()
+        || (valid() && &test_mapper == test_mapper_ && &ansatz_mapper == ansatz_mapper_))
+      return;
+    this->invalidate();
+    const auto& index_set = grid_view_.indexSet();
+    block_ranges_.assign(index_set.size(0), {0, 0});
+    blocks_.clear();
+    positions_.clear();
+    std::vector<std::pair<size_t, size_t>> sorted_columns;
+    DynamicVector<size_t> global_rows(test_mapper.max_local_size(), 0);
+    DynamicVector<size_t> global_cols(ansatz_mapper.max_local_size(), 0);
+    std::vector<std::pair<size_t, ElementType>> neighbors;
+    for (auto&& element : elements(grid_view_)) {
+      const size_t element_index = index_set.index(element);
+      test_mapper.global_indices(element, global_rows);
+      const size_t num_rows = test_mapper.local_size(element);
+      // the element itself comes first, ...
+      neighbors.clear();
+      neighbors.emplace_back(element_index, element);
+      // ... followed by its neighbors
+      for (auto&& intersection : intersections(grid_view_, element)) {
+        if (intersection.neighbor()) {
+          const auto neighbor = intersection.outside();
+          const size_t neighbor_index = index_set.index(neighbor);
+          bool known = false;
+          for (const auto& index_and_element : neighbors)
+            known = known || (index_and_element.first == neighbor_index);
+          if (!known)
+            neighbors.emplace_back(neighbor_index, neighbor);
+        }
+      }
+      block_ranges_[element_index].first = blocks_.size();
+      for (const auto& index_and_element : neighbors) {
+        ansatz_mapper.global_indices(index_and_element.second, global_cols);
+        const size_t offset = positions_.size();
+        if (Helper::append_positions(matrix,
+                                     global_rows,
+                                     num_rows,
+                                     global_cols,
+                                     ansatz_mapper.local_size(index_and_element.second),
+                                     sorted_columns,
+                                     positions_))
+          blocks_.emplace_back(index_and_element.first, offset);
+      }
+      block_ranges_[element_index].second = blocks_.size();
+    }
+    test_mapper_ = &test_mapper;
+    ansatz_mapper_ = &ansatz_mapper;
+    test_adaptation_count_ = test_mapper.adaptation_count();
+    ansatz_adaptation_count_ = ansatz_mapper.adaptation_count();
+  } // ... update(...)
+
+  /**
+   * \brief Returns the positions of the block with rows of test_element and columns of ansatz_element, nullptr if the
+   *        cache is not valid or does not contain this block.
+   */
+  const size_t* positions(const ElementType& test_element, const ElementType& ansatz_element) const
+  {
+    if (!this->valid())
+      return nullptr;
+    const auto& index_set = grid_view_.indexSet();
+    const auto& block_range = block_ranges_[index_set.index(test_element)];
+    const size_t ansatz_index = index_set.index(ansatz_element);
+    for (size_t bb = block_range.first; bb < block_range.second; ++bb)
+      if (blocks_[bb].first == ansatz_index)
+        return positions_.data() + blocks_[bb].second;
+    return nullptr;
+  } // ... positions(...)
+
+private:
+  const GridViewType grid_view_;
+  const TestMapperType* test_mapper_;
+  const AnsatzMapperType* ansatz_mapper_;
+  size_t test_adaptation_count_;
+  size_t ansatz_adaptation_count_;
+  std::vector<std::pair<size_t, size_t>> block_ranges_;
+  std::vector<std::pair<size_t, size_t>> blocks_;
+  std::vector<size_t> positions_;
+}; // class LocalMatrixPositionCache
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TOOLS_MATRIX_SCATTER_HH
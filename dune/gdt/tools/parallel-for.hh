@@ -0,0 +1,78 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+#ifndef DUNE_GDT_TOOLS_PARALLEL_FOR_HH
+#define DUNE_GDT_TOOLS_PARALLEL_FOR_HH
+
+#include <cstddef>
+
+#include <dune/xt/la/type_traits.hh>
+
+#if HAVE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief Calls chunk_functor(first, last) for disjoint chunks [first, last) covering [begin, end).
+ *
+ * If use_tbb is true and TBB is available, the chunks are processed concurrently (the number of threads is determined
+ * by TBB, see XT::Common::threadManager()), otherwise chunk_functor(begin, end) is called once.
+ *
+ * \note chunk_functor must be safe to be called concurrently for disjoint chunks.
+ */
+template <class ChunkFunctor>
+void parallel_for_chunks(const size_t begin,
+                         const size_t end,
+                         ChunkFunctor&& chunk_functor,
+                         [[maybe_unused]] const bool use_tbb = true)
+{
+  if (end <= begin)
+    return;
+#if HAVE_TBB
+  if (use_tbb) {
+    tbb::parallel_for(tbb::blocked_range<size_t>(begin, end), [&](const tbb::blocked_range<size_t>& range) {
+      chunk_functor(range.begin(), range.end());
+    });
+    return;
+  }
+#endif
+  chunk_functor(begin, end);
+} // ... parallel_for_chunks(...)
+
+
+/**
+ * \brief Makes sure that container (a vector or a matrix) does not share its data with another container, before its
+ *        entries are written to concurrently (e.g., within parallel_for_chunks or a parallel grid walk).
+ *
+ * The XT::LA containers share their data upon copy and only copy it upon the first write access (copy on write). If
+ * this first write access happens concurrently from several threads (e.g., via operator[] or backend()), each thread
+ * may trigger a copy of the data. Writing a single entry of a vector (or accessing the backend of a matrix) once
+ * beforehand triggers the copy (if any) serially.
+ *
+ * \note Does nothing for an empty vector.
+ */
+template <class ContainerType>
+void ensure_unshared_data(ContainerType& container)
+{
+  if constexpr (XT::LA::is_matrix<ContainerType>::value) {
+    container.backend();
+  } else if (container.size() > 0)
+    container.set_entry(0, container.get_entry(0));
+}
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TOOLS_PARALLEL_FOR_HH
@@ -11,42 +11,144 @@
 #ifndef DUNE_GDT_TOOLS_SPARSITY_PATTERN_HH
 #define DUNE_GDT_TOOLS_SPARSITY_PATTERN_HH
 
+#include <algorithm>
+#include <array>
+#include <mutex>
+
 #include <dune/common/dynvector.hh>
 
 #include <dune/grid/common/gridview.hh>
 #include <dune/grid/common/rangegenerators.hh>
 
 #include <dune/xt/la/container/pattern.hh>
+#include <dune/xt/grid/walker.hh>
 
 #include <dune/gdt/exceptions.hh>
 #include <dune/gdt/spaces/interface.hh>
+#include <dune/gdt/tools/parallel-for.hh>
 #include <dune/gdt/type_traits.hh>
 
 namespace Dune {
 namespace GDT {
 
 
+namespace internal {
+
+
+/**
+ * \brief Striped row locks, used to insert into the rows of a pattern concurrently.
+ */
+inline std::mutex& sparsity_pattern_row_mutex(const size_t row)
+{
+  static std::array<std::mutex, 512> mutexes;
+  return mutexes[row % mutexes.size()];
+}
+
+
+/**
+ * \brief Computes an element and/or coupling sparsity pattern, optionally thread parallel.
+ *
+ * If use_tbb is true, each (thread local) element appends the columns of its local blocks to the respective rows
+ * without looking for duplicates (which would require to hold the row lock longer), the rows are allocated on first
+ * use (with a size estimated from max_local_size() and the number of faces of the element). Duplicates are removed in
+ * a final (thread parallel) pass over all rows, which also sorts them. Otherwise, duplicates are skipped upon insertion
+ * (as in XT::LA::SparsityPatternDefault::insert()), to keep the memory footprint small (e.g., for continuous spaces,
+ * where each row is touched by many elements).
+ */
+template <class TGV, size_t t_r, size_t t_rC, class TR, class AGV, size_t a_r, size_t a_rC, class AR, class GV>
+XT::LA::SparsityPatternDefault make_sparsity_pattern(const SpaceInterface<TGV, t_r, t_rC, TR>& test_space,
+                                                     const SpaceInterface<AGV, a_r, a_rC, AR>& ansatz_space,
+                                                     const GV& grid_view,
+                                                     const bool element_stencil,
+                                                     const bool intersection_stencil,
+                                                     const bool use_tbb)
+{
+  XT::LA::SparsityPatternDefault pattern(test_space.mapper().size());
+  const auto add_columns = [&](const DynamicVector<size_t>& row_indices,
+                               const size_t num_rows,
+                               const DynamicVector<size_t>& column_indices,
+                               const size_t num_cols,
+                               const size_t row_size_hint) {
+    for (size_t ii = 0; ii < num_rows; ++ii) {
+      if (use_tbb) {
+        [[maybe_unused]] std::lock_guard<std::mutex> guard(sparsity_pattern_row_mutex(row_indices[ii]));
+        auto& row = pattern.inner(row_indices[ii]);
+        if (row.capacity() == 0)
+          row.reserve(row_size_hint);
+        for (size_t jj = 0; jj < num_cols; ++jj)
+          row.push_back(column_indices[jj]);
+      } else {
+        for (size_t jj = 0; jj < num_cols; ++jj)
+          pattern.insert(row_indices[ii], column_indices[jj]);
+      }
+    }
+  };
+  auto walker = XT::Grid::make_walker(grid_view);
+  walker.append([]() {},
+                [&](const auto& element) {
+                  thread_local DynamicVector<size_t> row_indices;
+                  thread_local DynamicVector<size_t> column_indices;
+                  test_space.mapper().global_indices(element, row_indices);
+                  const size_t num_rows = test_space.mapper().local_size(element);
+                  // the element itself and its neighbors
+                  const size_t row_size_hint =
+                      ansatz_space.mapper().max_local_size()
+                      * ((element_stencil ? 1 : 0) + (intersection_stencil ? element.subEntities(1) : 0));
+                  if (element_stencil) {
+                    ansatz_space.mapper().global_indices(element, column_indices);
+                    add_columns(row_indices,
+                                num_rows,
+                                column_indices,
+                                ansatz_space.mapper().local_size(element),
+                                row_size_hint);
+                  }
+                  if (intersection_stencil) {
+                    for (auto&& intersection : intersections(grid_view, element)) {
+                      if (intersection.neighbor()) {
+                        const auto neighbour = intersection.outside();
+                        ansatz_space.mapper().global_indices(neighbour, column_indices);
+                        add_columns(row_indices,
+                                    num_rows,
+                                    column_indices,
+                                    ansatz_space.mapper().local_size(neighbour),
+                                    row_size_hint);
+                      }
+                    }
+                  }
+                },
+                []() {});
+  walker.walk(use_tbb);
+  // sort and remove duplicates (if any), the rows are independent
+  parallel_for_chunks(0,
+                      pattern.size(),
+                      [&](const size_t first, const size_t last) {
+                        for (size_t ii = first; ii < last; ++ii) {
+                          auto& row = pattern.inner(ii);
+                          std::sort(row.begin(), row.end());
+                          row.erase(std::unique(row.begin(), row.end()), row.end());
+                        }
+                      },
+                      use_tbb);
+  return pattern;
+} // ... make_sparsity_pattern(...)
+
+
+} // namespace internal
+
+
 /**
  *  \brief Computes an element sparsity pattern, where the test space determines the rows (outer) and the ansatz space
  *         determines the columns (inner).
+ *
+ * \note Set use_tbb to compute the pattern thread parallel.
  */
 template <class TGV, size_t t_r, size_t t_rC, class TR, class AGV, size_t a_r, size_t a_rC, class AR, class GV>
 XT::LA::SparsityPatternDefault make_element_sparsity_pattern(const SpaceInterface<TGV, t_r, t_rC, TR>& test_space,
                                                              const SpaceInterface<AGV, a_r, a_rC, AR>& ansatz_space,
-                                                             const GV& grid_view)
+                                                             const GV& grid_view,
+                                                             const bool use_tbb = false)
 {
-  XT::LA::SparsityPatternDefault pattern(test_space.mapper().size());
-  DynamicVector<size_t> row_indices(test_space.mapper().max_local_size(), 0);
-  DynamicVector<size_t> column_indices(ansatz_space.mapper().max_local_size(), 0);
-  for (auto&& element : elements(grid_view)) {
-    test_space.mapper().global_indices(element, row_indices);
-    ansatz_space.mapper().global_indices(element, column_indices);
-    for (size_t ii = 0; ii < test_space.mapper().local_size(element); ++ii)
-      for (size_t jj = 0; jj < ansatz_space.mapper().local_size(element); ++jj)
-        pattern.insert(row_indices[ii], column_indices[jj]);
-  }
-  pattern.sort();
-  return pattern;
+  return internal::make_sparsity_pattern(test_space, ansatz_space, grid_view, true, false, use_tbb);
 } // ... make_element_sparsity_pattern(...)
 
 
@@ -68,30 +170,17 @@ XT::LA::SparsityPatternDefault make_element_sparsity_pattern(const SpaceInterfac
 /**
  *  \brief Computes a coupling sparsity pattern, where the test space determines the rows (outer) and the ansatz space
  *         determines the columns (inner).
+ *
+ * \note Set use_tbb to compute the pattern thread parallel.
  */
 template <class TGV, size_t t_r, size_t t_rC, class TR, class AGV, size_t a_r, size_t a_rC, class AR, class GV>
 XT::LA::SparsityPatternDefault
 make_intersection_sparsity_pattern(const SpaceInterface<TGV, t_r, t_rC, TR>& test_space,
                                    const SpaceInterface<AGV, a_r, a_rC, AR>& ansatz_space,
-                                   const GV& grid_view)
+                                   const GV& grid_view,
+                                   const bool use_tbb = false)
 {
-  XT::LA::SparsityPatternDefault pattern(test_space.mapper().size());
-  DynamicVector<size_t> row_indices(test_space.mapper().max_local_size(), 0);
-  DynamicVector<size_t> column_indices(ansatz_space.mapper().max_local_size(), 0);
-  for (auto&& element : elements(grid_view)) {
-    test_space.mapper().global_indices(element, row_indices);
-    for (auto& intersection : intersections(grid_view, element)) {
-      if (intersection.neighbor()) {
-        const auto neighbour = intersection.outside();
-        ansatz_space.mapper().global_indices(neighbour, column_indices);
-        for (size_t ii = 0; ii < test_space.mapper().local_size(element); ++ii)
-          for (size_t jj = 0; jj < ansatz_space.mapper().local_size(neighbour); ++jj)
-            pattern.insert(row_indices[ii], column_indices[jj]);
-      }
-    }
-  }
-  pattern.sort();
-  return pattern;
+  return internal::make_sparsity_pattern(test_space, ansatz_space, grid_view, false, true, use_tbb);
 } // ... make_intersection_sparsity_pattern(...)
 
 
@@ -118,29 +207,10 @@ template <class TGV, size_t t_r, size_t t_rC, class TR, class AGV, size_t a_r, s
 XT::LA::SparsityPatternDefault
 make_element_and_intersection_sparsity_pattern(const SpaceInterface<TGV, t_r, t_rC, TR>& test_space,
                                                const SpaceInterface<AGV, a_r, a_rC, AR>& ansatz_space,
-                                               const GV& grid_view)
+                                               const GV& grid_view,
+                                               const bool use_tbb = false)
 {
-  XT::LA::SparsityPatternDefault pattern(test_space.mapper().size());
-  DynamicVector<size_t> row_indices(test_space.mapper().max_local_size(), 0);
-  DynamicVector<size_t> column_indices(ansatz_space.mapper().max_local_size(), 0);
-  for (auto&& element : elements(grid_view)) {
-    test_space.mapper().global_indices(element, row_indices);
-    ansatz_space.mapper().global_indices(element, column_indices);
-    for (size_t ii = 0; ii < test_space.mapper().local_size(element); ++ii)
-      for (size_t jj = 0; jj < ansatz_space.mapper().local_size(element); ++jj)
-        pattern.insert(row_indices[ii], column_indices[jj]);
-    for (auto&& intersection : intersections(grid_view, element)) {
-      if (intersection.neighbor()) {
-        const auto neighbour = intersection.outside();
-        ansatz_space.mapper().global_indices(neighbour, column_indices);
-        for (size_t ii = 0; ii < test_space.mapper().local_size(element); ++ii)
-          for (size_t jj = 0; jj < ansatz_space.mapper().local_size(neighbour); ++jj)
-            pattern.insert(row_indices[ii], column_indices[jj]);
-      }
-    }
-  }
-  pattern.sort();
-  return pattern;
+  return internal::make_sparsity_pattern(test_space, ansatz_space, grid_view, true, true, use_tbb);
 } // ... make_element_and_intersection_sparsity_pattern(...)
 
 
@@ -163,14 +233,15 @@ template <class TGV, size_t t_r, size_t t_rC, class TR, class AGV, size_t a_r, s
 XT::LA::SparsityPatternDefault make_sparsity_pattern(const SpaceInterface<TGV, t_r, t_rC, TR>& test_space,
                                                      const SpaceInterface<AGV, a_r, a_rC, AR>& ansatz_space,
                                                      const GV& grid_view,
-                                                     const Stencil stencil)
+                                                     const Stencil stencil,
+                                                     const bool use_tbb = false)
 {
   if (stencil == Stencil::element)
-    return make_element_sparsity_pattern(test_space, ansatz_space, grid_view);
+    return make_element_sparsity_pattern(test_space, ansatz_space, grid_view, use_tbb);
   else if (stencil == Stencil::intersection)
-    return make_intersection_sparsity_pattern(test_space, ansatz_space, grid_view);
+    return make_intersection_sparsity_pattern(test_space, ansatz_space, grid_view, use_tbb);
   else if (stencil == Stencil::element_and_intersection)
-    return make_element_and_intersection_sparsity_pattern(test_space, ansatz_space, grid_view);
+    return make_element_and_intersection_sparsity_pattern(test_space, ansatz_space, grid_view, use_tbb);
   else
     DUNE_THROW(XT::Common::Exceptions::wrong_input_given,
                "Unknown Stencil encountered (see below), add an appropriate method!"
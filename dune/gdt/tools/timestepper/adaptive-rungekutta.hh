@@ -20,6 +20,7 @@
 #include <dune/xt/common/string.hh>
 
 #include "interface.hh"
+#include "linear-combination.hh"
 
 #if HAVE_TBB && __has_include(<tbb/tbb_exception.h>)
 #  include <tbb/tbb_exception.h>
@@ -180,6 +181,7 @@ public:
   using RangeFieldType = typename DiscreteFunctionType::RangeFieldType;
   using MatrixType = typename Dune::DynamicMatrix<RangeFieldType>;
   using VectorType = typename Dune::DynamicVector<RangeFieldType>;
+  using DofVectorType = typename DiscreteFunctionType::VectorType;
   using SolutionType = typename std::vector<std::pair<RangeFieldType, DiscreteFunctionType>>;
 
   /**
@@ -220,6 +222,7 @@ public:
     , c_(c)
     , b_diff_(b_2_ - b_1_)
     , num_stages_(A_.rows())
+    , use_tbb_(false)
   {
     assert(Dune::XT::Common::FloatCmp::gt(tol_, 0.0));
     assert(Dune::XT::Common::FloatCmp::le(scale_factor_min_, 1.0));
@@ -245,6 +248,15 @@ public:
   using BaseType::current_time;
   using BaseType::solve;
 
+  /**
+   * \brief Use TBB (if available) for the linear combinations of the stages, the error and the update of the solution.
+   * \note  This does not affect the application of the operator.
+   */
+  void use_tbb(const bool value)
+  {
+    use_tbb_ = value;
+  }
+
   RangeFieldType solve(const RangeFieldType t_end,
                        const RangeFieldType initial_dt,
                        const size_t num_save_steps,
@@ -297,9 +309,11 @@ public:
 
       for (size_t ii = first_stage_to_compute; ii < num_stages_; ++ii) {
         std::fill(stages_k_[ii].dofs().vector().begin(), stages_k_[ii].dofs().vector().end(), RangeFieldType(0.));
-        u_tmp_.dofs().vector() = u_n.dofs().vector();
+        summands_.clear();
+        append_summand(1., u_n.dofs().vector());
         for (size_t jj = 0; jj < ii; ++jj)
-          u_tmp_.dofs().vector() += stages_k_[jj].dofs().vector() * (actual_dt * r_ * (A_[ii][jj]));
+          append_summand(actual_dt * r_ * A_[ii][jj], stages_k_[jj].dofs().vector());
+        internal::linear_combination(summands_, u_tmp_.dofs().vector(), use_tbb_);
         try {
           op_.apply(u_tmp_.dofs().vector(), stages_k_[ii].dofs().vector(), t + actual_dt * c_[ii]);
         } catch (const Dune::MathError& e) {
@@ -319,14 +333,17 @@ public:
 
       if (!skip_error_computation) {
         // compute error vector
-        u_tmp_.dofs().vector() = stages_k_[0].dofs().vector() * b_diff_[0];
-        for (size_t ii = 1; ii < num_stages_; ++ii)
-          u_tmp_.dofs().vector() += stages_k_[ii].dofs().vector() * b_diff_[ii];
-        u_tmp_.dofs().vector() *= actual_dt * r_;
+        summands_.clear();
+        for (size_t ii = 0; ii < num_stages_; ++ii)
+          append_summand(actual_dt * r_ * b_diff_[ii], stages_k_[ii].dofs().vector());
+        internal::linear_combination(summands_, u_tmp_.dofs().vector(), use_tbb_);
 
         // calculate u at timestep n+1
+        summands_.clear();
+        append_summand(1., u_n.dofs().vector());
         for (size_t ii = 0; ii < num_stages_; ++ii)
-          u_n.dofs().vector() += stages_k_[ii].dofs().vector() * (actual_dt * r_ * b_1_[ii]);
+          append_summand(actual_dt * r_ * b_1_[ii], stages_k_[ii].dofs().vector());
+        internal::linear_combination(summands_, u_n.dofs().vector(), use_tbb_);
 
         // scale error, use absolute error if norm is less than 0.01 and relative error else
         auto& diff_vector = u_tmp_.dofs().vector();
@@ -340,8 +357,10 @@ public:
             std::min(std::max(0.9 * std::pow(tol_ / mixed_error, 1.0 / 5.0), scale_factor_min_), scale_factor_max_);
 
         if (mixed_error > tol_) { // go back from u at timestep n+1 to timestep n
-          for (size_t ii = 0; ii < num_stages_; ++ii)
-            u_n.dofs().vector() += stages_k_[ii].dofs().vector() * (-1.0 * r_ * actual_dt * b_1_[ii]);
+          for (auto& summand : summands_)
+            if (summand.second != &u_n.dofs().vector())
+              summand.first *= -1.;
+          internal::linear_combination(summands_, u_n.dofs().vector(), use_tbb_);
         }
       }
     } // while (mixed_error > tol_)
@@ -355,6 +374,12 @@ public:
   } // ... step(...)
 
 private:
+  void append_summand(const RangeFieldType& coefficient, const DofVectorType& vector)
+  {
+    if (coefficient != 0.)
+      summands_.emplace_back(coefficient, &vector);
+  }
+
   const OperatorType& op_;
   const RangeFieldType r_;
   const RangeFieldType tol_;
@@ -369,6 +394,8 @@ private:
   std::vector<DiscreteFunctionType> stages_k_;
   const size_t num_stages_;
   std::unique_ptr<DiscreteFunctionType> last_stage_of_previous_step_;
+  bool use_tbb_;
+  std::vector<std::pair<RangeFieldType, const DofVectorType*>> summands_;
 }; // class AdaptiveRungeKuttaTimeStepper
 
 
@@ -12,10 +12,20 @@
 #ifndef DUNE_GDT_TIMESTEPPER_EXPLICIT_RUNGEKUTTA_HH
 #define DUNE_GDT_TIMESTEPPER_EXPLICIT_RUNGEKUTTA_HH
 
+#include <future>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include <dune/common/dynvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/common/gridenums.hh>
+
+#include <dune/gdt/tools/parallel-for.hh>
 
 #include "enums.hh"
 #include "interface.hh"
+#include "linear-combination.hh"
 
 
 namespace Dune {
@@ -140,6 +150,50 @@ struct ButcherArrayProvider<RangeFieldType, TimeStepperMethods::explicit_rungeku
 };
 
 
+/**
+ * \brief Checks if the operator can be applied on a range of elements, adding to its range, and if it can tell whether
+ *        it only accesses face neighbors (see LocalizableOperator::apply_range and
+ *        LocalizableOperator::face_neighbor_stencil).
+ */
+template <class OperatorType, class DiscreteFunctionType, class ElementRangeType, class = void>
+struct supports_apply_range : public std::false_type
+{};
+
+template <class OperatorType, class DiscreteFunctionType, class ElementRangeType>
+struct supports_apply_range<
+    OperatorType,
+    DiscreteFunctionType,
+    ElementRangeType,
+    std::void_t<decltype(std::declval<const OperatorType&>().apply_range(
+                    std::declval<const DiscreteFunctionType&>(),
+                    std::declval<typename DiscreteFunctionType::VectorType&>(),
+                    std::declval<const XT::Common::Parameter&>(),
+                    std::declval<const ElementRangeType&>(),
+                    false)),
+                decltype(std::declval<const OperatorType&>().face_neighbor_stencil())>> : public std::true_type
+{};
+
+
+/**
+ * \brief Returns true if MPI may be called from a thread other than the main thread (while the main thread does not
+ *        call MPI).
+ */
+inline bool mpi_supports_communication_thread()
+{
+#if HAVE_MPI
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (!initialized)
+    return false;
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  return provided >= MPI_THREAD_SERIALIZED;
+#else
+  return false;
+#endif
+} // ... mpi_supports_communication_thread(...)
+
+
 } // namespace internal
 
 
@@ -172,11 +226,15 @@ public:
   using typename BaseType::DiscreteFunctionType;
   using typename BaseType::DiscreteSolutionType;
   using typename BaseType::DomainFieldType;
+  using typename BaseType::EntityType;
+  using typename BaseType::GridViewType;
   using typename BaseType::RangeFieldType;
 
   using OperatorType = OperatorImp;
   using MatrixType = Dune::DynamicMatrix<RangeFieldType>;
   using VectorType = Dune::DynamicVector<RangeFieldType>;
+  using DofVectorType = typename DiscreteFunctionType::VectorType;
+  using ElementRangeType = std::vector<EntityType>;
 
   using BaseType::current_solution;
   using BaseType::current_time;
@@ -206,6 +264,8 @@ public:
     , b_(b)
     , c_(c)
     , num_stages_(A_.rows())
+    , use_tbb_(false)
+    , split_phase_communication_(false)
   {
     assert(A_.rows() == A_.cols() && "A has to be a square matrix");
     assert(b_.size() == A_.rows());
@@ -234,6 +294,52 @@ public:
     : ExplicitRungeKuttaTimeStepper(op, initial_values, r, t_0)
   {}
 
+  /**
+   * \brief Use TBB (if available) for the linear combinations of the stages and the update of the solution.
+   * \note  This does not affect the application of the operator.
+   */
+  void use_tbb(const bool value)
+  {
+    use_tbb_ = value;
+  }
+
+  /**
+   * \brief Overlap the halo exchange with the application of the operator (split-phase communication).
+   *
+   * Instead of exchanging each stage k_i after the application of the operator in a blocking manner, the argument u_i
+   * of the operator is exchanged: the exchange is started, the operator is applied on all elements which neither share
+   * a DoF with nor are face neighbors of a non-interior element (which thus do not require ghost data), the exchange is
+   * finished and the operator is applied on the remaining elements. The updated solution is exchanged at the end of
+   * each step, so that its ghost values are consistent after each step (and after solve()).
+   *
+   * The exchange is carried out by a separate thread, which requires MPI to be initialized with at least
+   * MPI_THREAD_SERIALIZED (e.g., by MPI_Init_thread, as opposed to the default initialization by MPIHelper).
+   *
+   * \note This requires an operator providing apply_range(...), such as LocalizableOperator, which declares that it
+   *       only accesses the source on each element and its face neighbors (see
+   *       LocalizableOperator::declare_face_neighbor_stencil). Since the element ranges are walked sequentially, this
+   *       is meant for runs with one MPI rank per core. The decomposition of the grid view is computed in the first
+   *       step and reused until the mapper of the current solution reports an adaptation of the grid (see
+   *       MapperInterface::adaptation_count) or the number of elements changes.
+   */
+  void use_split_phase_communication(const bool value)
+  {
+    if constexpr (internal::supports_apply_range<OperatorType, DiscreteFunctionType, ElementRangeType>::value) {
+      DUNE_THROW_IF(value && !op_.face_neighbor_stencil(),
+                    XT::Common::Exceptions::wrong_input_given,
+                    "The operator does not declare a face neighbor stencil, required for split-phase communication!");
+      DUNE_THROW_IF(value && current_solution().space().grid_view().comm().size() > 1
+                        && !internal::mpi_supports_communication_thread(),
+                    XT::Common::Exceptions::wrong_input_given,
+                    "Split-phase communication requires MPI to be initialized with at least MPI_THREAD_SERIALIZED!");
+    } else {
+      DUNE_THROW_IF(value,
+                    XT::Common::Exceptions::wrong_input_given,
+                    "The operator does not provide apply_range(...), required for split-phase communication!");
+    }
+    split_phase_communication_ = value;
+  }
+
   RangeFieldType step(const RangeFieldType dt, const RangeFieldType max_dt) override final
   {
     const RangeFieldType actual_dt = std::min(dt, max_dt);
@@ -243,23 +349,44 @@ public:
 
     // calculate stages
     auto& u_n = current_solution();
+    if (split_phase_communication_)
+      update_element_decomposition(u_n);
     for (size_t ii = 0; ii < num_stages_; ++ii) {
-      u_i_->dofs().vector() = u_n.dofs().vector();
-      for (size_t jj = 0; jj < ii; ++jj)
-        u_i_->dofs().vector() += stages_k_[jj]->dofs().vector() * (actual_dt * r_ * (A_[ii][jj]));
+      // A is strictly lower triangular, so the first stage is evaluated at u_n itself
+      DiscreteFunctionType* u_i = &u_n;
+      if (ii > 0) {
+        summands_.clear();
+        append_summand(1., u_n.dofs().vector());
+        for (size_t jj = 0; jj < ii; ++jj)
+          append_summand(actual_dt * r_ * A_[ii][jj], stages_k_[jj]->dofs().vector());
+        internal::linear_combination(summands_, u_i_->dofs().vector(), use_tbb_);
+        u_i = u_i_.get();
+      }
       // TODO: provide actual_dt to op_. This leads to spurious oscillations in the Lax-Friedrichs flux
       // because actual_dt/dx may become very small.
-      op_.apply(u_i_->dofs().vector(),
-                stages_k_[ii]->dofs().vector(),
-                XT::Common::Parameter({{"t", {t + actual_dt * c_[ii]}}, {"dt", {dt}}}));
-      DataHandleType stages_k_ii_handle(*stages_k_[ii]);
-      stages_k_[ii]->space().grid_view().template communicate<DataHandleType>(
-          stages_k_ii_handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+      const XT::Common::Parameter param({{"t", {t + actual_dt * c_[ii]}}, {"dt", {dt}}});
+      if (split_phase_communication_) {
+        apply_with_split_phase_communication(*u_i, *stages_k_[ii], param);
+      } else {
+        op_.apply(u_i->dofs().vector(), stages_k_[ii]->dofs().vector(), param);
+        DataHandleType stages_k_ii_handle(*stages_k_[ii]);
+        stages_k_[ii]->space().grid_view().template communicate<DataHandleType>(
+            stages_k_ii_handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+      }
     }
 
     // calculate value of u at next time step
+    summands_.clear();
+    append_summand(1., u_n.dofs().vector());
     for (size_t ii = 0; ii < num_stages_; ++ii)
-      u_n.dofs().vector() += stages_k_[ii]->dofs().vector() * (r_ * actual_dt * b_[ii]);
+      append_summand(r_ * actual_dt * b_[ii], stages_k_[ii]->dofs().vector());
+    internal::linear_combination(summands_, u_n.dofs().vector(), use_tbb_);
+    if (split_phase_communication_) {
+      // only the stages on the interior elements are consistent, so make the ghost values of u_n consistent as well
+      DataHandleType u_n_handle(u_n);
+      u_n.space().grid_view().template communicate<DataHandleType>(
+          u_n_handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+    }
 
     // augment time
     t += actual_dt;
@@ -317,6 +444,88 @@ public:
   }
 
 private:
+  void append_summand(const RangeFieldType& coefficient, const DofVectorType& vector)
+  {
+    if (coefficient != 0.)
+      summands_.emplace_back(coefficient, &vector);
+  }
+
+  void apply_with_split_phase_communication(DiscreteFunctionType& source,
+                                            DiscreteFunctionType& range,
+                                            const XT::Common::Parameter& param)
+  {
+    if constexpr (internal::supports_apply_range<OperatorType, DiscreteFunctionType, ElementRangeType>::value) {
+      const auto& grid_view = source.space().grid_view();
+      // the halo of the source is written to by the communication thread, concurrently to the interior pass
+      ensure_unshared_data(source.dofs().vector());
+      DataHandleType source_handle(source);
+      const auto exchange_halo = [&]() {
+        grid_view.template communicate<DataHandleType>(
+            source_handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+      };
+      std::future<void> halo_exchange;
+      if (grid_view.comm().size() > 1)
+        halo_exchange = std::async(std::launch::async, exchange_halo);
+      // the source function overload does not check the source vector (including the halo) for inf or nan
+      op_.apply_range(source, range.dofs().vector(), param, interior_elements_, /*clear_range=*/true);
+      if (halo_exchange.valid())
+        halo_exchange.get();
+      op_.apply_range(source, range.dofs().vector(), param, halo_elements_, /*clear_range=*/false);
+    } else {
+      DUNE_THROW(XT::Common::Exceptions::wrong_input_given,
+                 "The operator does not provide apply_range(...), required for split-phase communication!");
+    }
+  } // ... apply_with_split_phase_communication(...)
+
+  void update_element_decomposition(const DiscreteFunctionType& u)
+  {
+    const auto& mapper = u.space().mapper();
+    const size_t num_elements = u.space().grid_view().indexSet().size(0);
+    if (decomposed_mapper_ == &mapper && decomposed_adaptation_count_ == mapper.adaptation_count()
+        && decomposed_num_elements_ == num_elements)
+      return;
+    decompose_elements(u);
+    decomposed_mapper_ = &mapper;
+    decomposed_adaptation_count_ = mapper.adaptation_count();
+    decomposed_num_elements_ = num_elements;
+  } // ... update_element_decomposition(...)
+
+  /**
+   * Sorts the elements into those which only access data written by the halo exchange and the remaining ones: an
+   * element requires the halo if it is not an interior element, if one of its face neighbors is not an interior element
+   * or if it shares a DoF with a non-interior element (e.g., a vertex DoF of a continuous space).
+   */
+  void decompose_elements(const DiscreteFunctionType& u)
+  {
+    const auto& grid_view = u.space().grid_view();
+    const auto& mapper = u.space().mapper();
+    interior_elements_.clear();
+    halo_elements_.clear();
+    halo_dofs_.assign(mapper.size(), false);
+    for (auto&& element : elements(grid_view)) {
+      if (element.partitionType() != Dune::InteriorEntity) {
+        mapper.global_indices(element, global_indices_);
+        for (size_t ii = 0; ii < mapper.local_size(element); ++ii)
+          halo_dofs_[global_indices_[ii]] = true;
+      }
+    }
+    for (auto&& element : elements(grid_view)) {
+      bool requires_halo = element.partitionType() != Dune::InteriorEntity;
+      for (auto&& intersection : intersections(grid_view, element))
+        if (!requires_halo && intersection.neighbor() && intersection.outside().partitionType() != Dune::InteriorEntity)
+          requires_halo = true;
+      if (!requires_halo) {
+        mapper.global_indices(element, global_indices_);
+        for (size_t ii = 0; ii < mapper.local_size(element); ++ii)
+          requires_halo = requires_halo || halo_dofs_[global_indices_[ii]];
+      }
+      if (requires_halo)
+        halo_elements_.push_back(element);
+      else
+        interior_elements_.push_back(element);
+    }
+  } // ... decompose_elements(...)
+
   const OperatorType& op_;
   const RangeFieldType r_;
   std::unique_ptr<DiscreteFunctionType> u_i_;
@@ -325,6 +534,16 @@ private:
   const VectorType c_;
   std::vector<std::unique_ptr<DiscreteFunctionType>> stages_k_;
   const size_t num_stages_;
+  bool use_tbb_;
+  std::vector<std::pair<RangeFieldType, const DofVectorType*>> summands_;
+  bool split_phase_communication_;
+  ElementRangeType interior_elements_;
+  ElementRangeType halo_elements_;
+  std::vector<bool> halo_dofs_;
+  DynamicVector<size_t> global_indices_;
+  const typename DiscreteFunctionType::SpaceType::MapperType* decomposed_mapper_ = nullptr;
+  size_t decomposed_adaptation_count_ = 0;
+  size_t decomposed_num_elements_ = 0;
 };
 
 
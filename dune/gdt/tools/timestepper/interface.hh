@@ -30,6 +30,7 @@
 #include <dune/gdt/discretefunction/default.hh>
 
 #include "enums.hh"
+#include "snapshot-sink.hh"
 
 namespace Dune {
 namespace GDT {
@@ -76,6 +77,7 @@ public:
   using ThisType = TimeStepperInterface;
 
 private:
+  using SnapshotSinkType = SnapshotSinkInterface<DiscreteFunctionImp>;
   using CurrentSolutionStorageProviderType = typename Dune::XT::Common::StorageProvider<DiscreteFunctionImp>;
   using SolutionStorageProviderType = typename Dune::XT::Common::StorageProvider<DiscreteSolutionType>;
 
@@ -86,6 +88,7 @@ protected:
     , t_(t_0)
     , u_n_(&CurrentSolutionStorageProviderType::access())
     , solution_(&SolutionStorageProviderType::access())
+    , snapshot_sink_(nullptr)
   {}
 
 public:
@@ -150,6 +153,22 @@ public:
     solution_ = &solution_ref;
   }
 
+  /**
+   * \brief Additionally hands all snapshots taken in solve(...) to the given sink (e.g., an AsyncSnapshotWriter).
+   * \note  The arguments of solve(...) are still honoured, so pass save_solution = visualize = write_discrete =
+   *        write_exact = false to leave storing and writing the snapshots to the sink.
+   * \note  solve(...) flushes the sink before returning.
+   */
+  void set_snapshot_sink(SnapshotSinkType& sink)
+  {
+    snapshot_sink_ = &sink;
+  }
+
+  void remove_snapshot_sink()
+  {
+    snapshot_sink_ = nullptr;
+  }
+
   static const GridFunctionType& dummy_solution()
   {
     static auto dummy_sol = XT::Functions::GenericGridFunction<EntityType, dimRange, dimRangeCols, RangeFieldType>(0);
@@ -212,6 +231,8 @@ public:
     size_t save_step_counter = 1;
 
     // save/visualize initial solution
+    if (snapshot_sink_)
+      snapshot_sink_->push(t, 0, current_solution());
     if (save_solution)
       sol.emplace(t, current_solution().copy_as_discrete_function());
     write_files(visualize,
@@ -249,6 +270,8 @@ public:
 
       // check if data should be written in this timestep (and write)
       if (Dune::XT::Common::FloatCmp::ge(t, next_save_time) || num_save_steps == size_t(-1)) {
+        if (snapshot_sink_)
+          snapshot_sink_->push(t, save_step_counter, current_solution());
         if (save_solution)
           sol.emplace_hint(sol.end(), t, current_solution().copy_as_discrete_function());
         write_files(visualize,
@@ -270,6 +293,8 @@ public:
         next_output_time += output_interval;
       }
     } // while (t < t_end)
+    if (snapshot_sink_)
+      snapshot_sink_->flush();
     solve_walltime_ = std::chrono::steady_clock::now() - begin_time_;
     // for the last time point there is no actual dt and no computation time as the step is not taken anymore, so we
     // store the estimate for the next timestep and the time for the whole solution process
@@ -499,6 +524,7 @@ protected:
   RangeFieldType t_;
   DiscreteFunctionType* u_n_;
   DiscreteSolutionType* solution_;
+  SnapshotSinkType* snapshot_sink_;
   std::chrono::time_point<std::chrono::steady_clock> begin_time_;
   std::vector<double> dts_;
   std::vector<double> timepoints_;
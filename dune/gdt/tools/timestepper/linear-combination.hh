@@ -0,0 +1,67 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+#ifndef DUNE_GDT_TIMESTEPPER_LINEAR_COMBINATION_HH
+#define DUNE_GDT_TIMESTEPPER_LINEAR_COMBINATION_HH
+
+#include <utility>
+#include <vector>
+
+#include <dune/xt/common/exceptions.hh>
+
+#include <dune/gdt/tools/parallel-for.hh>
+
+namespace Dune {
+namespace GDT {
+namespace internal {
+
+
+/**
+ * \brief Computes result = \sum_j alpha_j x_j in a single pass without creating temporaries, given summands (alpha_j,
+ *        &x_j).
+ *
+ * This is used for the stages and updates of the Runge Kutta time steppers, where the usual vector expressions (e.g.,
+ * u += k * alpha) allocate a temporary vector for each summand. Any of the x_j may be the result itself (e.g., for
+ * u = u + alpha k), since each entry of the result is only written after all summands have been read at that entry.
+ *
+ * \sa parallel_for_chunks
+ */
+template <class VectorType, class FieldType>
+void linear_combination(const std::vector<std::pair<FieldType, const VectorType*>>& summands,
+                        VectorType& result,
+                        const bool use_tbb = false)
+{
+  const size_t size = result.size();
+  for (const auto& summand : summands)
+    DUNE_THROW_IF(summand.second->size() != size,
+                  XT::Common::Exceptions::shapes_do_not_match,
+                  "summand.second->size() = " << summand.second->size() << "\n   result.size() = " << size);
+  if (size == 0)
+    return;
+  ensure_unshared_data(result);
+  parallel_for_chunks(
+      0,
+      size,
+      [&](const size_t first, const size_t last) {
+        for (size_t kk = first; kk < last; ++kk) {
+          FieldType value = 0;
+          for (const auto& summand : summands)
+            value += summand.first * (*summand.second)[kk];
+          result[kk] = value;
+        }
+      },
+      use_tbb);
+} // ... linear_combination(...)
+
+
+} // namespace internal
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TIMESTEPPER_LINEAR_COMBINATION_HH
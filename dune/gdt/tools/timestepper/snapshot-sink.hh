@@ -0,0 +1,304 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+#ifndef DUNE_GDT_TIMESTEPPER_SNAPSHOT_SINK_HH
+#define DUNE_GDT_TIMESTEPPER_SNAPSHOT_SINK_HH
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/memory.hh>
+#include <dune/xt/common/string.hh>
+#include <dune/xt/functions/visualization.hh>
+
+#include <dune/gdt/exceptions.hh>
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief Receives the snapshots of the solution taken in TimeStepperInterface::solve(...).
+ *
+ * \sa TimeStepperInterface::set_snapshot_sink
+ */
+template <class DiscreteFunctionImp>
+class SnapshotSinkInterface
+{
+public:
+  using DiscreteFunctionType = DiscreteFunctionImp;
+  using RangeFieldType = typename DiscreteFunctionType::RangeFieldType;
+
+  virtual ~SnapshotSinkInterface() = default;
+
+  /**
+   * \brief Takes a snapshot of the given solution at time t, the step-th snapshot of the current solve.
+   * \note  The solution may be altered once this method returns, so implementations have to copy what they need.
+   */
+  virtual void push(const RangeFieldType t, const size_t step, const DiscreteFunctionType& solution) = 0;
+
+  /// \brief Blocks until all snapshots pushed so far are processed.
+  virtual void flush() = 0;
+}; // class SnapshotSinkInterface
+
+
+/**
+ * \brief Writes snapshots of the solution on a background thread.
+ *
+ * Each snapshot is copied into one of max_queued_snapshots preallocated buffers and written by a background thread,
+ * so the time loop only waits if all buffers are still queued (i.e., if the writer falls behind by more than
+ * max_queued_snapshots snapshots). The memory consumption is thus bounded, regardless of the number of snapshots.
+ *
+ * Each snapshot is (optionally) visualized (as in TimeStepperInterface::write_files) and/or spilled to disk in a
+ * binary format (one file per MPI rank, see write_dofs() and read_dofs()), from which it can be restored later on.
+ *
+ * \note Writing parallel VTK files requires collective communication, which must not happen on the background thread.
+ *       With more than one MPI rank, the snapshots are thus visualized synchronously in push(), only spilling the DoFs
+ *       is done in the background.
+ * \note The grid (and the space) must not be changed while snapshots are queued, call flush() before adapting the grid.
+ * \note Writing the text files of TimeStepperInterface::write_files requires a barrier, so this is not supported here.
+ */
+template <class DiscreteFunctionImp>
+class AsyncSnapshotWriter : public SnapshotSinkInterface<DiscreteFunctionImp>
+{
+  using ThisType = AsyncSnapshotWriter;
+  using BaseType = SnapshotSinkInterface<DiscreteFunctionImp>;
+
+public:
+  using typename BaseType::DiscreteFunctionType;
+  using typename BaseType::RangeFieldType;
+  using VectorType = typename DiscreteFunctionType::VectorType;
+  using VisualizerType =
+      XT::Functions::VisualizerInterface<DiscreteFunctionType::r, DiscreteFunctionType::rC, RangeFieldType>;
+
+  AsyncSnapshotWriter(const std::string& prefix,
+                      const bool visualize = true,
+                      const bool spill_dofs = false,
+                      const size_t max_queued_snapshots = 2,
+                      const VisualizerType& visualizer = default_visualizer())
+    : prefix_(prefix)
+    , visualize_(visualize)
+    , spill_dofs_(spill_dofs)
+    , max_queued_snapshots_(max_queued_snapshots)
+    , visualizer_(visualizer)
+    , num_busy_(0)
+    , stop_(false)
+  {
+    DUNE_THROW_IF(max_queued_snapshots_ == 0, XT::Common::Exceptions::wrong_input_given, "max_queued_snapshots = 0");
+    writer_ = std::thread([&]() { this->write_queued_snapshots(); });
+  }
+
+  AsyncSnapshotWriter(const ThisType&) = delete;
+  AsyncSnapshotWriter(ThisType&&) = delete;
+
+  ThisType& operator=(const ThisType&) = delete;
+  ThisType& operator=(ThisType&&) = delete;
+
+  /// \brief Writes all remaining snapshots before returning.
+  ~AsyncSnapshotWriter()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    snapshot_queued_.notify_one();
+    writer_.join();
+  }
+
+  void push(const RangeFieldType t, const size_t step, const DiscreteFunctionType& solution) override final
+  {
+    const bool parallel = solution.space().grid_view().comm().size() > 1;
+    if (visualize_ && parallel)
+      visualize(solution, step);
+    if (!spill_dofs_ && (!visualize_ || parallel))
+      return; // nothing left to do in the background
+    std::unique_lock<std::mutex> lock(mutex_);
+    rethrow_writer_exception();
+    // obtain a buffer, allocate a new one only if we may
+    if (free_snapshots_.empty() && snapshots_.size() < max_queued_snapshots_) {
+      snapshots_.emplace_back(Snapshot{0., 0, solution.copy_as_discrete_function()});
+      free_snapshots_.push_back(snapshots_.size() - 1);
+    }
+    snapshot_released_.wait(lock, [&]() { return !free_snapshots_.empty() || writer_exception_; });
+    rethrow_writer_exception();
+    const size_t index = free_snapshots_.back();
+    free_snapshots_.pop_back();
+    auto& snapshot = snapshots_[index];
+    lock.unlock();
+    // copy the data (the buffer is ours until we queue it), entry by entry so that the buffer does not share its data
+    // with the solution (which would be copied once the solution is altered)
+    snapshot.t = t;
+    snapshot.step = step;
+    const auto& source = solution.dofs().vector();
+    auto& target = snapshot.solution->dofs().vector();
+    for (size_t ii = 0; ii < source.size(); ++ii)
+      target.set_entry(ii, source.get_entry(ii));
+    // and queue it
+    lock.lock();
+    queued_snapshots_.push_back(index);
+    lock.unlock();
+    snapshot_queued_.notify_one();
+  } // ... push(...)
+
+  void flush() override final
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    snapshot_released_.wait(lock, [&]() { return (queued_snapshots_.empty() && num_busy_ == 0) || writer_exception_; });
+    rethrow_writer_exception();
+  }
+
+  static const VisualizerType& default_visualizer()
+  {
+    static auto default_vis = std::make_unique<
+        XT::Functions::DefaultVisualizer<DiscreteFunctionType::r, DiscreteFunctionType::rC, RangeFieldType>>();
+    return *default_vis;
+  }
+
+  static std::string dofs_filename(const std::string& prefix, const int rank, const size_t step)
+  {
+    return prefix + "_rank_" + XT::Common::to_string(rank) + "_" + XT::Common::to_string(step) + ".dofs";
+  }
+
+  /**
+   * \brief Writes t and the DoF vector in binary form: the number of DoFs (std::uint64_t), t and the DoFs (both as
+   *        RangeFieldType).
+   */
+  static void write_dofs(const std::string& filename, const RangeFieldType t, const VectorType& dofs)
+  {
+    std::ofstream file(filename, std::ios_base::binary);
+    DUNE_THROW_IF(!file.is_open(), Exceptions::discrete_function_error, "could not open '" << filename << "'!");
+    const std::uint64_t size = dofs.size();
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(&t), sizeof(t));
+    for (size_t ii = 0; ii < size; ++ii) {
+      const RangeFieldType value = dofs.get_entry(ii);
+      file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    DUNE_THROW_IF(!file.good(), Exceptions::discrete_function_error, "could not write '" << filename << "'!");
+  } // ... write_dofs(...)
+
+  /// \brief Reads a file written by write_dofs() into dofs (which has to be of correct size), returns t.
+  static RangeFieldType read_dofs(const std::string& filename, VectorType& dofs)
+  {
+    std::ifstream file(filename, std::ios_base::binary);
+    DUNE_THROW_IF(!file.is_open(), Exceptions::discrete_function_error, "could not open '" << filename << "'!");
+    std::uint64_t size = 0;
+    RangeFieldType t = 0;
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    file.read(reinterpret_cast<char*>(&t), sizeof(t));
+    DUNE_THROW_IF(size != dofs.size(),
+                  Exceptions::discrete_function_error,
+                  "size (in '" << filename << "') = " << size << "\n   dofs.size() = " << dofs.size());
+    for (size_t ii = 0; ii < size; ++ii) {
+      RangeFieldType value = 0;
+      file.read(reinterpret_cast<char*>(&value), sizeof(value));
+      dofs.set_entry(ii, value);
+    }
+    DUNE_THROW_IF(!file.good(), Exceptions::discrete_function_error, "could not read '" << filename << "'!");
+    return t;
+  } // ... read_dofs(...)
+
+private:
+  struct Snapshot
+  {
+    RangeFieldType t;
+    size_t step;
+    std::unique_ptr<DiscreteFunctionType> solution;
+  };
+
+  void write_queued_snapshots()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      snapshot_queued_.wait(lock, [&]() { return !queued_snapshots_.empty() || stop_; });
+      if (queued_snapshots_.empty())
+        return; // stop_ is set and all snapshots are written
+      const size_t index = queued_snapshots_.front();
+      queued_snapshots_.pop_front();
+      const auto& snapshot = snapshots_[index];
+      ++num_busy_;
+      lock.unlock();
+      try {
+        write(snapshot);
+      } catch (...) {
+        lock.lock();
+        writer_exception_ = std::current_exception();
+        lock.unlock();
+      }
+      lock.lock();
+      --num_busy_;
+      free_snapshots_.push_back(index);
+      snapshot_released_.notify_all();
+    }
+  } // ... write_queued_snapshots(...)
+
+  void write(const Snapshot& snapshot) const
+  {
+    const auto& solution = *snapshot.solution;
+    const auto& grid_view = solution.space().grid_view();
+    // see push() for the parallel case
+    if (visualize_ && grid_view.comm().size() == 1)
+      visualize(solution, snapshot.step);
+    if (spill_dofs_)
+      write_dofs(dofs_filename(prefix_, grid_view.comm().rank(), snapshot.step), snapshot.t, solution.dofs().vector());
+  } // ... write(...)
+
+  void visualize(const DiscreteFunctionType& solution, const size_t step) const
+  {
+    XT::Functions::visualize(solution,
+                             solution.space().grid_view(),
+                             prefix_ + "_" + XT::Common::to_string(step),
+                             false,
+                             VTK::appendedraw,
+                             {},
+                             visualizer_.access());
+  }
+
+  // requires the mutex to be locked
+  void rethrow_writer_exception()
+  {
+    if (writer_exception_) {
+      auto exception = writer_exception_;
+      writer_exception_ = nullptr;
+      std::rethrow_exception(exception);
+    }
+  }
+
+  const std::string prefix_;
+  const bool visualize_;
+  const bool spill_dofs_;
+  const size_t max_queued_snapshots_;
+  const XT::Common::ConstStorageProvider<VisualizerType> visualizer_;
+  // a deque, so that growing it in push() does not invalidate the snapshot currently being written
+  std::deque<Snapshot> snapshots_;
+  std::vector<size_t> free_snapshots_;
+  std::deque<size_t> queued_snapshots_;
+  size_t num_busy_;
+  bool stop_;
+  std::exception_ptr writer_exception_;
+  std::mutex mutex_;
+  std::condition_variable snapshot_queued_;
+  std::condition_variable snapshot_released_;
+  std::thread writer_;
+}; // class AsyncSnapshotWriter
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TIMESTEPPER_SNAPSHOT_SINK_HH
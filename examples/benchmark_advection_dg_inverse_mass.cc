@@ -0,0 +1,121 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+// Compares the application of the DG advection operator of the periodic 1d Burgers tests (P2 and P3, Engquist-Osher
+// flux), where each local operator applies the inverse local mass matrix, with the fused mode, where it is applied
+// once per element.
+
+#include "config.h"
+
+#include <cmath>
+#include <cstdlib>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/xt/common/timedlogging.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/view/periodic.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/interpolations.hh>
+#include <dune/gdt/local/numerical-fluxes/engquist-osher.hh>
+#include <dune/gdt/operators/advection-dg.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_1D_EQUIDISTANT_OFFSET;
+using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+using V = XT::LA::IstlDenseVector<double>;
+
+
+int main(int argc, char* argv[])
+{
+  try {
+    MPIHelper::instance(argc, argv);
+    if (argc > 1)
+      DXTC_CONFIG.read_options(argc, argv);
+    XT::Common::TimedLogger().create(DXTC_CONFIG_GET("logger.info", 1), DXTC_CONFIG_GET("logger.debug", -1));
+    auto logger = XT::Common::TimedLogger().get("main");
+
+    const auto num_elements = DXTC_CONFIG_GET("num_elements", 1024);
+    const auto repetitions = DXTC_CONFIG_GET("repetitions", 20);
+
+    auto grid = XT::Grid::make_cube_grid<G>(/*lower_left=*/0., /*upper_right=*/1., /*num_elements=*/num_elements);
+    auto grid_view = XT::Grid::make_periodic_grid_layer(grid.leaf_view());
+    using GV = decltype(grid_view);
+    using I = XT::Grid::extract_intersection_t<GV>;
+    const XT::Functions::GenericFunction<1, 1, 1> flux(
+        2,
+        [&](const auto& u, const auto& /*param*/) { return 0.5 * u * u; },
+        "burgers",
+        {},
+        [&](const auto& u, const auto& /*param*/) { return u; });
+    const NumericalEngquistOsherFlux<I, 1, 1> numerical_flux(flux);
+
+    for (auto order : {2, 3}) {
+      auto space = make_discontinuous_lagrange_space(grid_view, order);
+      const auto initial_values = default_interpolation<V>(
+          3,
+          [&](const auto& xx, const auto& /*mu*/) {
+            return std::exp(-std::pow(xx[0] - 0.33, 2) / (2 * std::pow(0.075, 2)));
+          },
+          space);
+      const auto& source = initial_values.dofs().vector();
+      logger.info() << "P" << order << " DG space on " << grid_view.indexSet().size(0) << " elements, "
+                    << space.mapper().size() << " DoFs" << std::endl;
+
+      Timer timer;
+      const auto op = make_advection_dg_operator<M>(grid_view, numerical_flux, space, space);
+      const double setup_time = timer.elapsed();
+      V range(space.mapper().size(), 0.);
+      timer.reset();
+      for (int rr = 0; rr < repetitions; ++rr)
+        op.apply(source, range);
+      const double time = timer.elapsed() / repetitions;
+
+      const auto fused_op = make_advection_dg_operator<M>(grid_view,
+                                                          numerical_flux,
+                                                          space,
+                                                          space,
+                                                          XT::Grid::ApplyOn::NoIntersections<GV>(),
+                                                          advection_dg_artificial_viscosity_default_nu_1(),
+                                                          advection_dg_artificial_viscosity_default_alpha_1(),
+                                                          advection_dg_artificial_viscosity_default_component(),
+                                                          /*fuse_inverse_mass_application=*/true);
+      V fused_range(space.mapper().size(), 0.);
+      timer.reset();
+      for (int rr = 0; rr < repetitions; ++rr)
+        fused_op.apply(source, fused_range);
+      const double fused_time = timer.elapsed() / repetitions;
+
+      logger.info() << "  per local operator: " << time << "s per apply (" << setup_time << "s setup)" << std::endl;
+      logger.info() << "  fused:              " << fused_time << "s per apply (difference "
+                    << (range - fused_range).sup_norm() << ")" << std::endl;
+    }
+
+  } catch (Exception& e) {
+    std::cerr << "\nDUNE reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "\nstl reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "Unknown error occured!" << std::endl;
+    return EXIT_FAILURE;
+  } // try
+  return EXIT_SUCCESS;
+} // ... main(...)
@@ -0,0 +1,161 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2019)
+
+// Compares the throughput (cell updates per second) of the application of the FV advection operator of the periodic
+// 1d Burgers tests (Engquist-Osher flux): the grid walk of AdvectionFvOperator (the reference), its face-batched mode
+// (with and without the face data cache) and AdvectionFvFlatOperator (sequential and with TBB). The same is done on
+// the non-periodic grid, with a boundary treatment by extrapolation.
+
+#include "config.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/xt/common/timedlogging.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/view/periodic.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/interpolations.hh>
+#include <dune/gdt/local/numerical-fluxes/engquist-osher.hh>
+#include <dune/gdt/operators/advection-fv.hh>
+#include <dune/gdt/operators/advection-fv-flat.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_1D_EQUIDISTANT_OFFSET;
+using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+using V = XT::LA::IstlDenseVector<double>;
+
+
+template <class GV>
+void benchmark_all(const GV& grid_view, const bool with_boundary_treatment)
+{
+  auto logger = XT::Common::TimedLogger().get("main");
+  const auto repetitions = DXTC_CONFIG_GET("repetitions", 20);
+  const size_t face_batch_size = DXTC_CONFIG_GET("face_batch_size", 256);
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using ExtrapolationType =
+      typename AdvectionFvOperator<M, GV>::BoundaryTreatmentByCustomExtrapolationOperatorType::LambdaType;
+  const XT::Functions::GenericFunction<1, 1, 1> flux(
+      2,
+      [&](const auto& u, const auto& /*param*/) { return 0.5 * u * u; },
+      "burgers",
+      {},
+      [&](const auto& u, const auto& /*param*/) { return u; });
+  const NumericalEngquistOsherFlux<I, 1, 1> numerical_flux(flux);
+  const ExtrapolationType extrapolation = [](const auto& /*intersection*/,
+                                             const auto& /*xx_in_reference_intersection_coordinates*/,
+                                             const auto& /*flux*/,
+                                             const auto& u,
+                                             auto& v,
+                                             const auto& /*param*/) { v = u; };
+
+  auto space = make_finite_volume_space(grid_view);
+  const auto initial_values = default_interpolation<V>(
+      0,
+      [&](const auto& xx, const auto& /*mu*/) {
+        return std::exp(-std::pow(xx[0] - 0.33, 2) / (2 * std::pow(0.075, 2)));
+      },
+      space);
+  const auto& source = initial_values.dofs().vector();
+  const size_t num_cells = grid_view.indexSet().size(0);
+  logger.info() << "FV space on " << num_cells << " elements"
+                << (with_boundary_treatment ? " (with boundary treatment by extrapolation), " : " (periodic), ")
+                << repetitions << " applications each" << std::endl;
+
+  V reference_range(space.mapper().size(), 0.);
+  double reference_time = 0.;
+  auto benchmark = [&](const std::string& id, auto& op, const double setup_time) {
+    if (with_boundary_treatment)
+      op.append(extrapolation);
+    V range(space.mapper().size(), 0.);
+    Timer timer;
+    for (int rr = 0; rr < repetitions; ++rr)
+      op.apply(source, range);
+    const double time = timer.elapsed() / repetitions;
+    if (id == "reference") {
+      reference_range = range;
+      reference_time = time;
+    }
+    logger.info() << "  " << id << ": " << num_cells / time << " cell updates/s (" << time << "s per apply, speedup "
+                  << reference_time / time << ", " << setup_time << "s setup, difference "
+                  << (range - reference_range).sup_norm() << ")" << std::endl;
+  };
+  AdvectionFvOperator<M, GV> reference_op(grid_view, numerical_flux, space, space);
+  benchmark("reference", reference_op, 0.);
+
+  Timer timer;
+  AdvectionFvOperator<M, GV> batched_op(grid_view,
+                                        numerical_flux,
+                                        space,
+                                        space,
+                                        /*use_tbb=*/false,
+                                        XT::Grid::ApplyOn::NoIntersections<GV>(),
+                                        face_batch_size);
+  benchmark("face-batched", batched_op, timer.elapsed());
+
+  timer.reset();
+  AdvectionFvOperator<M, GV> cached_op(grid_view,
+                                       numerical_flux,
+                                       space,
+                                       space,
+                                       /*use_tbb=*/false,
+                                       XT::Grid::ApplyOn::NoIntersections<GV>(),
+                                       face_batch_size,
+                                       /*cache_face_data=*/true);
+  benchmark("face-batched, cached", cached_op, timer.elapsed());
+
+  timer.reset();
+  AdvectionFvFlatOperator<M, GV> flat_op(grid_view, numerical_flux, space, space, /*use_tbb=*/false, face_batch_size);
+  benchmark("flat", flat_op, timer.elapsed());
+
+  timer.reset();
+  AdvectionFvFlatOperator<M, GV> parallel_flat_op(
+      grid_view, numerical_flux, space, space, /*use_tbb=*/true, face_batch_size);
+  benchmark("flat, tbb", parallel_flat_op, timer.elapsed());
+} // ... benchmark_all(...)
+
+
+int main(int argc, char* argv[])
+{
+  try {
+    MPIHelper::instance(argc, argv);
+    if (argc > 1)
+      DXTC_CONFIG.read_options(argc, argv);
+    XT::Common::TimedLogger().create(DXTC_CONFIG_GET("logger.info", 1), DXTC_CONFIG_GET("logger.debug", -1));
+
+    const auto num_elements = DXTC_CONFIG_GET("num_elements", 1 << 16);
+    auto grid = XT::Grid::make_cube_grid<G>(/*lower_left=*/0., /*upper_right=*/1., /*num_elements=*/num_elements);
+    benchmark_all(XT::Grid::make_periodic_grid_layer(grid.leaf_view()), /*with_boundary_treatment=*/false);
+    benchmark_all(grid.leaf_view(), /*with_boundary_treatment=*/true);
+
+  } catch (Exception& e) {
+    std::cerr << "\nDUNE reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "\nstl reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "Unknown error occured!" << std::endl;
+    return EXIT_FAILURE;
+  } // try
+  return EXIT_SUCCESS;
+} // ... main(...)
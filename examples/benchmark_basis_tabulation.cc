@@ -0,0 +1,117 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+// Compares the evaluation of a DG basis in all quadrature points of all elements by the (tabulating) localized
+// DefaultGlobalBasis with the direct evaluation of the local finite element basis and the geometry transformation.
+
+#include "config.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/xt/common/timedlogging.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+
+#include <dune/gdt/spaces/basis/default.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_3D_EQUIDISTANT_OFFSET;
+using GV = typename G::LeafGridView;
+using D = typename GV::ctype;
+static constexpr size_t d = G::dimension;
+using BasisType = DefaultGlobalBasis<GV, 1, 1, double>;
+using LocalizedBasisType = typename BasisType::LocalizedType;
+
+
+int main(int argc, char* argv[])
+{
+  try {
+    MPIHelper::instance(argc, argv);
+    if (argc > 1)
+      DXTC_CONFIG.read_options(argc, argv);
+    XT::Common::TimedLogger().create(DXTC_CONFIG_GET("logger.info", 1), DXTC_CONFIG_GET("logger.debug", -1));
+    auto logger = XT::Common::TimedLogger().get("main");
+
+    const auto num_elements = DXTC_CONFIG_GET("num_elements", 16);
+    const auto order = DXTC_CONFIG_GET("order", 2);
+    const auto repetitions = DXTC_CONFIG_GET("repetitions", 5);
+
+    auto grid = XT::Grid::make_cube_grid<G>(/*lower_left=*/0., /*upper_right=*/1., /*num_elements=*/num_elements);
+    auto grid_view = grid.leaf_view();
+    auto space = make_discontinuous_lagrange_space(grid_view, order);
+    logger.info() << "Q" << order << " DG basis on " << grid_view.indexSet().size(0) << " elements" << std::endl;
+
+    std::vector<typename LocalizedBasisType::RangeType> values;
+    std::vector<typename LocalizedBasisType::DerivativeRangeType> jacobians;
+    double checksum = 0.;
+    auto localized_basis = space.basis().localize();
+
+    auto run = [&](const bool use_localized_basis) {
+      checksum = 0.;
+      Timer timer;
+      for (int rr = 0; rr < repetitions; ++rr) {
+        for (auto&& element : elements(grid_view)) {
+          localized_basis->bind(element);
+          const auto& reference_basis = localized_basis->finite_element().basis();
+          const auto geometry = element.geometry();
+          for (auto&& quadrature_point : QuadratureRules<D, d>::rule(element.type(), 2 * order)) {
+            const auto& point = quadrature_point.position();
+            if (use_localized_basis) {
+              localized_basis->evaluate(point, values);
+              localized_basis->jacobians(point, jacobians);
+            } else {
+              reference_basis.evaluate(point, values);
+              reference_basis.jacobian(point, jacobians);
+              const auto J_inv_T = geometry.jacobianInverseTransposed(point);
+              auto tmp_value = jacobians[0][0];
+              for (size_t ii = 0; ii < jacobians.size(); ++ii) {
+                J_inv_T.mv(jacobians[ii][0], tmp_value);
+                jacobians[ii][0] = tmp_value;
+              }
+            }
+            checksum += values[0][0] + jacobians[0][0][0];
+          }
+        }
+      }
+      return timer.elapsed() / repetitions;
+    };
+
+    const double direct_time = run(false);
+    const double direct_checksum = checksum;
+    const double tabulated_time = run(true);
+
+    logger.info() << "direct:    " << direct_time << "s" << std::endl;
+    logger.info() << "tabulated: " << tabulated_time
+                  << "s (checksum difference " << std::abs(direct_checksum - checksum) << ")" << std::endl;
+    logger.info() << "speedup: " << direct_time / tabulated_time << std::endl;
+
+  } catch (Exception& e) {
+    std::cerr << "\nDUNE reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "\nstl reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "Unknown error occured!" << std::endl;
+    return EXIT_FAILURE;
+  } // try
+  return EXIT_SUCCESS;
+} // ... main(...)
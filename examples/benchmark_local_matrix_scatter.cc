@@ -0,0 +1,120 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+// Compares the per-entry scatter of local matrices (add_to_entry) with the row-wise LocalMatrixScatter used by the
+// bilinear form assemblers. Only the scatter is timed, the local matrices are computed once beforehand.
+
+#include "config.h"
+
+#include <cstdlib>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/xt/common/timedlogging.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/type_traits.hh>
+
+#include <dune/gdt/local/bilinear-forms/integrals.hh>
+#include <dune/gdt/local/integrands/laplace.hh>
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/tools/matrix-scatter.hh>
+#include <dune/gdt/tools/sparsity-pattern.hh>
+
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_3D_EQUIDISTANT_OFFSET;
+using GV = typename G::LeafGridView;
+using E = XT::Grid::extract_entity_t<GV>;
+using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+
+
+int main(int argc, char* argv[])
+{
+  try {
+    MPIHelper::instance(argc, argv);
+    if (argc > 1)
+      DXTC_CONFIG.read_options(argc, argv);
+    XT::Common::TimedLogger().create(DXTC_CONFIG_GET("logger.info", 1), DXTC_CONFIG_GET("logger.debug", -1));
+    auto logger = XT::Common::TimedLogger().get("main");
+
+    const auto num_elements = DXTC_CONFIG_GET("num_elements", 16);
+    const auto order = DXTC_CONFIG_GET("order", 2);
+    const auto repetitions = DXTC_CONFIG_GET("repetitions", 5);
+
+    auto grid = XT::Grid::make_cube_grid<G>(/*lower_left=*/0., /*upper_right=*/1., /*num_elements=*/num_elements);
+    auto grid_view = grid.leaf_view();
+    auto space = make_continuous_lagrange_space(grid_view, order);
+    const auto& mapper = space.mapper();
+    logger.info() << "P" << order << " space on " << grid_view.indexSet().size(0) << " elements, " << mapper.size()
+                  << " DoFs" << std::endl;
+
+    // compute all local matrices and global indices once
+    const LocalElementIntegralBilinearForm<E> local_laplace(LocalLaplaceIntegrand<E>{});
+    auto basis = space.basis().localize();
+    std::vector<DynamicMatrix<double>> local_matrices;
+    std::vector<DynamicVector<size_t>> global_indices;
+    for (auto&& element : elements(grid_view)) {
+      basis->bind(element);
+      local_matrices.emplace_back(basis->size(), basis->size(), 0.);
+      local_laplace.apply2(*basis, *basis, local_matrices.back());
+      global_indices.emplace_back(mapper.local_size(element), 0);
+      mapper.global_indices(element, global_indices.back());
+    }
+
+    M matrix(mapper.size(), mapper.size(), make_element_sparsity_pattern(space));
+
+    Timer timer;
+    for (int rr = 0; rr < repetitions; ++rr)
+      for (size_t ee = 0; ee < local_matrices.size(); ++ee) {
+        const auto& indices = global_indices[ee];
+        const auto& local_matrix = local_matrices[ee];
+        for (size_t ii = 0; ii < indices.size(); ++ii)
+          for (size_t jj = 0; jj < indices.size(); ++jj)
+            matrix.add_to_entry(indices[ii], indices[jj], local_matrix[ii][jj]);
+      }
+    const double per_entry_time = timer.elapsed() / repetitions;
+    const auto per_entry_norm = matrix.sup_norm();
+
+    matrix.scal(0.);
+    LocalMatrixScatter<M> scatter(matrix);
+    timer.reset();
+    for (int rr = 0; rr < repetitions; ++rr)
+      for (size_t ee = 0; ee < local_matrices.size(); ++ee)
+        scatter.add(global_indices[ee],
+                    global_indices[ee].size(),
+                    global_indices[ee],
+                    global_indices[ee].size(),
+                    local_matrices[ee]);
+    const double scatter_time = timer.elapsed() / repetitions;
+
+    logger.info() << "per-entry scatter: " << per_entry_time << "s (sup_norm " << per_entry_norm << ")" << std::endl;
+    logger.info() << "row-wise scatter:  " << scatter_time << "s (sup_norm " << matrix.sup_norm() << ")" << std::endl;
+    logger.info() << "speedup: " << per_entry_time / scatter_time << std::endl;
+
+  } catch (Exception& e) {
+    std::cerr << "\nDUNE reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "\nstl reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "Unknown error occured!" << std::endl;
+    return EXIT_FAILURE;
+  } // try
+  return EXIT_SUCCESS;
+} // ... main(...)
@@ -0,0 +1,116 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+// Compares the application of an SIPDG Laplace operator given by an assembled MatrixOperator with the application of
+// the same local bilinear forms by a MatrixFreeOperator.
+
+#include "config.h"
+
+#include <cmath>
+#include <cstdlib>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/xt/common/timedlogging.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/type_traits.hh>
+
+#include <dune/gdt/local/bilinear-forms/integrals.hh>
+#include <dune/gdt/local/integrands/ipdg.hh>
+#include <dune/gdt/local/integrands/laplace.hh>
+#include <dune/gdt/local/integrands/laplace-ipdg.hh>
+#include <dune/gdt/operators/matrix-based.hh>
+#include <dune/gdt/operators/matrix-free.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_3D_EQUIDISTANT_OFFSET;
+using GV = typename G::LeafGridView;
+using E = XT::Grid::extract_entity_t<GV>;
+using I = XT::Grid::extract_intersection_t<GV>;
+using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+using V = XT::LA::IstlDenseVector<double>;
+
+
+int main(int argc, char* argv[])
+{
+  try {
+    MPIHelper::instance(argc, argv);
+    if (argc > 1)
+      DXTC_CONFIG.read_options(argc, argv);
+    XT::Common::TimedLogger().create(DXTC_CONFIG_GET("logger.info", 1), DXTC_CONFIG_GET("logger.debug", -1));
+    auto logger = XT::Common::TimedLogger().get("main");
+
+    const auto num_elements = DXTC_CONFIG_GET("num_elements", 8);
+    const auto order = DXTC_CONFIG_GET("order", 3);
+    const auto repetitions = DXTC_CONFIG_GET("repetitions", 5);
+    const auto use_tbb = DXTC_CONFIG_GET("use_tbb", false);
+
+    auto grid = XT::Grid::make_cube_grid<G>(/*lower_left=*/0., /*upper_right=*/1., /*num_elements=*/num_elements);
+    auto grid_view = grid.leaf_view();
+    auto space = make_discontinuous_lagrange_space(grid_view, order);
+    logger.info() << "P" << order << " DG space on " << grid_view.indexSet().size(0) << " elements, "
+                  << space.mapper().size() << " DoFs" << std::endl;
+
+    auto append_sipdg = [](auto& op) {
+      op.append(LocalElementIntegralBilinearForm<E>(LocalLaplaceIntegrand<E>()));
+      op.append(LocalCouplingIntersectionIntegralBilinearForm<I>(LocalLaplaceIPDGIntegrands::InnerCoupling<I>(1., 1.)),
+                {},
+                XT::Grid::ApplyOn::InnerIntersectionsOnce<GV>());
+      op.append(LocalCouplingIntersectionIntegralBilinearForm<I>(LocalIPDGIntegrands::InnerPenalty<I>(16.)),
+                {},
+                XT::Grid::ApplyOn::InnerIntersectionsOnce<GV>());
+    };
+
+    V source(space.mapper().size(), 0.);
+    for (size_t ii = 0; ii < source.size(); ++ii)
+      source[ii] = std::sin(double(ii));
+
+    Timer timer;
+    auto matrix_op = make_matrix_operator<M>(space, Stencil::element_and_intersection);
+    append_sipdg(matrix_op);
+    matrix_op.assemble(use_tbb);
+    const double assembly_time = timer.elapsed();
+    V matrix_range(space.mapper().size(), 0.);
+    timer.reset();
+    for (int rr = 0; rr < repetitions; ++rr)
+      matrix_op.apply(source, matrix_range);
+    const double matrix_time = timer.elapsed() / repetitions;
+
+    auto matrix_free_op = make_matrix_free_operator<M>(space, use_tbb);
+    append_sipdg(matrix_free_op);
+    V matrix_free_range(space.mapper().size(), 0.);
+    timer.reset();
+    for (int rr = 0; rr < repetitions; ++rr)
+      matrix_free_op.apply(source, matrix_free_range);
+    const double matrix_free_time = timer.elapsed() / repetitions;
+
+    logger.info() << "matrix-based: " << assembly_time << "s assembly, " << matrix_time << "s per apply" << std::endl;
+    logger.info() << "matrix-free:  " << matrix_free_time << "s per apply (difference "
+                  << (matrix_range - matrix_free_range).sup_norm() << ")" << std::endl;
+
+  } catch (Exception& e) {
+    std::cerr << "\nDUNE reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "\nstl reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "Unknown error occured!" << std::endl;
+    return EXIT_FAILURE;
+  } // try
+  return EXIT_SUCCESS;
+} // ... main(...)
@@ -0,0 +1,80 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+// Strong scaling of the sparsity pattern computation for a DG space, for 1 to max_threads threads.
+
+#include "config.h"
+
+#include <cstdlib>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/common/timedlogging.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/tools/sparsity-pattern.hh>
+
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_3D_EQUIDISTANT_OFFSET;
+
+
+int main(int argc, char* argv[])
+{
+  try {
+    MPIHelper::instance(argc, argv);
+    if (argc > 1)
+      DXTC_CONFIG.read_options(argc, argv);
+    XT::Common::TimedLogger().create(DXTC_CONFIG_GET("logger.info", 1), DXTC_CONFIG_GET("logger.debug", -1));
+    auto logger = XT::Common::TimedLogger().get("main");
+
+    const auto num_elements = DXTC_CONFIG_GET("num_elements", 64);
+    const auto order = DXTC_CONFIG_GET("order", 1);
+    const auto max_threads = DXTC_CONFIG_GET("max_threads", XT::Common::threadManager().max_threads());
+
+    auto grid = XT::Grid::make_cube_grid<G>(/*lower_left=*/0., /*upper_right=*/1., /*num_elements=*/num_elements);
+    auto grid_view = grid.leaf_view();
+    auto space = make_discontinuous_lagrange_space(grid_view, order);
+    logger.info() << "P" << order << " DG space on " << grid_view.indexSet().size(0) << " elements, "
+                  << space.mapper().size() << " DoFs" << std::endl;
+
+    Timer timer;
+    auto serial_pattern = make_element_and_intersection_sparsity_pattern(space, space, grid_view, /*use_tbb=*/false);
+    const double serial_time = timer.elapsed();
+    logger.info() << "serial:     " << serial_time << "s" << std::endl;
+
+    for (size_t num_threads = 1; num_threads <= max_threads; ++num_threads) {
+      XT::Common::threadManager().set_max_threads(num_threads);
+      timer.reset();
+      auto pattern = make_element_and_intersection_sparsity_pattern(space, space, grid_view, /*use_tbb=*/true);
+      const double time = timer.elapsed();
+      DUNE_THROW_IF(!(pattern == serial_pattern), InvalidStateException, "patterns do not coincide!");
+      logger.info() << num_threads << " thread(s): " << time << "s (speedup " << serial_time / time << ")"
+                    << std::endl;
+    }
+
+  } catch (Exception& e) {
+    std::cerr << "\nDUNE reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "\nstl reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "Unknown error occured!" << std::endl;
+    return EXIT_FAILURE;
+  } // try
+  return EXIT_SUCCESS;
+} // ... main(...)
@@ -0,0 +1,115 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+// Authors:
+//   Felix Schindler (2018)
+
+// Compares the generic quadrature loop of the LocalAdvectionDgVolumeOperator with the sum-factorized one for a Q_k DG
+// space on a cube grid and a linear transport flux.
+
+#include "config.h"
+
+#include <cmath>
+#include <cstdlib>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/xt/common/timedlogging.hh>
+#include <dune/xt/la/container/common.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/local/numerical-fluxes/upwind.hh>
+#include <dune/gdt/local/operators/advection-dg.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+using G = YASP_3D_EQUIDISTANT_OFFSET;
+using GV = typename G::LeafGridView;
+using I = XT::Grid::extract_intersection_t<GV>;
+using V = XT::LA::CommonDenseVector<double>;
+static constexpr size_t d = G::dimension;
+
+
+int main(int argc, char* argv[])
+{
+  try {
+    MPIHelper::instance(argc, argv);
+    if (argc > 1)
+      DXTC_CONFIG.read_options(argc, argv);
+    XT::Common::TimedLogger().create(DXTC_CONFIG_GET("logger.info", 1), DXTC_CONFIG_GET("logger.debug", -1));
+    auto logger = XT::Common::TimedLogger().get("main");
+
+    const auto num_elements = DXTC_CONFIG_GET("num_elements", 8);
+    const auto order = DXTC_CONFIG_GET("order", 4);
+    const auto repetitions = DXTC_CONFIG_GET("repetitions", 5);
+
+    auto grid = XT::Grid::make_cube_grid<G>(/*lower_left=*/0., /*upper_right=*/1., /*num_elements=*/num_elements);
+    auto grid_view = grid.leaf_view();
+    auto space = make_discontinuous_lagrange_space(grid_view, order);
+    logger.info() << "Q" << order << " DG space on " << grid_view.indexSet().size(0) << " elements, "
+                  << space.mapper().size() << " DoFs" << std::endl;
+
+    const XT::Common::FieldVector<double, d> direction(1.);
+    const XT::Functions::GenericFunction<1, d, 1> flux(
+        1,
+        [&](const auto& u, const auto& /*param*/) { return direction * u; },
+        "linear_transport",
+        {},
+        [&](const auto& /*u*/, const auto& /*param*/) { return direction; });
+    const NumericalUpwindFlux<I, d, 1> numerical_flux(flux);
+
+    DiscreteFunction<V, GV> source(space);
+    for (size_t ii = 0; ii < source.dofs().vector().size(); ++ii)
+      source.dofs().vector()[ii] = std::sin(double(ii));
+
+    auto run = [&](const bool use_sum_factorization, DiscreteFunction<V, GV>& range) {
+      LocalAdvectionDgVolumeOperator<V, GV> local_operator(source, numerical_flux.flux());
+      local_operator.use_sum_factorization(use_sum_factorization);
+      auto local_range = range.local_discrete_function();
+      Timer timer;
+      for (int rr = 0; rr < repetitions; ++rr) {
+        range.dofs().vector() *= 0.;
+        for (auto&& element : elements(grid_view)) {
+          local_range->bind(element);
+          local_operator.bind(element);
+          local_operator.apply(*local_range);
+        }
+      }
+      return timer.elapsed() / repetitions;
+    };
+
+    DiscreteFunction<V, GV> generic_range(space);
+    const double generic_time = run(false, generic_range);
+    DiscreteFunction<V, GV> sum_factorized_range(space);
+    const double sum_factorized_time = run(true, sum_factorized_range);
+
+    logger.info() << "generic:        " << generic_time << "s" << std::endl;
+    logger.info() << "sum-factorized: " << sum_factorized_time << "s (difference "
+                  << (generic_range.dofs().vector() - sum_factorized_range.dofs().vector()).sup_norm() << ")"
+                  << std::endl;
+    logger.info() << "speedup: " << generic_time / sum_factorized_time << std::endl;
+
+  } catch (Exception& e) {
+    std::cerr << "\nDUNE reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "\nstl reported error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "Unknown error occured!" << std::endl;
+    return EXIT_FAILURE;
+  } // try
+  return EXIT_SUCCESS;
+} // ... main(...)